@@ -0,0 +1,88 @@
+#include "bench.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+
+struct Benchmark {
+    std::string name;
+    BenchFunction function;
+    int64_t arg;
+};
+
+static const uint64_t MAX_ITERATIONS = 1000000000;
+
+static std::vector<Benchmark>& registry() {
+    static std::vector<Benchmark> benchmarks;
+    return benchmarks;
+}
+
+bool registerBenchmark(const char* name, BenchFunction function, std::initializer_list<int64_t> args) {
+    if (args.size() == 0) {
+        registry().push_back({name, function, 0});
+        return true;
+    }
+    for (int64_t arg : args) {
+        registry().push_back({std::string(name) + "/" + std::to_string(arg), function, arg});
+    }
+    return true;
+}
+
+// Run with growing iteration counts until one batch takes at least minTime
+static BenchState measure(const Benchmark& benchmark, double minTime) {
+    uint64_t iterations = 1;
+    while (true) {
+        BenchState state(iterations, benchmark.arg);
+        benchmark.function(state);
+        double elapsed = state.elapsedSeconds();
+        if (elapsed >= minTime || iterations >= MAX_ITERATIONS) return state;
+
+        // Aim 40% past the target so the next batch usually suffices
+        double scale = elapsed > 0 ? minTime * 1.4 / elapsed : 100.0;
+        uint64_t next = static_cast<uint64_t>(static_cast<double>(iterations) * std::min(scale, 100.0));
+        iterations = std::min(std::max(next, iterations + 1), MAX_ITERATIONS);
+    }
+}
+
+static std::string formatTime(double nanoseconds) {
+    char text[32];
+    if (nanoseconds >= 1e6) {
+        std::snprintf(text, sizeof(text), "%.2f ms", nanoseconds / 1e6);
+    } else if (nanoseconds >= 1e3) {
+        std::snprintf(text, sizeof(text), "%.2f us", nanoseconds / 1e3);
+    } else {
+        std::snprintf(text, sizeof(text), "%.1f ns", nanoseconds);
+    }
+    return text;
+}
+
+int runBenchmarks(int argc, char** argv) {
+    const char* filter = "";
+    double minTime = 0.5;
+    for (int i = 1; i < argc; i++) {
+        if (std::strncmp(argv[i], "--filter=", 9) == 0) {
+            filter = argv[i] + 9;
+        } else if (std::strncmp(argv[i], "--min-time=", 11) == 0) {
+            minTime = std::atof(argv[i] + 11);
+        } else {
+            std::fprintf(stderr, "usage: %s [--filter=<substring>] [--min-time=<seconds>]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    std::printf("%-40s %14s %12s %16s\n", "Benchmark", "Time", "Iterations", "Items/s");
+    for (const Benchmark& benchmark : registry()) {
+        if (benchmark.name.find(filter) == std::string::npos) continue;
+        BenchState state = measure(benchmark, minTime);
+        double perIteration = state.elapsedSeconds() * 1e9 / static_cast<double>(state.iterationCount());
+        std::printf("%-40s %14s %12llu", benchmark.name.c_str(), formatTime(perIteration).c_str(),
+                    static_cast<unsigned long long>(state.iterationCount()));
+        if (state.items() > 0 && state.elapsedSeconds() > 0) {
+            double rate = static_cast<double>(state.items() * state.iterationCount()) / state.elapsedSeconds();
+            std::printf(" %15.3gM", rate / 1e6);
+        }
+        std::printf("\n");
+        std::fflush(stdout);
+    }
+    return 0;
+}
@@ -0,0 +1,82 @@
+/**
+ * @file bench.hpp
+ * @brief Minimal benchmark harness for the native engine build
+ *
+ * Shaped after Google Benchmark so the suite reads the same and could be
+ * moved onto it: benchmarks are functions of a BenchState, registered
+ * with BENCHMARK(), that loop while state.keepRunning(). The runner picks
+ * an iteration count that fills the minimum run time and reports the mean
+ * time per iteration.
+ *
+ * Command line: --filter=<substring> runs only matching benchmarks,
+ * --min-time=<seconds> sets the time each one runs for (default 0.5).
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <initializer_list>
+
+class BenchState {
+public:
+    BenchState(uint64_t iterations, int64_t arg) : remaining(iterations), iterations(iterations), arg(arg) {}
+
+    /// True while iterations remain; the clock runs from the first call until the last
+    bool keepRunning() {
+        if (remaining == iterations) start = Clock::now();
+        if (remaining == 0) {
+            stop();
+            return false;
+        }
+        remaining--;
+        return true;
+    }
+
+    /// Leave per-iteration setup out of the measurement
+    void pauseTiming() { stop(); }
+    void resumeTiming() { start = Clock::now(); }
+
+    /// Argument the benchmark was registered with, e.g. the scene size
+    int64_t range() const { return arg; }
+
+    /// Work units per iteration, reported as a rate
+    void setItemsPerIteration(uint64_t items) { itemsPerIteration = items; }
+
+    uint64_t iterationCount() const { return iterations; }
+    double elapsedSeconds() const { return elapsed; }
+    uint64_t items() const { return itemsPerIteration; }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    void stop() { elapsed += std::chrono::duration<double>(Clock::now() - start).count(); }
+
+    uint64_t remaining;
+    uint64_t iterations;
+    int64_t arg;
+    uint64_t itemsPerIteration = 0;
+    Clock::time_point start;
+    double elapsed = 0;
+};
+
+using BenchFunction = void (*)(BenchState&);
+
+/// Add a benchmark, run once per argument (once with 0 when there are none)
+bool registerBenchmark(const char* name, BenchFunction function, std::initializer_list<int64_t> args);
+
+/// Run the registered benchmarks; returns the process exit code
+int runBenchmarks(int argc, char** argv);
+
+/// Keep the optimizer from discarding a result
+template <typename T>
+inline void doNotOptimize(const T& value) {
+    asm volatile("" : : "g"(&value) : "memory");
+}
+
+#define BENCH_CONCAT_(a, b) a##b
+#define BENCH_CONCAT(a, b) BENCH_CONCAT_(a, b)
+#define BENCHMARK(function, ...) \
+    static const bool BENCH_CONCAT(function, _registered) = registerBenchmark(#function, function, {__VA_ARGS__})
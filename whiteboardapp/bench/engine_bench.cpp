@@ -0,0 +1,173 @@
+/**
+ * @file engine_bench.cpp
+ * @brief Benchmarks of the engine's hot paths on synthetic boards
+ *
+ * Unless noted, the argument of a benchmark is the number of strokes on
+ * the board; strokes have 100 points and there is one shape per ten strokes. Boards
+ * are built untimed from cached scene bytes (see scene_generator.hpp).
+ */
+
+#include "bench.hpp"
+#include "scene_generator.hpp"
+
+static const uint32_t POINTS_PER_STROKE = 100;
+static const uint32_t STROKES_DRAWN = 200;   // Points per stroke drawn by BM_continueDrawing
+static const uint32_t ERASES_PER_RELOAD = 64; // Erasing eats the board; reload it this often
+static const uint32_t REPLAYS_PER_RESET = 64;  // Replayed strokes pile up; clear the board this often
+
+static SceneSpec sceneFor(const BenchState& state) {
+    SceneSpec spec;
+    spec.strokes = static_cast<uint32_t>(state.range());
+    spec.pointsPerStroke = POINTS_PER_STROKE;
+    spec.shapes = spec.strokes / 10;
+    return spec;
+}
+
+static void boardFor(Whiteboard& board, const BenchState& state) {
+    board.init();
+    loadScene(board, sceneFor(state));
+}
+
+static void BM_continueDrawing(BenchState& state) {
+    Whiteboard board;
+    boardFor(board, state);
+    SceneRandom random(7);
+    float x = 2000, y = 2000;
+    uint32_t drawn = 0;
+    board.startDrawing(x, y);
+    while (state.keepRunning()) {
+        x += random.uniform(-3, 3);
+        y += random.uniform(-3, 3);
+        board.continueDrawing(x, y);
+        if (++drawn == STROKES_DRAWN) {
+            board.endDrawing();
+            board.startDrawing(x, y);
+            drawn = 0;
+        }
+    }
+    board.endDrawing();
+    state.setItemsPerIteration(1);
+}
+BENCHMARK(BM_continueDrawing, 0, 10000);
+
+// Replaying a peer's stroke of range() points: three calls through the bulk API
+static void BM_appendPoints(BenchState& state) {
+    Whiteboard board;
+    board.init();
+    std::vector<float> xy;
+    SceneRandom random(5);
+    float x = 2000, y = 2000;
+    for (int64_t i = 0; i < state.range(); i++) {
+        x += random.uniform(-3, 3);
+        y += random.uniform(-3, 3);
+        xy.push_back(x);
+        xy.push_back(y);
+    }
+    uint64_t uid = 1;
+    while (state.keepRunning()) {
+        if (uid % REPLAYS_PER_RESET == 0) {
+            state.pauseTiming();
+            board.init();
+            state.resumeTiming();
+        }
+        board.beginRemoteStroke("peer", uid, "#000000", 2, 2000, 2000);
+        board.appendPoints(uid, xy.data(), xy.size() / 2);
+        board.finishRemoteStroke(uid, 0);
+        uid++;
+    }
+    state.setItemsPerIteration(state.range());
+}
+BENCHMARK(BM_appendPoints, 10000);
+
+static void BM_updateSelection(BenchState& state) {
+    Whiteboard board;
+    boardFor(board, state);
+    board.startSelection(500, 500);
+    bool grow = false;
+    while (state.keepRunning()) {
+        // A drag that alternates between two sizes, so elements flip state every frame
+        grow = !grow;
+        board.updateSelection(grow ? 2500 : 2000, grow ? 2500 : 2000);
+    }
+    board.endSelection();
+}
+BENCHMARK(BM_updateSelection, 1000, 10000);
+
+static void BM_moveSelected(BenchState& state) {
+    Whiteboard board;
+    boardFor(board, state);
+    board.startSelection(0, 0);
+    board.updateSelection(2000, 2000);
+    board.endSelection();
+    float dx = 1;
+    while (state.keepRunning()) {
+        board.moveSelected(dx, 0);
+        dx = -dx;
+    }
+}
+BENCHMARK(BM_moveSelected, 1000, 10000);
+
+static void BM_erase(BenchState& state) {
+    Whiteboard board;
+    boardFor(board, state);
+    SceneRandom random(11);
+    uint32_t erased = 0;
+    while (state.keepRunning()) {
+        if (++erased == ERASES_PER_RELOAD) {
+            state.pauseTiming();
+            loadScene(board, sceneFor(state));
+            erased = 0;
+            state.resumeTiming();
+        }
+        board.erase(random.uniform(0, 4000), random.uniform(0, 4000), 20);
+    }
+}
+BENCHMARK(BM_erase, 1000, 10000);
+
+static void BM_getSVGPaths(BenchState& state) {
+    Whiteboard board;
+    boardFor(board, state);
+    while (state.keepRunning()) {
+        std::string svg = board.getSVGPaths();
+        doNotOptimize(svg);
+    }
+    state.setItemsPerIteration(state.range());
+}
+BENCHMARK(BM_getSVGPaths, 1000, 10000);
+
+static void BM_serialize(BenchState& state) {
+    Whiteboard board;
+    boardFor(board, state);
+    while (state.keepRunning()) {
+        doNotOptimize(board.serialize());
+    }
+    state.setItemsPerIteration(state.range());
+}
+BENCHMARK(BM_serialize, 1000, 10000);
+
+static void BM_deserialize(BenchState& state) {
+    Whiteboard board;
+    board.init();
+    const std::vector<uint8_t>& bytes = sceneBytes(sceneFor(state));
+    while (state.keepRunning()) {
+        doNotOptimize(board.deserialize(bytes.data(), bytes.size()));
+    }
+    state.setItemsPerIteration(state.range());
+}
+BENCHMARK(BM_deserialize, 1000, 10000);
+
+#ifndef WHITEBOARD_HEADLESS
+static void BM_drawCommands(BenchState& state) {
+    Whiteboard board;
+    boardFor(board, state);
+    board.setViewSize(1920, 1080);
+    while (state.keepRunning()) {
+        doNotOptimize(board.drawCommands().size());
+    }
+}
+BENCHMARK(BM_drawCommands, 1000, 10000);
+#endif
+
+int main(int argc, char** argv) {
+    return runBenchmarks(argc, argv);
+}
@@ -0,0 +1,66 @@
+#include "scene_generator.hpp"
+#include <map>
+#include <tuple>
+#include <cmath>
+#include <algorithm>
+
+static const char* const COLORS[] = {"#000000", "#e03131", "#2f9e44", "#1971c2", "#f08c00", "#9c36b5"};
+static const ShapeType SHAPE_TYPES[] = {ShapeType::RECTANGLE, ShapeType::CIRCLE, ShapeType::LINE, ShapeType::TRIANGLE};
+static const float STEP = 3.0f;          // Pixels between samples, about a 60 Hz pointer at writing speed
+static const float MAX_TURN = 0.35f;     // Radians the heading may change per sample
+static const float MARGIN = 50.0f;
+
+void generateScene(Whiteboard& board, const SceneSpec& spec) {
+    SceneRandom random(spec.seed);
+    const size_t colorCount = sizeof(COLORS) / sizeof(COLORS[0]);
+
+    board.setShapeType(ShapeType::FREEHAND);
+    for (uint32_t i = 0; i < spec.strokes; i++) {
+        board.setColor(COLORS[random.next() % colorCount]);
+        board.setThickness(random.uniform(1, 8));
+
+        float x = random.uniform(MARGIN, spec.width - MARGIN);
+        float y = random.uniform(MARGIN, spec.height - MARGIN);
+        float heading = random.uniform(0, 2 * static_cast<float>(M_PI));
+        float turn = 0;
+        board.startDrawing(x, y);
+        for (uint32_t p = 1; p < spec.pointsPerStroke; p++) {
+            // Smoothly varying curvature, kept on the board
+            turn = 0.8f * turn + random.uniform(-MAX_TURN, MAX_TURN) * 0.2f;
+            heading += turn;
+            x = std::min(std::max(x + std::cos(heading) * STEP, 0.0f), spec.width);
+            y = std::min(std::max(y + std::sin(heading) * STEP, 0.0f), spec.height);
+            board.continueDrawing(x, y);
+        }
+        board.endDrawing();
+    }
+
+    for (uint32_t i = 0; i < spec.shapes; i++) {
+        board.setShapeType(SHAPE_TYPES[i % 4]);
+        board.setColor(COLORS[random.next() % colorCount]);
+        board.setThickness(random.uniform(1, 5));
+        board.startDrawing(random.uniform(MARGIN, spec.width - MARGIN), random.uniform(MARGIN, spec.height - MARGIN));
+        board.endDrawing();
+    }
+    board.setShapeType(ShapeType::FREEHAND);
+    board.endHistoryStep();
+}
+
+const std::vector<uint8_t>& sceneBytes(const SceneSpec& spec) {
+    using Key = std::tuple<uint32_t, uint32_t, uint32_t, float, float, uint32_t>;
+    static std::map<Key, std::vector<uint8_t>> cache;
+
+    Key key(spec.strokes, spec.pointsPerStroke, spec.shapes, spec.width, spec.height, spec.seed);
+    auto found = cache.find(key);
+    if (found != cache.end()) return found->second;
+
+    Whiteboard board;
+    board.init();
+    generateScene(board, spec);
+    return cache.emplace(key, board.serialize()).first->second;
+}
+
+void loadScene(Whiteboard& board, const SceneSpec& spec) {
+    const std::vector<uint8_t>& bytes = sceneBytes(spec);
+    board.deserialize(bytes.data(), bytes.size());
+}
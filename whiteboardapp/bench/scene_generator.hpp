@@ -0,0 +1,59 @@
+/**
+ * @file scene_generator.hpp
+ * @brief Synthetic boards for the benchmarks
+ *
+ * Strokes are drawn through the public API the way a pen would: a random
+ * walk whose heading drifts smoothly, so simplification, level of detail
+ * and curve fitting see handwriting-like input rather than noise. Shapes
+ * cycle through the shape types. A seed makes a scene reproducible.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "../include/wasm/whiteboard.hpp"
+
+struct SceneSpec {
+    uint32_t strokes = 1000;
+    uint32_t pointsPerStroke = 100;
+    uint32_t shapes = 100;
+    float width = 4000;      ///< Board area the elements are spread over
+    float height = 4000;
+    uint32_t seed = 1;
+};
+
+/// Small deterministic generator (xorshift32); the same seed gives the same scene everywhere
+class SceneRandom {
+public:
+    explicit SceneRandom(uint32_t seed) : state(seed ? seed : 1) {}
+
+    uint32_t next() {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+
+    /// Uniform in [low, high)
+    float uniform(float low, float high) {
+        return low + (high - low) * static_cast<float>(next() >> 8) * (1.0f / 16777216.0f);
+    }
+
+private:
+    uint32_t state;
+};
+
+/// Draw a scene onto an initialized board; tools are left at freehand
+void generateScene(Whiteboard& board, const SceneSpec& spec);
+
+/**
+ * @brief Scene bytes (Whiteboard::serialize()) for a spec, generated once per process
+ *
+ * Loading them is much quicker than drawing the scene again, which keeps
+ * repeated benchmark runs short.
+ */
+const std::vector<uint8_t>& sceneBytes(const SceneSpec& spec);
+
+/// Replace the board's contents with the scene for a spec
+void loadScene(Whiteboard& board, const SceneSpec& spec);
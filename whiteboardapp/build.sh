@@ -7,7 +7,22 @@ set -e
 SCRIPT_DIR="$( cd "$( dirname "${BASH_SOURCE[0]}" )" && pwd )"
 cd "$SCRIPT_DIR"
 
-echo "Building WebAssembly Whiteboard Application..."
+# Build configuration: Release (default, what the app loads), Debug or Profile
+BUILD_TYPE="${1:-Release}"
+case "$BUILD_TYPE" in
+    Release) OUT_SUBDIR="" ;;
+    Debug)   OUT_SUBDIR="/debug" ;;
+    Profile) OUT_SUBDIR="/profile" ;;
+    *)
+        echo "Usage: $0 [Release|Debug|Profile]"
+        exit 1
+        ;;
+esac
+PUBLIC_OUT="public/wasm$OUT_SUBDIR"
+SERVER_OUT="server/wasm$OUT_SUBDIR"
+BUILD_DIR="build/$BUILD_TYPE"
+
+echo "Building WebAssembly Whiteboard Application ($BUILD_TYPE)..."
 
 # Verify source files exist
 if [ ! -f "wasm/whiteboard.cpp" ]; then
@@ -15,36 +30,49 @@ if [ ! -f "wasm/whiteboard.cpp" ]; then
     exit 1
 fi
 
-# Clean previous build artifacts
-rm -rf build
-rm -rf public/wasm
-mkdir -p public/wasm
+# Clean previous artifacts of this configuration; the others are kept
+rm -rf "$BUILD_DIR"
+rm -f "$PUBLIC_OUT"/whiteboard*.js "$PUBLIC_OUT"/whiteboard*.wasm
+rm -f "$SERVER_OUT"/whiteboard*.js "$SERVER_OUT"/whiteboard*.wasm
+mkdir -p "$PUBLIC_OUT" "$SERVER_OUT"
 
 # Create build directory
 echo "Creating build directory..."
-mkdir -p build
-cd build
+mkdir -p "$BUILD_DIR"
+cd "$BUILD_DIR"
 
 # Configure CMake with Emscripten
 echo "Configuring CMake..."
-emcmake cmake ..
+emcmake cmake -DCMAKE_BUILD_TYPE="$BUILD_TYPE" ../..
 
 # Build the project
 echo "Building WebAssembly module..."
 emmake make VERBOSE=1
 
 # Go back to project root
-cd ..
+cd "$SCRIPT_DIR"
 
 # Verify the output files exist
-if [ -f "public/wasm/whiteboard.js" ] && [ -f "public/wasm/whiteboard.wasm" ]; then
+if [ -f "$PUBLIC_OUT/whiteboard.js" ] && [ -f "$PUBLIC_OUT/whiteboard.wasm" ] && \
+   [ -f "$PUBLIC_OUT/whiteboard_simd.js" ] && [ -f "$PUBLIC_OUT/whiteboard_simd.wasm" ] && \
+   [ -f "$PUBLIC_OUT/whiteboard_threads.js" ] && [ -f "$PUBLIC_OUT/whiteboard_threads.wasm" ] && \
+   [ -f "$SERVER_OUT/whiteboard_node.js" ] && [ -f "$SERVER_OUT/whiteboard_node.wasm" ]; then
     echo "Build successful!"
     echo "Output files:"
-    echo "- public/wasm/whiteboard.js"
-    echo "- public/wasm/whiteboard.wasm"
+    echo "- $PUBLIC_OUT/whiteboard.js"
+    echo "- $PUBLIC_OUT/whiteboard.wasm"
+    echo "- $PUBLIC_OUT/whiteboard_simd.js (SIMD128)"
+    echo "- $PUBLIC_OUT/whiteboard_simd.wasm (SIMD128)"
+    echo "- $PUBLIC_OUT/whiteboard_threads.js (SIMD128 + pthreads, cross-origin isolated pages)"
+    echo "- $PUBLIC_OUT/whiteboard_threads.wasm (SIMD128 + pthreads, cross-origin isolated pages)"
+    echo "- $SERVER_OUT/whiteboard_node.js (headless, for the socket server)"
+    echo "- $SERVER_OUT/whiteboard_node.wasm (headless, for the socket server)"
 else
     echo "Error: Build files were not generated correctly"
     exit 1
 fi
 
+if [ "$BUILD_TYPE" != "Release" ]; then
+    echo "Load this build with NEXT_PUBLIC_WASM_BUILD=${OUT_SUBDIR#/} (browser) and WHITEBOARD_WASM_BUILD=${OUT_SUBDIR#/} (server)"
+fi
 echo "You can now start the Next.js development server with: npm run dev" 
\ No newline at end of file
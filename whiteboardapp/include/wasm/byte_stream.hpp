@@ -0,0 +1,63 @@
+/**
+ * @file byte_stream.hpp
+ * @brief Little-endian byte buffers with LEB128 varints for the binary formats
+ *
+ * Coordinates in the wire formats are quantized to integers and stored as
+ * zigzag varints of the difference from the previous value, so a typical
+ * stroke point costs one or two bytes instead of eight.
+ *
+ * ByteReader never reads past the end of its input: once a read fails it
+ * latches !ok() and every further read returns zero, so decoders can parse
+ * straight through and check once at the end.
+ */
+
+#pragma once
+
+#include <vector>
+#include <string>
+#include <cstddef>
+#include <cstdint>
+
+class ByteWriter {
+public:
+    void clear() { buffer.clear(); }
+
+    void u8(uint8_t value) { buffer.push_back(value); }
+    void varint(uint64_t value);
+    void svarint(int64_t value) { varint(zigzag(value)); } ///< Signed values near zero stay short
+    void text(const std::string& value);                   ///< Length-prefixed bytes
+    void bytes(const uint8_t* data, size_t size);
+
+    const std::vector<uint8_t>& data() const { return buffer; }
+    size_t size() const { return buffer.size(); }
+
+    static uint64_t zigzag(int64_t value) {
+        return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+    }
+
+private:
+    std::vector<uint8_t> buffer;
+};
+
+class ByteReader {
+public:
+    ByteReader(const uint8_t* data, size_t size) : cursor(data), end(data + size) {}
+
+    uint8_t u8();
+    uint64_t varint();
+    int64_t svarint() { return unzigzag(varint()); }
+    std::string text();
+
+    bool ok() const { return valid; }
+    bool atEnd() const { return cursor == end; }
+    size_t remaining() const { return static_cast<size_t>(end - cursor); }
+
+    static int64_t unzigzag(uint64_t value) {
+        return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+    }
+
+private:
+    const uint8_t* cursor;
+    const uint8_t* end;
+    bool valid = true;
+};
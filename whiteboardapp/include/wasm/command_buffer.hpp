@@ -0,0 +1,131 @@
+/**
+ * @file command_buffer.hpp
+ * @brief Packed draw command buffer shared between C++ and JavaScript
+ *
+ * Instead of calling into the canvas context through embind for every vertex,
+ * the engine records draw operations into a flat float array that lives in
+ * WebAssembly linear memory. JavaScript receives a Float32Array view of that
+ * memory and replays it onto the canvas in a single pass
+ * (see src/lib/commandReplay.ts).
+ *
+ * Buffer layout:
+ * - commands[0]: palette revision (changes whenever a new color is interned)
+ * - followed by records of the form [opcode, args...]
+ *
+ * Colors are interned into a palette and referenced by index, so strings
+ * never have to cross the boundary on the hot path.
+ */
+
+#pragma once
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <unordered_map>
+
+/**
+ * @brief Opcodes understood by the JavaScript command interpreter
+ *
+ * The numeric values are part of the JS/C++ contract and must match
+ * the DrawOp enum in src/lib/commandReplay.ts.
+ */
+enum class DrawOp : uint8_t {
+    BEGIN_PATH = 0,   ///< []
+    POLYLINE = 1,     ///< [count, x0, y0, x1, y1, ...] - moveTo + lineTo chain
+    STROKE = 2,       ///< []
+    STROKE_STYLE = 3, ///< [paletteIndex]
+    LINE_WIDTH = 4,   ///< [width]
+    ROUND_CAPS = 5,   ///< [] - lineCap and lineJoin set to "round"
+    RECT = 6,         ///< [x, y, width, height]
+    STROKE_RECT = 7,  ///< [x, y, width, height]
+    ARC = 8,          ///< [cx, cy, radius, startAngle, endAngle]
+    LINE_DASH = 9,    ///< [on, off] - both zero resets to a solid line
+    SAVE = 10,        ///< []
+    RESTORE = 11,     ///< []
+    CLEAR_RECT = 12,  ///< [x, y, width, height]
+    CLIP = 13,        ///< [] - intersect the clip region with the current path
+    CLEAR_CANVAS = 14, ///< [] - clear the whole canvas, ignoring the transform
+    TILE_BEGIN = 15,   ///< [tx, ty, size, zoom] - redirect drawing into a cleared tile raster
+    TILE_END = 16,     ///< [] - resume drawing on the visible canvas
+    TILE_BLIT = 17,    ///< [tx, ty, size] - copy a tile raster onto the visible canvas
+    TILE_DROP = 18,    ///< [tx, ty] - free a tile raster
+    TILE_DROP_ALL = 19, ///< [] - free every tile raster
+    VIEW_TRANSFORM = 20, ///< [scale, x, y] - board point (x, y) at the canvas origin, then scaled
+    BEZIER = 21         ///< [segments, x0, y0, c1x, c1y, c2x, c2y, x1, y1, ...] - moveTo + bezierCurveTo chain
+};
+
+/**
+ * @brief Records canvas operations into a reusable float buffer
+ *
+ * The buffer keeps its capacity between frames, so steady-state encoding
+ * does not allocate. Redundant style changes within a frame are dropped.
+ */
+class CommandBuffer {
+public:
+    CommandBuffer();
+
+    /**
+     * @brief Start a new frame
+     *
+     * Drops recorded commands (keeping capacity) and forgets the cached
+     * style state, since JavaScript may have touched the context in between.
+     */
+    void reset();
+
+    // Path commands
+    void beginPath();
+    void polyline(const float* xy, size_t count); ///< Interleaved x,y pairs
+    void polyline(const float* xs, const float* ys, size_t count); ///< Separate x and y arrays
+    void bezier(const float* xs, const float* ys, size_t count);   ///< 3n + 1 points of n cubic segments
+    void stroke();
+    void rect(float x, float y, float width, float height);
+    void strokeRect(float x, float y, float width, float height);
+    void arc(float cx, float cy, float radius, float startAngle, float endAngle);
+
+    // State and clipping commands
+    void save();
+    void restore();   ///< Also forgets cached style, since the context reverts
+    void clip();
+    void clearRect(float x, float y, float width, float height);
+    void clearCanvas();
+    void viewTransform(float scale, float x, float y); ///< Replaces the visible canvas transform
+
+    // Tile raster commands (see tile_cache.hpp); switching targets forgets cached style
+    void tileBegin(int32_t tx, int32_t ty, float size, float zoom);
+    void tileEnd();
+    void tileBlit(int32_t tx, int32_t ty, float size);
+    void tileDrop(int32_t tx, int32_t ty);
+    void tileDropAll();
+
+    // Style commands
+    void strokeStyle(const std::string& color);
+    void lineWidth(float width);
+    void roundCaps();
+    void lineDash(float on, float off);
+
+    const float* data() const { return commands.data(); }
+    size_t size() const { return commands.size(); }
+
+    /**
+     * @brief Interned colors, indexed by the STROKE_STYLE palette index
+     *
+     * Only needs to be fetched again when the palette revision in the
+     * buffer header changes.
+     */
+    const std::vector<std::string>& paletteColors() const { return palette; }
+
+private:
+    uint32_t internColor(const std::string& color);
+    void op(DrawOp code) { commands.push_back(static_cast<float>(code)); }
+    void forgetStyle();
+
+    std::vector<float> commands;                        ///< Header + packed records
+    std::vector<std::string> palette;                   ///< Interned colors by index
+    std::unordered_map<std::string, uint32_t> colorIds; ///< Color -> palette index
+    uint32_t paletteRevision;                           ///< Bumped on palette change
+
+    // Style state already applied in the current frame
+    int32_t currentColor;
+    float currentWidth;
+    bool roundCapsSet;
+};
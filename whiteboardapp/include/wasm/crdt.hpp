@@ -0,0 +1,94 @@
+/**
+ * @file crdt.hpp
+ * @brief Replication metadata that lets peers merge concurrent edits
+ *
+ * The board is an add-wins set of elements keyed by uid, where every
+ * element carries three last-writer-wins registers:
+ *
+ * - style: color and thickness
+ * - offset: total translation since creation
+ * - geometry: points (lines) or corners (shapes), relative to the offset
+ *
+ * Writes are ordered by Lamport stamps (counter, then site as tie-break),
+ * so every peer picks the same winner regardless of arrival order.
+ *
+ * Membership uses add tags. Creating an element implicitly adds the
+ * creation tag, which every peer knows from the uid alone; restoring a
+ * removed element adds a fresh tag. A removal tombstones only the tags it
+ * has seen, so a concurrent restore survives it (add wins). Tombstones
+ * are kept for removed elements so late duplicates cannot revive them.
+ *
+ * This class only keeps the metadata; Whiteboard owns the element data
+ * and the wire format (see Whiteboard::collectLocalOps()).
+ */
+
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+#include <cstdint>
+
+struct Stamp {
+    uint64_t counter = 0;
+    uint32_t site = 0;
+
+    bool operator<(const Stamp& other) const {
+        return counter != other.counter ? counter < other.counter : site < other.site;
+    }
+    bool operator==(const Stamp& other) const {
+        return counter == other.counter && site == other.site;
+    }
+};
+
+struct ElementReplica {
+    std::vector<Stamp> added;   ///< Add tags, ascending; {0, 0} is the creation tag
+    std::vector<Stamp> removed; ///< Tombstoned add tags, ascending
+    Stamp style;                ///< Last write of each register
+    Stamp offset;
+    Stamp geometry;
+    float ox = 0;               ///< Offset register value
+    float oy = 0;
+
+    bool present() const; ///< Some add tag is not tombstoned
+};
+
+class ReplicaSet {
+public:
+    /// Register bits of pending local changes
+    enum Field : uint8_t { MEMBERSHIP = 1, STYLE = 2, OFFSET = 4, GEOMETRY = 8 };
+
+    void setSite(uint32_t site) { localSite = site; }
+
+    Stamp tick();                       ///< Fresh stamp for a local write
+    void observe(const Stamp& stamp);   ///< Keep later local stamps above a remote one
+
+    ElementReplica& at(uint64_t uid);   ///< Created on first use, holding the creation tag
+    ElementReplica* find(uint64_t uid);
+    const std::unordered_map<uint64_t, ElementReplica>& elements() const { return replicas; }
+
+    // Local writes; each queues the change for the next collect
+    void created(uint64_t uid);         ///< Stamp all registers of a new element
+    void restored(uint64_t uid);        ///< Add a fresh tag to a removed element
+    void removed(uint64_t uid);         ///< Tombstone every tag seen so far
+    ElementReplica& write(uint64_t uid, Field field); ///< Stamp one register
+
+    /// Merge remote tags; returns the new membership
+    bool mergeTags(ElementReplica& replica, const std::vector<Stamp>& added,
+                   const std::vector<Stamp>& removed);
+
+    const std::vector<uint64_t>& pending() const { return pendingOrder; }
+    uint8_t pendingFields(uint64_t uid) const;
+    void clearPending();
+
+    void clear(); ///< Forget all elements, e.g. when a scene is loaded
+
+private:
+    static void insertTag(std::vector<Stamp>& tags, const Stamp& tag);
+    void touch(uint64_t uid, uint8_t fields);
+
+    uint32_t localSite = 0;
+    uint64_t clock = 0;
+    std::unordered_map<uint64_t, ElementReplica> replicas;
+    std::unordered_map<uint64_t, uint8_t> pendingMask; ///< Uid -> Field bits
+    std::vector<uint64_t> pendingOrder;                ///< Uids in first-change order
+};
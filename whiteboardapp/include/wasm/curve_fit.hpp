@@ -0,0 +1,67 @@
+/**
+ * @file curve_fit.hpp
+ * @brief Fitting of freehand strokes into piecewise cubic Béziers
+ *
+ * Schneider's algorithm ("An Algorithm for Automatically Fitting Digitized
+ * Curves", Graphics Gems, 1990): parameterize the points by chord length,
+ * solve for the control points by least squares with the end tangents
+ * fixed, refine the parameters with Newton-Raphson, and split at the worst
+ * point when the error bound is still not met. Splits share a tangent, so
+ * the curve stays smooth across them.
+ *
+ * Sharp turns are split beforehand and keep their corner; a single smooth
+ * curve through them would overshoot.
+ *
+ * A curve with n segments is stored as 3n + 1 points: the start, then for
+ * each segment its two control points and its end. Like the simplifier,
+ * the recursion runs on an explicit stack with reused scratch buffers.
+ */
+
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+class CurveFitter {
+public:
+    struct Vec {
+        float x, y;
+    };
+
+    /**
+     * @brief Fit a polyline, replacing the contents of outXs and outYs
+     * @param tolerance Largest distance of an input point from the curve, in pixels
+     *
+     * Fewer than two distinct points produce a single point.
+     */
+    void fit(const float* xs, const float* ys, size_t count, float tolerance,
+             std::vector<float>& outXs, std::vector<float>& outYs);
+
+private:
+    struct Range {
+        uint32_t first;
+        uint32_t last;
+        Vec startTangent;
+        Vec endTangent;
+    };
+
+    void fitSection(uint32_t first, uint32_t last, float toleranceSq,
+                    std::vector<float>& outXs, std::vector<float>& outYs);
+    Vec tangent(uint32_t from, uint32_t towards, float reachSq) const; ///< Unit direction from a point into the curve
+    void chordLengths(uint32_t first, uint32_t last);
+    void solve(uint32_t first, uint32_t last, Vec startTangent, Vec endTangent, Vec* bezier) const;
+    float maxError(uint32_t first, uint32_t last, const Vec* bezier, uint32_t& split) const;
+    void reparameterize(uint32_t first, uint32_t last, const Vec* bezier);
+
+    std::vector<Vec> points;   ///< Input with repeated points removed
+    std::vector<float> params; ///< Curve parameter of each point of the section being fitted
+    std::vector<Range> stack;
+};
+
+/**
+ * @brief Polyline through cubic Béziers, within tolerance of the curve
+ * @param xs, ys 3n + 1 points as produced by CurveFitter
+ */
+void flattenCubics(const float* xs, const float* ys, size_t count, float tolerance,
+                   std::vector<float>& outXs, std::vector<float>& outYs);
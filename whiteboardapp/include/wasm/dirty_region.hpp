@@ -0,0 +1,39 @@
+/**
+ * @file dirty_region.hpp
+ * @brief Damage tracking for incremental canvas redraws
+ *
+ * Every edit reports the canvas area it touched (old and new bounds of the
+ * element, padded for stroke width). Before the next frame the engine clips
+ * to these rectangles and redraws only the elements that intersect them.
+ *
+ * Overlapping rectangles are merged when their union is not much larger than
+ * the parts, so a stroke being drawn collapses into a few small rects while
+ * distant edits stay separate. Past a fixed count the region degrades to one
+ * bounding rectangle, and markAll() forces a full redraw.
+ */
+
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include "spatial_index.hpp"
+
+class DirtyRegion {
+public:
+    void add(const Box& box);     ///< Damage an area of the canvas
+    void markAll();               ///< Next frame must repaint everything
+    void reset();                 ///< Frame painted; nothing is dirty
+
+    bool isFull() const { return full; }
+    bool isEmpty() const { return !full && rects.empty(); }
+    const std::vector<Box>& areas() const { return rects; }
+
+private:
+    static constexpr size_t MAX_RECTS = 16;
+
+    static float area(const Box& box);
+    static Box merged(const Box& a, const Box& b);
+
+    std::vector<Box> rects;
+    bool full = true; ///< Nothing has been painted yet
+};
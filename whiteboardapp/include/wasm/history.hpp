@@ -0,0 +1,100 @@
+/**
+ * @file history.hpp
+ * @brief Undo/redo log of whiteboard operations
+ *
+ * Each entry records one user-level step (a stroke, a drag, an erase
+ * gesture, a delete or a clear) with just enough payload to reverse it:
+ *
+ * - ADD keeps only the element id; the element itself is captured when
+ *   the step is undone, so it can be redone.
+ * - MOVE keeps the ids and the accumulated offset.
+ * - ERASE keeps the elements as they were before the gesture first touched
+ *   them and the ids of the pieces it split off (to undo). Like ADD, what
+ *   the gesture left behind is captured when it is undone, to redo.
+ * - DELETE and CLEAR keep the removed elements.
+ *
+ * Memory therefore grows with the size of the edits, not of the board
+ * (only CLEAR is board-sized, by nature). The log is capped by bytes: the
+ * oldest steps are dropped once the cap is exceeded, always keeping the
+ * newest one.
+ *
+ * Consecutive operations of the same kind are merged into the open step
+ * until closeStep(), so a drag or an erase gesture undoes in one go.
+ */
+
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Everything needed to recreate one element with its original id
+ */
+struct ElementSnapshot {
+    uint32_t id;
+    uint64_t uid;
+    bool isLine;
+    uint8_t shapeType;
+    uint16_t color;
+    float thickness;
+    float x0, y0, x1, y1;      ///< Shape corners
+    std::vector<float> xs, ys; ///< Line points
+
+    size_t bytes() const { return sizeof(ElementSnapshot) + (xs.size() + ys.size()) * sizeof(float); }
+};
+
+struct HistoryEntry {
+    enum class Kind : uint8_t { ADD, MOVE, ERASE, DELETE, CLEAR };
+
+    Kind kind;
+    std::vector<uint32_t> ids;             ///< Affected ids, ascending
+    float dx = 0;                          ///< MOVE offset
+    float dy = 0;
+    std::vector<uint32_t> added;           ///< ERASE: pieces split off erased strokes, ascending
+    std::vector<ElementSnapshot> elements; ///< Removed or pre-edit elements
+    std::vector<ElementSnapshot> after;    ///< ERASE: what survived, captured on undo
+
+    size_t bytes() const;
+};
+
+class History {
+public:
+    void setLimit(size_t bytes);          ///< Trim to at most this many bytes
+    size_t size() const { return undoBytes + redoBytes; }
+    void clear();
+
+    /**
+     * @brief Add a new step; clears the redo stack
+     */
+    void record(HistoryEntry entry);
+
+    /**
+     * @brief The newest step if it is still open and of the given kind
+     *
+     * Call amended() after changing it so its size is accounted.
+     */
+    HistoryEntry* openEntry(HistoryEntry::Kind kind);
+    void amended();
+    void closeStep() { open = false; }
+
+    bool canUndo() const { return !undoStack.empty(); }
+    bool canRedo() const { return !redoStack.empty(); }
+
+    HistoryEntry takeUndo();              ///< Pop the newest step to undo it
+    HistoryEntry takeRedo();              ///< Pop the newest undone step to redo it
+    void pushUndo(HistoryEntry entry);    ///< Return a redone step to the undo stack
+    void pushRedo(HistoryEntry entry);    ///< Store an undone step for redo
+
+private:
+    void trim();
+
+    std::deque<HistoryEntry> undoStack;
+    std::vector<HistoryEntry> redoStack;
+    std::deque<size_t> undoSizes;         ///< Bytes of each undo entry, oldest first
+    size_t undoBytes = 0;
+    size_t redoBytes = 0;
+    size_t limit = 4 * 1024 * 1024;
+    bool open = false;                    ///< The newest undo entry accepts merges
+};
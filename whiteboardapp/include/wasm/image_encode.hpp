@@ -0,0 +1,27 @@
+/**
+ * @file image_encode.hpp
+ * @brief PNG and QOI encoders for rasterized exports
+ *
+ * Both take straight 8-bit RGBA rows, as produced by the Rasterizer, and
+ * append a complete file to a byte vector.
+ *
+ * - PNG is what users download. Rows are filtered (Sub or Up, whichever
+ *   looks smaller) and deflated with fixed Huffman codes and a greedy LZ77
+ *   over a single-entry hash table. Whiteboards are mostly flat color, so
+ *   long matches dominate and this gets close to zlib's default level at
+ *   a fraction of the cost.
+ *   Given a WorkPool, rows are filtered and big images deflated in
+ *   parallel segments, each its own block.
+ * - QOI is for thumbnails and caches: one pass, no entropy coding, and
+ *   about as fast to decode as to encode.
+ */
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include "work_pool.hpp"
+
+void encodePNG(const uint8_t* rgba, uint32_t width, uint32_t height, std::vector<uint8_t>& out,
+               WorkPool* pool = nullptr);
+void encodeQOI(const uint8_t* rgba, uint32_t width, uint32_t height, std::vector<uint8_t>& out);
@@ -0,0 +1,56 @@
+/**
+ * @file ink_filter.hpp
+ * @brief Smoothing and short-horizon prediction of pointer samples
+ *
+ * Raw pointer positions jitter by a pixel or two, which shows as a wobbly
+ * stroke, and they arrive a frame or more after the pen got there. The
+ * filter addresses both:
+ *
+ * - Smoothing is a one-euro filter (Casiez et al., CHI 2012): a low-pass
+ *   whose cutoff rises with speed, so slow strokes lose their jitter and
+ *   fast ones do not lag. Both axes share one cutoff, taken from the speed,
+ *   so a diagonal stroke is smoothed the same as a horizontal one.
+ * - Prediction extrapolates the filtered position with the filtered
+ *   velocity and a damped acceleration. The predicted points are only
+ *   drawn; the stroke keeps what the pen actually did.
+ *
+ * Times are in milliseconds and positions in board units.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+class InkFilter {
+public:
+    /**
+     * @param minCutoff Cutoff in Hz at rest; lower removes more jitter. 0 disables smoothing
+     * @param beta How fast the cutoff rises with speed (per board unit per second)
+     */
+    void configure(float minCutoff, float beta);
+    bool smoothing() const { return minCutoff > 0; }
+
+    /// Start a new stroke at an untimed point; the next sample's time counts from 0 here
+    void reset(float x, float y);
+
+    /// Filter a sample; the smoothed position is written to outX, outY
+    void filter(float x, float y, float time, float& outX, float& outY);
+
+    /**
+     * @brief Where the pen is expected to be, up to horizon ms after the last sample
+     * @param xs, ys Receive count points, evenly spaced in time
+     * @return false until the filter has seen enough samples to estimate a velocity
+     */
+    bool predict(float horizon, float* xs, float* ys, uint32_t count) const;
+
+private:
+    float minCutoff = 0;
+    float beta = 0;
+
+    float lastTime = 0;
+    uint32_t samples = 0;   ///< Samples since reset()
+    float x = 0, y = 0;     ///< Filtered position
+    float speed = 0;        ///< One-euro speed estimate, units per second
+    float vx = 0, vy = 0;   ///< Filtered velocity, units per ms
+    float ax = 0, ay = 0;   ///< Filtered acceleration, units per ms^2
+};
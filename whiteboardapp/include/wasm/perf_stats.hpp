@@ -0,0 +1,98 @@
+/**
+ * @file perf_stats.hpp
+ * @brief Frame counters and scoped timers of the engine's expensive calls
+ *
+ * Counters are always kept; they cost an increment. Timers are off until
+ * setEnabled(true), and then each timed section appends a sample to a
+ * fixed ring that JavaScript reads in place (Whiteboard::getTimings()), so
+ * an overlay or telemetry can poll it without copies or a profiler.
+ *
+ * A sample is three doubles: section, start and duration, in milliseconds
+ * since the recorder was created. written() counts every sample ever
+ * recorded; the newest is at (written() - 1) % CAPACITY.
+ */
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+enum class PerfSection : uint8_t {
+    DRAW,         ///< draw(), drawCommands(), drawDirtyCommands()
+    HIT_TEST,     ///< updateSelection()
+    ERASE,
+    SERIALIZE,    ///< serialize(), snapshotOps()
+    DESERIALIZE,  ///< deserialize(), loadOps()
+    EXPORT,       ///< getSVGPaths(), nextSVGChunk(), renderImage()
+    SYNC,         ///< applyStrokeBatch(), applyRemoteOps()
+};
+
+class PerfRecorder {
+public:
+    static constexpr uint32_t SECTIONS = 7;
+    static constexpr uint32_t CAPACITY = 256;     ///< Samples kept in the ring
+    static constexpr uint32_t SAMPLE_VALUES = 3;  ///< Doubles per sample
+
+    PerfRecorder() : origin(Clock::now()) {}
+
+    void setEnabled(bool enabled) { timing = enabled; }
+    bool enabled() const { return timing; }
+
+    /// Milliseconds since the recorder was created
+    double now() const { return std::chrono::duration<double, std::milli>(Clock::now() - origin).count(); }
+
+    void record(PerfSection section, double start, double end);
+    double last(PerfSection section) const { return lastDuration[static_cast<uint32_t>(section)]; } ///< 0 until timed
+
+    const double* samples() const { return ring.data(); }
+    uint32_t written() const { return total; }
+
+    /// One call from JavaScript into the module
+    void countCall() { callsThisFrame++; }
+
+    /// A frame was drawn; calls counted so far belong to it
+    void endFrame() {
+        callsLastFrame = callsThisFrame;
+        callsThisFrame = 0;
+        frameCount++;
+    }
+
+    uint32_t frames() const { return frameCount; }
+    uint32_t lastFrameCalls() const { return callsLastFrame; }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    Clock::time_point origin;
+    bool timing = false;
+    std::array<double, CAPACITY * SAMPLE_VALUES> ring{};
+    std::array<double, SECTIONS> lastDuration{};
+    uint32_t total = 0;
+    uint32_t callsThisFrame = 0;
+    uint32_t callsLastFrame = 0;
+    uint32_t frameCount = 0;
+};
+
+/**
+ * @brief Times its scope into a PerfRecorder when timing is enabled
+ *
+ * Reads no clock when the recorder is disabled.
+ */
+class ScopedTimer {
+public:
+    ScopedTimer(PerfRecorder& recorder, PerfSection section)
+        : recorder(recorder.enabled() ? &recorder : nullptr), section(section),
+          start(this->recorder ? recorder.now() : 0) {}
+    ~ScopedTimer() {
+        if (recorder) recorder->record(section, start, recorder->now());
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    PerfRecorder* recorder;
+    PerfSection section;
+    double start;
+};
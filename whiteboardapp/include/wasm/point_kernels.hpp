@@ -0,0 +1,53 @@
+/**
+ * @file point_kernels.hpp
+ * @brief Bulk operations over structure-of-arrays point data
+ *
+ * These are the inner loops behind moving, erasing, selecting and bounds
+ * computation. When compiled with -msimd128 (the whiteboard_simd target)
+ * they process four points per instruction using WebAssembly SIMD;
+ * otherwise the scalar implementation is used. Both produce identical
+ * results for finite inputs; with NaN coordinates the bounds may differ,
+ * since the SIMD min/max and std::min/std::max order NaN differently.
+ */
+
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include "spatial_index.hpp"
+
+/**
+ * @brief Add a constant offset to every point
+ */
+void translatePoints(float* xs, float* ys, size_t count, float dx, float dy);
+
+/**
+ * @brief Axis-aligned bounds of a point array
+ * @return Empty box when count is zero
+ */
+Box pointBounds(const float* xs, const float* ys, size_t count);
+
+/**
+ * @brief Cut away the parts of a polyline strictly inside a circle
+ *
+ * Every segment is clipped against the circle, so a stroke is cut even
+ * where the eraser passes between two of its samples, and each piece
+ * ends exactly on the circle. One linear pass; the outputs keep their
+ * capacity between calls. This one stays scalar: clipping is branchy and
+ * only runs on strokes the spatial index found near the eraser.
+ *
+ * @param outXs, outYs Points of the surviving pieces, one piece after another
+ * @param pieceEnds End offset of each piece in outXs/outYs; pieces of a
+ *        single point are dropped unless the polyline was a single point
+ * @return false if nothing was inside the circle; the outputs are then unspecified
+ */
+bool splitPolylineByCircle(const float* xs, const float* ys, size_t count,
+                           float cx, float cy, float radius,
+                           std::vector<float>& outXs, std::vector<float>& outYs,
+                           std::vector<uint32_t>& pieceEnds);
+
+/**
+ * @brief Whether any point lies inside a box (edges inclusive)
+ */
+bool anyPointInBox(const float* xs, const float* ys, size_t count, const Box& box);
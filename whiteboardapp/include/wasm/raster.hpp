@@ -0,0 +1,75 @@
+/**
+ * @file raster.hpp
+ * @brief Software rasterizer for exports and thumbnails
+ *
+ * Draws the element types the engine knows into an RGBA buffer, without a
+ * canvas, so images can be rendered at any resolution in a worker or on
+ * the server. Output is straight (not premultiplied) 8-bit RGBA, row by
+ * row from the top left, which is what the PNG and QOI encoders take.
+ *
+ * Each stroke first accumulates antialiased coverage in a mask, keeping
+ * the maximum over its parts, and is then composited once. A polyline is
+ * the union of one capsule per segment, which gives round caps and joins
+ * for free, and overlapping segments do not darken the joins.
+ */
+
+#pragma once
+
+#include <vector>
+#include <string>
+#include <cstdint>
+
+/**
+ * @brief Parse a CSS hex color ("#rgb", "#rrggbb" or "#rrggbbaa")
+ * @param rgba Packed as r | g << 8 | b << 16 | a << 24, i.e. RGBA bytes in memory
+ * @return false (leaving rgba unchanged) for anything else
+ */
+bool parseHexColor(const std::string& text, uint32_t& rgba);
+
+class Rasterizer {
+public:
+    /**
+     * @brief Start a new image
+     * @param background Packed RGBA every pixel starts as; 0 is transparent
+     */
+    void reset(uint32_t width, uint32_t height, uint32_t background);
+
+    /**
+     * @brief Map board coordinates to pixels: pixel = (board - origin) * scale
+     * @param firstRow Image row this buffer starts at, when it holds one band of a taller image
+     */
+    void setTransform(float scale, float originX, float originY, uint32_t firstRow = 0);
+
+    // Widths are in board units, like the elements' thickness
+    void strokePolyline(const float* xs, const float* ys, uint32_t count, float width, uint32_t color);
+    void strokeRect(float x0, float y0, float x1, float y1, float width, uint32_t color);
+    void strokeCircle(float cx, float cy, float radius, float width, uint32_t color);
+
+    const std::vector<uint8_t>& pixels() const { return rgba; }
+    uint32_t width() const { return imageWidth; }
+    uint32_t height() const { return imageHeight; }
+
+private:
+    struct PixelBox {
+        int32_t x0, y0, x1, y1; ///< Inclusive
+    };
+
+    float pixelX(float x) const { return (x - originX) * scale; }
+    float pixelY(float y) const { return (y - originY) * scale - firstRow; }
+
+    PixelBox clip(float minX, float minY, float maxX, float maxY) const;
+    void cover(int32_t x, int32_t y, float coverage);
+    void capsule(float ax, float ay, float bx, float by, float halfWidth);
+    void composite(uint32_t color);
+
+    uint32_t imageWidth = 0;
+    uint32_t imageHeight = 0;
+    float scale = 1;
+    float originX = 0;
+    float originY = 0;
+    float firstRow = 0;
+    std::vector<uint8_t> rgba;
+    std::vector<uint8_t> mask;   ///< Coverage of the stroke being drawn
+    PixelBox dirty;              ///< Area of the mask that is not zero
+    bool dirtyEmpty = true;
+};
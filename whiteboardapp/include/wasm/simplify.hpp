@@ -0,0 +1,38 @@
+/**
+ * @file simplify.hpp
+ * @brief Ramer–Douglas–Peucker simplification of freehand strokes
+ *
+ * Pointer devices report far more samples than a stroke needs to look the
+ * same on screen. RDP keeps the endpoints and, recursively, every point that
+ * deviates from the chord between its kept neighbours by more than the
+ * tolerance; nearly collinear runs collapse to their endpoints.
+ *
+ * The recursion is run with an explicit stack so very long strokes cannot
+ * overflow the WebAssembly call stack, and the scratch buffers are reused
+ * across calls.
+ */
+
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+class PolylineSimplifier {
+public:
+    /**
+     * @brief Simplify a polyline in place
+     * @param tolerance Maximum distance of a dropped point from the result, in pixels
+     * @return Number of points kept; they occupy the front of the arrays in order
+     */
+    size_t simplify(float* xs, float* ys, size_t count, float tolerance);
+
+private:
+    struct Range {
+        uint32_t first;
+        uint32_t last;
+    };
+
+    std::vector<Range> stack;
+    std::vector<uint8_t> keep;
+};
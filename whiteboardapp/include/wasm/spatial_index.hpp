@@ -0,0 +1,123 @@
+/**
+ * @file spatial_index.hpp
+ * @brief Uniform grid spatial index for hit testing and box queries
+ *
+ * Elements are registered by a numeric id together with their axis-aligned
+ * bounds. The board is divided into square cells, and each cell lists the
+ * ids whose bounds overlap it. Queries only visit the cells covered by the
+ * query area, so hit tests, erasing and rubber-band selection cost
+ * O(cells + hits) instead of O(total points).
+ *
+ * Bounds are maintained incrementally: growing a stroke or moving an element
+ * only touches the cells that actually changed.
+ */
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+
+/**
+ * @brief Axis-aligned bounding box
+ *
+ * An empty box has min > max, so extending it with the first point
+ * yields a degenerate box around that point.
+ */
+struct Box {
+    float minX = std::numeric_limits<float>::max();
+    float minY = std::numeric_limits<float>::max();
+    float maxX = std::numeric_limits<float>::lowest();
+    float maxY = std::numeric_limits<float>::lowest();
+
+    static Box around(float x, float y, float radius) {
+        return {x - radius, y - radius, x + radius, y + radius};
+    }
+
+    bool isEmpty() const { return minX > maxX || minY > maxY; }
+
+    void extend(float x, float y) {
+        if (x < minX) minX = x;
+        if (x > maxX) maxX = x;
+        if (y < minY) minY = y;
+        if (y > maxY) maxY = y;
+    }
+
+    void translate(float dx, float dy) {
+        minX += dx;
+        maxX += dx;
+        minY += dy;
+        maxY += dy;
+    }
+
+    bool intersects(const Box& other) const {
+        return !(other.minX > maxX || other.maxX < minX ||
+                 other.minY > maxY || other.maxY < minY);
+    }
+};
+
+/**
+ * @brief Sparse uniform grid keyed by element id
+ *
+ * Ids are small dense integers chosen by the caller. Elements whose bounds
+ * span too many cells are kept in a separate list that every query checks,
+ * so a single huge shape cannot blow up the cell map.
+ */
+class SpatialGrid {
+public:
+    /**
+     * @brief Create an empty grid
+     * @param cellSize Cell edge length in canvas pixels
+     */
+    explicit SpatialGrid(float cellSize = 128.0f);
+
+    void clear();                                 ///< Remove all elements
+    void insert(uint32_t id, const Box& box);     ///< Register a new element
+    void update(uint32_t id, const Box& box);     ///< Element bounds changed
+    void remove(uint32_t id);                     ///< Unregister an element
+    bool contains(uint32_t id) const;             ///< Is the id registered
+
+    /**
+     * @brief Collect ids of all elements whose bounds intersect an area
+     * @param area Query rectangle in canvas pixels
+     * @param out Receives matching ids in ascending order (i.e. creation order)
+     */
+    void query(const Box& area, std::vector<uint32_t>& out) const;
+
+private:
+    struct CellRange {
+        int32_t x0, y0, x1, y1;
+
+        bool operator==(const CellRange& other) const {
+            return x0 == other.x0 && y0 == other.y0 && x1 == other.x1 && y1 == other.y1;
+        }
+        bool operator!=(const CellRange& other) const { return !(*this == other); }
+        int64_t cellCount() const { return int64_t(x1 - x0 + 1) * int64_t(y1 - y0 + 1); }
+    };
+
+    struct Entry {
+        Box box;
+        CellRange cells;
+        bool live = false;
+        bool oversized = false;
+    };
+
+    static constexpr int64_t MAX_CELLS_PER_ELEMENT = 1024;
+
+    CellRange rangeFor(const Box& box) const;
+    void link(uint32_t id, Entry& entry);
+    void unlink(uint32_t id, Entry& entry);
+    static uint64_t cellKey(int32_t cx, int32_t cy);
+    bool markVisited(uint32_t id) const;
+
+    float cellSize;
+    float inverseCellSize;
+    std::unordered_map<uint64_t, std::vector<uint32_t>> cells; ///< Cell -> ids overlapping it
+    std::vector<uint32_t> oversized;                           ///< Ids spanning too many cells
+    std::vector<Entry> entries;                                ///< Indexed by id
+
+    // Per-query deduplication: an id is reported once when it spans several cells
+    mutable std::vector<uint32_t> visitStamps;
+    mutable uint32_t queryStamp;
+};
@@ -0,0 +1,67 @@
+/**
+ * @file stroke_lod.hpp
+ * @brief Multi-resolution simplifications of freehand strokes for zoomed-out frames
+ *
+ * When the board is zoomed out, a committed stroke covers only a few
+ * canvas pixels but still carries every point it was drawn with. Each
+ * stroke can keep a pyramid of RDP simplifications instead: level k drops
+ * detail finer than BASE_TOLERANCE * 2^k board units and is drawn at
+ * scales from 2^-k down to 2^-(k+1).
+ *
+ * Each level is simplified from the one before it, so building all of
+ * them costs about as much as simplifying the stroke once. The errors
+ * add up over the levels but stay below 2 * tolerance(k) board units,
+ * which is under half a canvas pixel wherever level k is drawn. Pyramids are
+ * built on first use and released whenever the stroke's points change;
+ * a translation moves them along.
+ */
+
+#pragma once
+
+#include <array>
+#include <vector>
+#include <cstdint>
+#include "simplify.hpp"
+#include "stroke_store.hpp"
+
+class StrokeLod {
+public:
+    static constexpr uint32_t LEVELS = 6;             ///< The coarsest level is drawn at 1/64 scale and below
+    static constexpr uint32_t NONE = UINT32_MAX;      ///< Handle of a stroke without a pyramid
+    static constexpr float BASE_TOLERANCE = 0.25f;    ///< Tolerance of level k is this * 2^k board units
+    static constexpr uint32_t MIN_POINTS = 8;         ///< Shorter strokes are always drawn in full
+
+    /// Level for a scale (canvas pixels per board unit); 0 is full detail
+    static uint32_t levelFor(float scale);
+    /// Largest distance, in board units, of a dropped point from a level
+    static float tolerance(uint32_t level) { return BASE_TOLERANCE * static_cast<float>(1u << level); }
+
+    /**
+     * @brief Build levels 1..LEVELS of a stroke
+     * @return Handle for the other methods
+     */
+    uint32_t build(const float* xs, const float* ys, uint32_t count);
+    void release(uint32_t handle);                          ///< Free a pyramid; its handle may be reused
+    void translate(uint32_t handle, float dx, float dy);    ///< Move every level of a pyramid
+    void clear();                                           ///< Drop all pyramids
+
+    // Points of a level in 1..LEVELS
+    uint32_t size(uint32_t handle, uint32_t level) const { return store.size(stroke(handle, level)); }
+    const float* xs(uint32_t handle, uint32_t level) const { return store.xs(stroke(handle, level)); }
+    const float* ys(uint32_t handle, uint32_t level) const { return store.ys(stroke(handle, level)); }
+
+    size_t livePoints() const { return store.livePoints(); } ///< Points held by all levels
+    size_t poolSize() const { return store.poolSize(); }     ///< Points reserved for all levels
+
+private:
+    using Levels = std::array<uint32_t, LEVELS>; ///< StrokeStore handle of levels 1..LEVELS
+
+    uint32_t stroke(uint32_t handle, uint32_t level) const { return pyramids[handle][level - 1]; }
+
+    StrokeStore store;
+    std::vector<Levels> pyramids;         ///< Indexed by handle
+    std::vector<uint32_t> freed;          ///< Released handles available for reuse
+    PolylineSimplifier simplifier;
+    std::vector<float> scratchX;          ///< The level being simplified
+    std::vector<float> scratchY;
+};
@@ -0,0 +1,97 @@
+/**
+ * @file stroke_store.hpp
+ * @brief Contiguous structure-of-arrays storage for freehand stroke points
+ *
+ * All stroke points live in two shared pools (xs[] and ys[]) instead of one
+ * heap-allocated vector per stroke. A stroke is a handle to a span
+ * (offset, length, capacity) inside those pools.
+ *
+ * - Appending to the most recently grown stroke is an in-place write, so
+ *   continueDrawing does not allocate per stroke.
+ * - Spans that outgrow their capacity move to the end of the pool; the
+ *   holes they leave are reclaimed by compacting once garbage outweighs
+ *   live points.
+ * - Translation, erasing and export walk plain float arrays.
+ *
+ * Colors are interned separately in a ColorTable so elements only carry
+ * a small id instead of their own std::string.
+ */
+
+#pragma once
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <unordered_map>
+
+/**
+ * @brief Interns color strings into small integer ids
+ *
+ * Ids are stable for the lifetime of the table; colors are never removed.
+ * The table holds at most CAPACITY colors (ids are 16-bit). Once it is
+ * full, new colors get id FULL_FALLBACK, the first color interned, and
+ * are not stored.
+ */
+class ColorTable {
+public:
+    static constexpr size_t CAPACITY = UINT16_MAX + 1;
+    static constexpr uint16_t FULL_FALLBACK = 0;
+
+    uint16_t intern(const std::string& color);                     ///< Id for a color, adding it if new
+    const std::string& name(uint16_t id) const { return colors[id]; } ///< Color string for an id
+    size_t size() const { return colors.size(); }
+    void clear();
+
+private:
+    std::vector<std::string> colors;
+    std::unordered_map<std::string, uint16_t> ids;
+};
+
+/**
+ * @brief Arena of stroke point spans in structure-of-arrays layout
+ */
+class StrokeStore {
+public:
+    uint32_t create();                               ///< New empty stroke; returns its handle
+    void release(uint32_t stroke);                   ///< Free a stroke; its handle may be reused
+    void clear();                                    ///< Drop all strokes and points
+
+    void append(uint32_t stroke, float x, float y); ///< Add a point to the end of a stroke
+
+    /**
+     * @brief Shrink a stroke to its first `length` points
+     *
+     * Used after in-place compaction of a stroke's points.
+     */
+    void truncate(uint32_t stroke, uint32_t length);
+
+    uint32_t size(uint32_t stroke) const { return spans[stroke].length; }
+    float* xs(uint32_t stroke) { return pointsX.data() + spans[stroke].offset; }
+    float* ys(uint32_t stroke) { return pointsY.data() + spans[stroke].offset; }
+    const float* xs(uint32_t stroke) const { return pointsX.data() + spans[stroke].offset; }
+    const float* ys(uint32_t stroke) const { return pointsY.data() + spans[stroke].offset; }
+
+    size_t livePoints() const { return live; }        ///< Points in use by strokes
+    size_t poolSize() const { return pointsX.size(); } ///< Points reserved in the pools
+
+private:
+    struct Span {
+        uint32_t offset = 0;
+        uint32_t length = 0;
+        uint32_t capacity = 0;
+        bool used = false;
+    };
+
+    static constexpr uint32_t MIN_CAPACITY = 16;
+    static constexpr size_t MIN_GARBAGE_TO_COMPACT = 4096;
+
+    void relocate(Span& span, uint32_t capacity);
+    void compactIfWasteful();
+
+    std::vector<float> pointsX;   ///< X coordinates of all strokes
+    std::vector<float> pointsY;   ///< Y coordinates of all strokes
+    std::vector<Span> spans;      ///< Indexed by stroke handle
+    std::vector<uint32_t> freed;  ///< Released handles available for reuse
+    size_t live = 0;              ///< Sum of span lengths
+    size_t reserved = 0;          ///< Sum of span capacities
+};
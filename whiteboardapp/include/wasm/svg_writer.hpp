@@ -0,0 +1,56 @@
+/**
+ * @file svg_writer.hpp
+ * @brief Allocation-light SVG markup output for the vector export
+ *
+ * Markup is appended to a reusable byte buffer, which JavaScript reads
+ * through a typed-array view. Nothing goes through iostreams:
+ *
+ * - Numbers are written with a fixed number of decimals by integer
+ *   arithmetic, with trailing zeros trimmed ("12.5", not "12.500000").
+ * - Path data starts absolute and continues with relative "l" deltas, so
+ *   a long stroke is mostly short pairs like "1.5-2". Deltas are taken
+ *   between rounded coordinates, so rounding never accumulates along
+ *   a path.
+ * - Fitted curves use relative "c" segments the same way, each control
+ *   point relative to the start of its segment.
+ */
+
+#pragma once
+
+#include <vector>
+#include <string>
+#include <cstddef>
+#include <cstdint>
+
+class SvgWriter {
+public:
+    static constexpr uint32_t MAX_DECIMALS = 4;
+
+    void setDecimals(uint32_t decimals); ///< Clamped to MAX_DECIMALS
+    void clear() { buffer.clear(); }     ///< Keeps the capacity
+
+    void text(const char* value);
+    void number(float value);
+
+    /// ` name="value"`, escaping the markup characters of the value
+    void attribute(const char* name, const std::string& value);
+    void attribute(const char* name, float value);
+
+    /// ` d="..."` for an open polyline; repeated rounded points are skipped
+    void pathData(const float* xs, const float* ys, uint32_t count);
+
+    /// ` d="..."` for 3n + 1 points of n cubic Bézier segments
+    void curveData(const float* xs, const float* ys, uint32_t count);
+
+    const std::vector<uint8_t>& data() const { return buffer; }
+    size_t size() const { return buffer.size(); }
+
+private:
+    int64_t quantize(float value) const;
+    void fixed(int64_t scaled); ///< Write scaled / 10^decimals
+    void delta(int64_t dx, int64_t dy, bool first); ///< A coordinate pair after a command letter
+
+    std::vector<uint8_t> buffer;
+    uint32_t decimals = 2;
+    int64_t unit = 100; ///< 10^decimals
+};
@@ -0,0 +1,66 @@
+/**
+ * @file tile_cache.hpp
+ * @brief Bookkeeping for the tiled raster cache of committed elements
+ *
+ * The board is split into fixed-size square tiles. JavaScript owns the
+ * actual pixels (one OffscreenCanvas per tile, see src/lib/commandReplay.ts);
+ * this class only remembers which tiles are up to date.
+ *
+ * - READY tiles hold a raster of every committed element touching them and
+ *   are simply blitted.
+ * - EMPTY tiles are known to contain nothing and are skipped.
+ * - Any other tile is stale and gets re-rasterized before use.
+ *
+ * Tiles are rasterized at a zoom, a power of two no larger than the view
+ * scale, so a zoomed-out view still blits a screenful of tiles instead of
+ * thousands of full-resolution ones. A tile always has the same pixel size;
+ * the board area it covers grows as the zoom shrinks.
+ *
+ * Edits to committed elements invalidate the tiles under their ink bounds.
+ * Live elements (the stroke being drawn and the selection) are not part of
+ * the tiles, so drawing and dragging never trigger re-rasterization.
+ */
+
+#pragma once
+
+#include <unordered_map>
+#include <cstdint>
+#include "spatial_index.hpp"
+
+class TileCache {
+public:
+    enum class State : uint8_t { STALE, EMPTY, READY };
+
+    struct Range {
+        int32_t x0, y0, x1, y1;
+    };
+
+    /**
+     * @brief Create an empty cache
+     * @param tilePixels Tile edge length in raster pixels
+     */
+    explicit TileCache(float tilePixels = 256.0f);
+
+    float size() const { return tileSize; }   ///< Tile edge length in board units
+    float zoom() const { return tileZoom; }   ///< Raster pixels per board unit
+
+    /// Change the raster zoom; every tile becomes stale when it changes
+    void setZoom(float zoom);
+
+    State state(int32_t tx, int32_t ty) const;
+    void setState(int32_t tx, int32_t ty, State state);
+
+    void invalidate(const Box& area); ///< Mark tiles overlapping an area stale
+    void clear();                     ///< Mark every tile stale
+
+    Range rangeFor(const Box& area) const;   ///< Tiles overlapping an area
+    Box tileBox(int32_t tx, int32_t ty) const; ///< Board area covered by a tile
+
+private:
+    static uint64_t key(int32_t tx, int32_t ty);
+
+    float tilePixels;
+    float tileZoom = 1;
+    float tileSize;
+    std::unordered_map<uint64_t, State> states; ///< Absent tiles are stale
+};
@@ -1,221 +1,1379 @@
 /**
  * @file whiteboard.hpp
- * @brief Core drawing functionality for the WebAssembly whiteboard application
- * 
- * This file contains the class definitions for the whiteboard's drawing system.
- * The implementation is designed to be compiled to WebAssembly and used from JavaScript/TypeScript.
- * 
- * The architecture follows a component-based design where each drawable element
- * (shapes, lines, etc.) inherits from a common base class.
+ * @brief Element model and the Whiteboard engine
+ *
+ * The engine has no Emscripten dependency: buffers go in as pointers and
+ * come out as references to vectors it owns, and draw() takes any canvas
+ * type. Templates and short accessors are defined here, the rest of the
+ * class in src/wasm/whiteboard.cpp. wasm/whiteboard.cpp binds it to
+ * JavaScript; bench/ builds it natively.
+ *
+ * Elements are plain structs kept in one contiguous array per type, in
+ * id (draw) order. A tagged ElementRef says which array an id lives in
+ * and where; code that handles any element dispatches on the tag at
+ * compile time (see ElementTraits and Whiteboard::visitElement()), so
+ * there are no virtual calls and no shared ownership on the draw and
+ * hit-test paths.
+ *
+ * Heavy per-element data lives outside the structs and is addressed by
+ * handles: stroke points in a StrokeStore, simplified levels in a
+ * StrokeLod, fitted curves in a second StrokeStore.
  */
 
 #pragma once
 
 #include <vector>
-#include <emscripten/bind.h>
-#include <emscripten/val.h>
 #include <string>
 #include <cmath>
-#include <memory>
+#include <cstdint>
+#include <algorithm>
+#include <unordered_map>
+#include "command_buffer.hpp"
+#include "spatial_index.hpp"
+#include "stroke_store.hpp"
+#include "point_kernels.hpp"
+#include "dirty_region.hpp"
+#include "tile_cache.hpp"
+#include "simplify.hpp"
+#include "stroke_lod.hpp"
+#include "curve_fit.hpp"
+#include "svg_writer.hpp"
+#include "raster.hpp"
+#include "image_encode.hpp"
+#include "work_pool.hpp"
+#include "ink_filter.hpp"
+#include "byte_stream.hpp"
+#include "history.hpp"
+#include "crdt.hpp"
+#include "perf_stats.hpp"
 
 /**
- * @brief Represents a 2D point in the drawing canvas
- * 
- * Used as a basic building block for all drawing operations.
- * Coordinates are in canvas pixel space.
+ * @brief Drawing tools; the values match the TypeScript ShapeType enum
+ *
+ * FREEHAND strokes are Lines; every other tool makes a Shape.
  */
+enum class ShapeType {
+    FREEHAND,
+    RECTANGLE,
+    CIRCLE,
+    LINE,
+    TRIANGLE
+};
+
 struct Point {
-    float x;  ///< X coordinate in pixels from the left edge
-    float y;  ///< Y coordinate in pixels from the top edge
+    float x;
+    float y;
+};
+
+struct Shape {
+    uint32_t id;
+    uint64_t uid;    ///< Stable id shared with peers (site << 32 | counter)
+    Point start;
+    Point end;
+    ShapeType type;
+    uint16_t color;  ///< Id in the Whiteboard's ColorTable
+    float thickness;
+    bool selected;
+
+    Shape() : selected(false) {}
 };
 
+constexpr uint32_t NO_CURVE = UINT32_MAX;
+
 /**
- * @brief Represents a rectangular boundary
- * 
- * Used for:
- * - Shape boundaries
- * - Selection areas
- * - Hit testing
- * - Clipping regions
+ * @brief Freehand stroke
+ *
+ * Points are not owned by the line: they live in the Whiteboard's
+ * StrokeStore and are addressed through the `stroke` handle. The
+ * polyline is authoritative; the fitted curve only draws, exports and
+ * saves it more compactly.
  */
-struct Rect {
-    float x;      ///< Left edge X coordinate
-    float y;      ///< Top edge Y coordinate
-    float width;  ///< Width of rectangle
-    float height; ///< Height of rectangle
+struct Line {
+    uint32_t id;
+    uint64_t uid;    ///< Stable id shared with peers (site << 32 | counter)
+    uint32_t stroke; ///< Point span handle in the StrokeStore
+    uint32_t lod;    ///< Simplification pyramid in the StrokeLod, or StrokeLod::NONE
+    uint32_t curve;  ///< Fitted Béziers in the curve store, or NO_CURVE
+    bool curveLoaded; ///< `curve` came from a scene; saved as a curve whatever its size
+    Box bounds;      ///< Cached bounds of points, extended as points are appended
+    uint16_t color;  ///< Id in the Whiteboard's ColorTable
+    float thickness;
+    bool selected;
+
+    Line() : lod(StrokeLod::NONE), curve(NO_CURVE), curveLoaded(false), selected(false) {}
 };
 
+inline Box shapeBounds(const Shape& shape) {
+    Box box;
+    box.extend(shape.start.x, shape.start.y);
+    box.extend(shape.end.x, shape.end.y);
+    return box;
+}
+
+/// Geometric bounds of any element, without the stroke width
+inline Box elementBounds(const Line& line) { return line.bounds; }
+inline Box elementBounds(const Shape& shape) { return shapeBounds(shape); }
+
 /**
- * @brief Available shape types for drawing
- * 
- * Each shape type represents a different drawing tool that the user can select.
- * The enum values match the TypeScript ShapeType enum for consistency.
+ * @brief Where an element id currently lives
+ *
+ * Ids index the spatial grid; lines and shapes share one id space.
+ * The index is updated whenever a vector is compacted.
+ *
+ * These local ids are dense and never reused within a session, so `refs`
+ * works as a slot map. Peers address elements by their 64-bit uid instead
+ * (the creating site in the high half, a per-site counter in the low
+ * half), which `uidToId` maps back to the local id.
  */
-enum class ShapeType {
-    FREEHAND,   ///< Freehand drawing tool
-    RECTANGLE,  ///< Rectangle shape tool
-    CIRCLE,     ///< Circle shape tool
-    LINE,       ///< Straight line tool
-    TRIANGLE    ///< Triangle shape tool (prepared for future use)
+enum class ElementKind : uint8_t { LINE, SHAPE };
+
+struct ElementRef {
+    ElementKind kind;
+    uint32_t index;
 };
 
 /**
- * @brief Base class for all drawable elements
- * 
- * This abstract class defines the interface that all drawable elements must implement.
- * It provides virtual methods for:
- * - Drawing
- * - Hit testing
- * - Movement
- * - Bounds calculation
+ * @brief Compile-time tag of each element type
+ *
+ * Templates over the element type use this to match refs against the
+ * array they are working on.
  */
-class DrawableElement {
-public:
-    virtual ~DrawableElement() = default;
+template <typename T>
+struct ElementTraits;
+
+template <>
+struct ElementTraits<Line> {
+    static constexpr ElementKind kind = ElementKind::LINE;
+};
+
+template <>
+struct ElementTraits<Shape> {
+    static constexpr ElementKind kind = ElementKind::SHAPE;
+};
+
+/// Encodings of Whiteboard::renderImage(); values match the TypeScript ImageFormat enum
+enum class ImageFormat : uint8_t {
+    RGBA = 0, ///< Raw straight-alpha pixels, row by row
+    PNG = 1,
+    QOI = 2
+};
+
+/**
+ * @brief Counters returned by Whiteboard::getStats()
+ *
+ * The timings are the last duration of each section in milliseconds, and
+ * stay 0 unless profiling is on (see Whiteboard::setProfiling()).
+ */
+struct WhiteboardStats {
+    uint32_t lines = 0;
+    uint32_t shapes = 0;
+    uint32_t points = 0;          ///< Full-detail stroke points
+    uint32_t bytesInUse = 0;      ///< Element, point, history and command storage
+    uint32_t frames = 0;          ///< Frames drawn since creation
+    uint32_t boundaryCalls = 0;   ///< Calls from JavaScript during the last frame, its draw call included
+    uint32_t commandFloats = 0;   ///< Size of the last command buffer
+    uint32_t timingsWritten = 0;  ///< Samples ever written to the timing ring
+    double drawMs = 0;
+    double hitTestMs = 0;
+    double eraseMs = 0;
+    double serializeMs = 0;
+    double deserializeMs = 0;
+    double exportMs = 0;
+    double syncMs = 0;
+};
+
+class Whiteboard {
+private:
+    std::vector<Line> lines;
+    std::vector<Shape> shapes;
+    std::string currentColor;
+    float currentThickness;
+    Point selectionStart;
+    Point selectionEnd;
+    bool isSelecting;
+    bool isDrawingShape;
+    ShapeType currentShape;
+    Shape* currentShapePtr;
+    CommandBuffer commands;
+    StrokeStore strokes;                ///< Point storage for all lines
+    ColorTable colors;                  ///< Interned element colors
+    SpatialGrid index;                  ///< Element bounds keyed by id
+    std::vector<ElementRef> refs;       ///< Element id -> vector position
+    std::vector<uint32_t> selectedIds;  ///< Ids with selected == true, ascending
+    std::vector<uint32_t> previousSelection; ///< Scratch buffer for selection diffs
+    std::vector<uint32_t> queryHits;    ///< Scratch buffer for grid queries
+    std::vector<uint32_t> dirtyHits;    ///< Scratch buffer for damaged-area queries
+    DirtyRegion damage;                 ///< Areas to repaint in the next dirty frame
+    TileCache tiles;                    ///< Which raster tiles of committed elements are current
+    bool tilesEnabled = false;          ///< Blit committed elements from tiles in dirty frames
+    bool dropTiles = false;             ///< Tell JavaScript to free all tile rasters
+    float maxInkPad = 0;                ///< Largest inkBounds padding of any element
+    float viewWidth = 0;                ///< Visible canvas size in pixels, for full repaints
+    float viewHeight = 0;
+    float viewX = 0;                    ///< Board point shown at the canvas origin
+    float viewY = 0;
+    float viewScale = 1;                ///< Canvas pixels per board unit
+    StrokeLod lods;                     ///< Simplified levels of committed strokes
+    uint32_t lodLevel = 0;              ///< Pyramid level drawn at viewScale; 0 is full detail
+    std::vector<Box> visibleDamage;     ///< Scratch buffer: damaged areas clipped to the view
+    std::vector<uint32_t> tileHits;     ///< Scratch buffer for tile rasterization
+    std::vector<uint64_t> tileKeys;     ///< Scratch buffer of tiles to blit
+    StrokeStore curves;                 ///< Fitted Béziers of committed strokes, 3n + 1 points each
+    CurveFitter fitter;
+    float curveTolerance = 0;           ///< Fitting error bound in pixels; 0 keeps strokes as polylines
+    static constexpr uint32_t MIN_CURVE_POINTS = 8; ///< Shorter strokes are not worth fitting
+    static constexpr float FLATTEN_TOLERANCE = 0.25f; ///< Polyline error of strokes loaded as curves
+    static constexpr float MAX_CURVE_TOLERANCE = 1.0f; ///< Keeps curves inside the inkBounds() padding
+    std::vector<float> curveXs;         ///< Scratch buffers for fitting and flattening
+    std::vector<float> curveYs;
+
+    PolylineSimplifier simplifier;      ///< Simplifies freehand strokes in endDrawing
+    float simplifyTolerance = 0;        ///< RDP tolerance in pixels; 0 keeps every point
+    float minPointDistance = 0;         ///< Samples closer than this to the last point are dropped
+    bool hasPendingPoint = false;       ///< A dropped sample that may still end the stroke
+    Point pendingPoint;
+
+    InkFilter ink;                      ///< Smooths and predicts timed samples of the local stroke
+    float predictionHorizon = 0;        ///< Milliseconds of ink predicted past the last sample; 0 disables
+    static constexpr uint32_t PREDICTION_POINTS = 4;
+    std::vector<float> predictionXs;    ///< Predicted tail of the local stroke, drawn but never committed
+    std::vector<float> predictionYs;
+    Box predictionInk;                  ///< Area the drawn tail covers, repainted when it changes
+    bool hasRawPoint = false;           ///< Last unfiltered sample, where a smoothed stroke ends
+    Point rawPoint;
+
+    ByteWriter sceneBytes;              ///< Output of the last serialize()
+    SvgWriter svgOut;                   ///< Output of the last getSVGPaths() or nextSVGChunk()
+    bool svgExporting = false;          ///< beginSVGExport() was called and chunks remain
+    bool svgShapes = false;             ///< Lines are written; the export is at the shapes
+    uint32_t svgNextId = 0;             ///< Next element id to write in the current phase
+    uint32_t svgEndId = 0;              ///< Elements created after beginSVGExport() are left out
+    static constexpr uint32_t MAX_IMAGE_SIDE = 8192; ///< Largest renderImage() width or height
+    static constexpr uint32_t MIN_BAND_ROWS = 64;    ///< Thinnest band renderImage() hands a thread
+    std::vector<Rasterizer> rasters;    ///< One per horizontal band of the last renderImage()
+    std::vector<uint8_t> imagePixels;   ///< The bands joined, when there were several
+    std::vector<uint8_t> imageBytes;    ///< Encoded output of the last renderImage()
+
+    WorkPool pool;                      ///< Helper threads in the pthreads build; inline elsewhere
+    PerfRecorder perf;                  ///< Counters and timers for getStats() and getTimings()
+    static constexpr uint32_t PARALLEL_MIN_POINTS = 16384; ///< Smaller selections move on one thread
+    static constexpr uint32_t PARALLEL_MIN_HITS = 2048;    ///< Fewer selection candidates test on one thread
+    std::vector<uint8_t> hitFlags;      ///< Scratch buffer: per-candidate results of parallel hit tests
 
     /**
-     * @brief Draw the element to the canvas context
-     * @param context JavaScript canvas 2D context passed from TypeScript
+     * @brief Record types of the stroke stream (see takeStrokeBatch())
      */
-    virtual void draw(emscripten::val context) = 0;
+    enum class StreamOp : uint8_t { BEGIN = 1, POINTS = 2, END = 3, SHAPE = 4 };
+
+    struct RemoteStroke {
+        uint32_t id;      ///< Local element id of the remote stroke
+        uint32_t sender;  ///< Index in remoteSenders
+        int64_t qx, qy;   ///< Last decoded point, quantized
+    };
+
+    bool streaming = false;             ///< Record local edits for takeStrokeBatch()
+    ByteWriter outgoing;                ///< Stream records not yet taken
+    ByteWriter strokeBatch;             ///< Output of the last takeStrokeBatch()
+    uint32_t streamId = NO_ELEMENT;     ///< Element id of the stroke being streamed
+    uint32_t streamSent = 0;            ///< Points of it already in `outgoing`
+    int64_t streamQx = 0;               ///< Last streamed point, quantized
+    int64_t streamQy = 0;
+    std::unordered_map<std::string, uint32_t> remoteSenders; ///< Peer id -> small index
+    std::unordered_map<uint64_t, RemoteStroke> remoteStrokes; ///< Uid -> stroke in progress
+    std::vector<uint32_t> remoteLive;   ///< Ids of remote strokes in progress, ascending
+
+    History history;                    ///< Undo/redo log of local edits
+    bool recordHistory = true;          ///< Off while undo/redo replays edits
+    std::vector<float> eraseScratchX;   ///< Surviving pieces of the line being erased
+    std::vector<float> eraseScratchY;
+    std::vector<uint32_t> erasePieces;  ///< End offset of each piece in eraseScratchX/Y
+
+    uint32_t siteId = 0;                ///< High half of uids created here
+    uint32_t nextCounter = 1;           ///< Low half of the next local uid
+    std::unordered_map<uint64_t, uint32_t> uidToId; ///< Stable uid -> local id
+    std::vector<uint64_t> selectedUids; ///< Output of getSelectedIds()
+    size_t removedPending = 0;          ///< Elements removed from the grid, not yet compacted out
 
     /**
-     * @brief Test if a point is within/near the element
-     * @param x X coordinate to test
-     * @param y Y coordinate to test
-     * @return true if point is contained/near the element
+     * @brief Record types of the replication ops (see collectLocalOps())
      */
-    virtual bool containsPoint(float x, float y) = 0;
+    enum class ReplicaOp : uint8_t { ELEMENT = 1, STYLE = 2, OFFSET = 3, GEOMETRY = 4 };
+
+    struct GeometryRecord {
+        uint8_t type;               ///< ShapeType; FREEHAND for lines
+        std::vector<float> xs, ys;  ///< Line points, or the two shape corners
+    };
+
+    ReplicaSet replicas;                ///< CRDT metadata for merging peers' edits
+    bool applyingRemote = false;        ///< Edits come from applyRemoteOps(); do not echo them
+    ByteWriter opsBatch;                ///< Output of the last collectLocalOps()
+    ByteWriter snapshotBytes;           ///< Output of the last snapshotOps()
+    std::vector<Stamp> remoteAdded;     ///< Scratch buffers for decoding ops
+    std::vector<Stamp> remoteRemoved;
+    GeometryRecord remoteGeometry;
+
+    static constexpr uint32_t NO_ELEMENT = UINT32_MAX;
+    uint32_t currentId = NO_ELEMENT;    ///< Element being drawn, not yet committed
+
+    // Canvas area an element's ink can cover, including the selection restroke
+    static Box inkBounds(Box box, float thickness);
+
+    template <typename T>
+    std::vector<T>& elementsOf() {
+        if constexpr (ElementTraits<T>::kind == ElementKind::LINE) return lines;
+        else return shapes;
+    }
+    template <typename T>
+    const std::vector<T>& elementsOf() const {
+        if constexpr (ElementTraits<T>::kind == ElementKind::LINE) return lines;
+        else return shapes;
+    }
 
     /**
-     * @brief Move the element by a relative offset
-     * @param dx X offset in pixels
-     * @param dy Y offset in pixels
+     * @brief Call visitor with the element behind an id, as a Line or a Shape
+     *
+     * A generic lambda gets one body per type, so both calls are direct.
      */
-    virtual void move(float dx, float dy) = 0;
+    template <typename Visitor>
+    decltype(auto) visitElement(uint32_t id, Visitor&& visitor) {
+        const ElementRef& ref = refs[id];
+        if (ref.kind == ElementKind::LINE) return visitor(lines[ref.index]);
+        return visitor(shapes[ref.index]);
+    }
+    template <typename Visitor>
+    decltype(auto) visitElement(uint32_t id, Visitor&& visitor) const {
+        const ElementRef& ref = refs[id];
+        if (ref.kind == ElementKind::LINE) return visitor(lines[ref.index]);
+        return visitor(shapes[ref.index]);
+    }
+
+    /// Visit the elements of type T among ids that are still on the board, in the order given
+    template <typename T, typename Visitor>
+    void forEachOfType(const std::vector<uint32_t>& ids, Visitor&& visitor) {
+        std::vector<T>& items = elementsOf<T>();
+        for (uint32_t id : ids) {
+            // A removed id's slot may already be compacted away
+            if (refs[id].kind == ElementTraits<T>::kind && index.contains(id)) visitor(items[refs[id].index]);
+        }
+    }
+    template <typename T, typename Visitor>
+    void forEachOfType(const std::vector<uint32_t>& ids, Visitor&& visitor) const {
+        const std::vector<T>& items = elementsOf<T>();
+        for (uint32_t id : ids) {
+            // A removed id's slot may already be compacted away
+            if (refs[id].kind == ElementTraits<T>::kind && index.contains(id)) visitor(items[refs[id].index]);
+        }
+    }
+
+    Box elementInk(uint32_t id) const;
 
     /**
-     * @brief Get the bounding rectangle of the element
-     * @return Rect struct containing the element's bounds
+     * @brief Live elements are drawn directly every frame instead of from tiles
      */
-    virtual Rect getBounds() = 0;
+    bool isLive(uint32_t id) const;
 
-    std::string color;     ///< Element color in HTML format (e.g., "#000000")
-    float thickness;       ///< Line thickness in pixels
-    bool selected = false; ///< Selection state for move/delete operations
-};
+    // The local stroke in progress or a remote one still streaming in
+    bool beingDrawn(uint32_t id) const {
+        return id == currentId || std::binary_search(remoteLive.begin(), remoteLive.end(), id);
+    }
 
-/**
- * @brief Represents a freehand drawn line
- * 
- * Stores a series of points that make up a freehand drawing.
- * Points are connected with line segments to create a smooth curve.
- */
-class Line : public DrawableElement {
-public:
-    std::vector<Point> points; ///< Series of points making up the line
-    void draw(emscripten::val context) override;
-    bool containsPoint(float x, float y) override;
-    void move(float dx, float dy) override;
-    Rect getBounds() override;
-};
+    /**
+     * @brief Flush the last dropped sample and simplify the stroke being drawn
+     */
+    void finishStroke();
 
-/**
- * @brief Represents a rectangle shape
- * 
- * Stores a rectangle's position and size.
- * The rectangle can be drawn with different colors and line thicknesses.
- */
-class Rectangle : public DrawableElement {
-public:
-    Rect bounds; ///< Rectangle's position and size
-    void draw(emscripten::val context) override;
-    bool containsPoint(float x, float y) override;
-    void move(float dx, float dy) override;
-    Rect getBounds() override { return bounds; }
-};
+    void simplifyLine(Line& line, float tolerance);
 
-/**
- * @brief Represents a circle shape
- * 
- * Stores a circle's center point and radius.
- * The circle can be drawn with different colors and line thicknesses.
- */
-class Circle : public DrawableElement {
-public:
-    Point center; ///< Center point of the circle
-    float radius; ///< Radius of the circle in pixels
-    void draw(emscripten::val context) override;
-    bool containsPoint(float x, float y) override;
-    void move(float dx, float dy) override;
-    Rect getBounds() override;
-};
+    /**
+     * @brief The element being drawn becomes part of the committed (tiled) layer
+     */
+    void commitCurrent();
 
-/**
- * @brief Main whiteboard class that manages all drawing operations
- * 
- * This class is the primary interface between the C++ code and JavaScript/TypeScript.
- * It manages:
- * - Drawing state (current color, thickness, shape type)
- * - Element collection (storing all drawn elements)
- * - Selection state (selected elements, selection box)
- * - Drawing operations (start, continue, end drawing)
- * - Selection operations (select, move, delete)
- */
-class Whiteboard {
-private:
-    std::vector<std::shared_ptr<DrawableElement>> elements;    ///< All drawn elements
-    std::string currentColor;                                  ///< Current drawing color
-    float currentThickness;                                    ///< Current line thickness
-    ShapeType currentShape;                                    ///< Current shape tool
-    std::shared_ptr<DrawableElement> currentElement;           ///< Element being drawn
-    std::vector<std::shared_ptr<DrawableElement>> selectedElements; ///< Selected elements
-    bool isSelecting;                                         ///< Selection mode flag
-    Point selectionStart;                                     ///< Selection box start point
+    void commitElement(uint32_t id);
+
+    /**
+     * @brief Repaint an element and drop tiles it is baked into
+     */
+    void touchElement(uint32_t id);
+
+    void translateElement(uint32_t id, float dx, float dy);
+
+    /**
+     * @brief Move an element's points, touching only memory owned by that element
+     *
+     * Safe to run for different elements at once; commitTranslation() must follow.
+     */
+    void translateGeometry(uint32_t id, float dx, float dy);
 
-public:
     /**
-     * @brief Initialize whiteboard with default settings
-     * 
-     * Default settings:
-     * - Black color (#000000)
-     * - 2.0 pixel thickness
-     * - Freehand drawing mode
-     * - Selection mode off
+     * @brief Update the index and replica after translateGeometry()
      */
-    Whiteboard();
+    void commitTranslation(uint32_t id, float dx, float dy);
+
+    ElementSnapshot snapshotElement(uint32_t id) const;
 
     /**
-     * @brief Reset whiteboard to initial state
-     * 
-     * Clears all:
-     * - Drawn elements
-     * - Selected elements
-     * - Current drawing
-     * - Selection state
+     * @brief Put an element back exactly as snapshotted, under its original id
+     *
+     * Elements that still exist (e.g. partially erased lines) get their
+     * geometry and style replaced, also when a peer's re-add brought the
+     * uid back under another id. Removed ones are reinserted at their id's
+     * position, so vector order keeps matching id (draw) order.
+     *
+     * @return The id the element has now
      */
+    uint32_t restoreElement(const ElementSnapshot& snapshot);
+
+    /**
+     * @brief restoreElement() each snapshot; ids become where they landed, ascending
+     *
+     * Keeps a history entry pointing at the elements it restored.
+     */
+    void restoreElements(const std::vector<ElementSnapshot>& elements, std::vector<uint32_t>& ids);
+
+    template <typename T>
+    void insertInOrder(std::vector<T>& items, T item) {
+        auto position = std::lower_bound(items.begin(), items.end(), item.id,
+                                         [](const T& existing, uint32_t id) { return existing.id < id; });
+        size_t at = static_cast<size_t>(position - items.begin());
+        items.insert(position, std::move(item));
+        for (size_t i = at; i < items.size(); i++) {
+            refs[items[i].id] = {ElementTraits<T>::kind, static_cast<uint32_t>(i)};
+        }
+    }
+
+    void removeElements(const std::vector<uint32_t>& ids);
+
+    /**
+     * @brief Add an element to the open ERASE step before the eraser first changes it
+     * @param original Snapshot of the element taken before this erase call modified it
+     */
+    void recordErased(HistoryEntry*& step, ElementSnapshot original);
+
+    void openEraseStep(HistoryEntry*& step);
+
+    // Also true for pieces the open gesture split off: undo removes those anyway
+    bool erasedAlready(uint32_t id);
+
+    void damageElement(uint32_t id) {
+        damage.add(elementInk(id));
+    }
+
+    bool hasViewSize() const {
+        return viewWidth > 0 && viewHeight > 0;
+    }
+
+    /**
+     * @brief Board area shown on the canvas
+     */
+    Box viewBox() const;
+
+    /**
+     * @brief Ids of elements whose ink may be on screen, ascending
+     *
+     * Everything until the view size is known.
+     */
+    void queryVisible(std::vector<uint32_t>& out) const;
+
+    Box selectionBox() const;
+
+    // Only the dashed outline is painted, so damage its four edges
+    void damageSelectionBox();
+
+    /**
+     * @brief Points of a line at the current level of detail
+     *
+     * Zoomed out, committed strokes draw a level of their pyramid, built on
+     * first use. Strokes still being drawn change every frame, so they are
+     * always drawn in full.
+     */
+    uint32_t linePoints(Line& line, const float*& xs, const float*& ys);
+
+    /**
+     * @brief Fitted Béziers of a line, or 0 when it is drawn as a polyline
+     *
+     * Fitted on first use once the stroke is committed, like the pyramid.
+     * Curves from a loaded scene are kept even with fitting off.
+     */
+    uint32_t lineCurve(Line& line, const float*& xs, const float*& ys);
+
+    // The pyramid and curve no longer match the stroke's points
+    void dropLod(Line& line);
+
+    void encodeLine(Line& line);
+
+    void encodeShape(const Shape& shape);
+
+    static constexpr uint8_t SCENE_MAGIC[4] = {'W', 'B', 'S', 'C'};
+    static constexpr uint8_t SCENE_VERSION = 3;       ///< 2 added element uids, 3 fitted curves
+    static constexpr uint32_t SCENE_QUANTIZATION = 8; ///< Steps per pixel (1/8 px precision)
+    static constexpr uint8_t STREAM_VERSION = 2;      ///< 2 keys strokes by uid
+    static constexpr uint8_t OPS_VERSION = 1;
+
+    /// How a line's points are stored in a scene
+    enum class LineForm : uint8_t { POLYLINE = 0, CURVE = 1 };
+
+    static int64_t quantize(float value, uint32_t quantization) {
+        return static_cast<int64_t>(std::llround(static_cast<double>(value) * quantization));
+    }
+
+    static void writeDeltas(ByteWriter& out, const float* xs, const float* ys, uint32_t count);
+
+    void writeScene(ByteWriter& out);
+
+    bool readScene(const uint8_t* data, size_t size);
+
+    void streamBegin(const Line& line);
+
+    void streamShape(const Shape& shape);
+
+    /**
+     * @brief Write the points appended to the streamed stroke since the last flush
+     *
+     * Points are appended lazily so a whole frame of samples becomes one
+     * POINTS record.
+     */
+    void flushStreamPoints();
+
+    uint32_t remoteSenderIndex(const std::string& sender);
+
+    bool readStrokeBatch(uint32_t sender, const uint8_t* data, size_t size);
+
+    /**
+     * @brief Add a peer's stroke in progress, starting at one point
+     * @param qx, qy The point quantized, where the sender's next deltas start
+     */
+    void startRemoteStroke(uint64_t uid, uint32_t sender, const std::string& color, float thickness,
+                           float x, float y, int64_t qx, int64_t qy);
+
+    void pushShape(const Shape& shape);
+
+    /**
+     * @brief A remote stroke is finished and joins the committed (tiled) layer
+     */
+    void endRemoteStroke(uint32_t id);
+
+    static void writeStamp(ByteWriter& out, const Stamp& stamp);
+
+    static Stamp readStamp(ByteReader& in);
+
+    static void writeTags(ByteWriter& out, const std::vector<Stamp>& tags);
+
+    static bool readTags(ByteReader& in, std::vector<Stamp>& tags);
+
+    void writeStyle(ByteWriter& out, uint32_t id);
+
+    static void writeOffset(ByteWriter& out, const ElementReplica& replica);
+
+    /**
+     * @brief Encode an element's points or corners with its offset taken out
+     */
+    void writeGeometry(ByteWriter& out, uint32_t id, const ElementReplica& replica);
+
+    static bool readGeometry(ByteReader& in, GeometryRecord& geometry);
+
+    /**
+     * @brief Write an element's membership, plus its registers while it is present
+     * @param id Local id, or NO_ELEMENT if the element is removed here
+     */
+    void writeElement(ByteWriter& out, uint64_t uid, const ElementReplica& replica, uint32_t id);
+
+    /**
+     * @brief Write the pending local changes of one element
+     *
+     * Membership changes carry the whole element, so peers that never saw
+     * it (or removed it) can recreate it; other changes carry one register.
+     */
+    void writeOps(ByteWriter& out, uint64_t uid, uint8_t fields);
+
+    void applyStyle(uint32_t id, const std::string& color, float thickness);
+
+    void applyOffset(uint32_t id, ElementReplica& replica, float ox, float oy);
+
+    void applyGeometry(uint32_t id, const ElementReplica& replica, const GeometryRecord& geometry);
+
+    /**
+     * @brief Create an element a peer added, at the top of the draw order
+     */
+    void createReplicated(uint64_t uid, const std::string& color, float thickness,
+                          const ElementReplica& replica, const GeometryRecord& geometry);
+
+    /**
+     * @brief Decode and merge one replication record
+     * @return false if the record is malformed
+     */
+    bool readOp(ByteReader& in);
+
+    bool readOps(const uint8_t* data, size_t size);
+
+    /**
+     * @brief Re-rasterize stale tiles overlapping the areas, then blit them
+     */
+    void encodeTiles(const Box* areas, size_t areaCount);
+
+    TileCache::State rasterizeTile(int32_t tx, int32_t ty);
+
+    /**
+     * @brief Stroke the element being drawn and the selection, where they meet the areas
+     */
+    void encodeLiveElements(const Box* areas, size_t areaCount);
+
+    void encodeSelectionBox();
+
+    void addPoint(Line& line, float x, float y);
+
+    /**
+     * @brief Append a point to the stroke being drawn; only the new segment needs repainting
+     */
+    void continueDrawingPoint(Line& line, float x, float y);
+
+    // The line being drawn locally, or null
+    Line* drawingLine();
+
+    void clearPrediction();
+
+    /**
+     * @brief Replace the predicted tail after new samples of the local stroke
+     *
+     * The tail runs from the last kept point (and a dropped sample after it)
+     * through the points InkFilter expects next.
+     */
+    void updatePrediction(const Line& line);
+
+    void encodePrediction();
+
+    void recomputeBounds(Line& line);
+
+    // Storage owned outside the element, freed when it is compacted away
+    void releaseStorage(const Line& line);
+    void releaseStorage(const Shape&) {}
+
+    uint32_t nextId(ElementKind kind, size_t position);
+
+    uint64_t newUid(uint32_t id);
+
+    uint64_t uidOf(uint32_t id) const;
+
+    /**
+     * @brief Local id of a live element, or NO_ELEMENT
+     */
+    uint32_t findUid(uint64_t uid) const;
+
+    /**
+     * @brief Empty the board for loading; unlike clear() this is not an edit
+     *
+     * No undo step is recorded and no removals are replicated to peers.
+     */
+    void resetBoard();
+
+    /**
+     * @brief Compact out elements removed by removeElement()
+     *
+     * removeElement() only drops the element from the grid so it is O(1);
+     * paths that walk the element vectors directly call this first.
+     */
+    void flushRemovals();
+
+    /**
+     * @brief Remove matching items in one stable pass and keep ids/grid in sync
+     * @return true if anything was removed
+     */
+    template <typename T, typename Pred>
+    bool compact(std::vector<T>& items, Pred shouldRemove) {
+        size_t out = 0;
+        for (size_t i = 0; i < items.size(); i++) {
+            if (shouldRemove(items[i])) {
+                index.remove(items[i].id);
+                // A peer's re-add may already have put the uid under a new id
+                auto mapped = uidToId.find(items[i].uid);
+                if (mapped != uidToId.end() && mapped->second == items[i].id) uidToId.erase(mapped);
+                releaseStorage(items[i]);
+                continue;
+            }
+            if (out != i) {
+                items[out] = std::move(items[i]);
+                refs[items[out].id].index = static_cast<uint32_t>(out);
+            }
+            out++;
+        }
+        if (out == items.size()) return false;
+        items.erase(items.begin() + out, items.end());
+        return true;
+    }
+
+    // Board colors are CSS hex strings; anything else rasterizes as opaque black
+    uint32_t rasterColor(uint16_t color) const;
+
+    /**
+     * @brief Draw the elements into a rasterizer, lines under shapes as on screen
+     *
+     * Only reads the scene, so bands of one image can be drawn at once.
+     */
+    void rasterizeElements(Rasterizer& raster, const std::vector<uint32_t>& ids) const;
+
+    void writeSvgLine(Line& line);
+
+    void writeSvgShape(const Shape& shape);
+
+    /**
+     * @brief Write elements from svgNextId on until the chunk is full
+     * @return false once every element of this phase is written
+     */
+    template <typename T, typename Write>
+    bool writeSvgElements(std::vector<T>& items, size_t maxBytes, Write write) {
+        auto position = std::lower_bound(items.begin(), items.end(), svgNextId,
+                                         [](const T& item, uint32_t id) { return item.id < id; });
+        for (; position != items.end() && position->id < svgEndId; ++position) {
+            if (svgOut.size() >= maxBytes) return true;
+            write(*position);
+            svgNextId = position->id + 1;
+        }
+        return false;
+    }
+
+public:
+    Whiteboard() : currentColor("#000000"), currentThickness(2.0f), 
+                  isSelecting(false), isDrawingShape(false),
+                  currentShape(ShapeType::FREEHAND), currentShapePtr(nullptr) {
+        init();
+    }
+
     void init();
 
-    // Drawing operations
-    void startDrawing(float x, float y);    ///< Start a new drawing operation
-    void continueDrawing(float x, float y); ///< Continue current drawing
-    void endDrawing();                      ///< End current drawing
-    void draw(emscripten::val context);     ///< Draw all elements
-
-    // Shape management
-    void setShapeType(ShapeType type);           ///< Set current shape tool
-    void setColor(const std::string& color);     ///< Set current color
-    void setThickness(float thickness);          ///< Set current line thickness
-
-    // Selection tools
-    void startSelection(float x, float y);    ///< Start selection box
-    void updateSelection(float x, float y);   ///< Update selection box
-    void endSelection();                      ///< End selection operation
-    void moveSelected(float dx, float dy);    ///< Move selected elements
-    void deleteSelected();                    ///< Delete selected elements
-    void clearSelection();                    ///< Clear selection state
-
-    // Canvas management
-    void clear();                            ///< Clear entire canvas
-    void erase(float x, float y, float radius); ///< Erase at point
-}; 
\ No newline at end of file
+    void startDrawing(float x, float y);
+
+    void continueDrawing(float x, float y);
+
+    /**
+     * @brief Continue the local stroke with a batch of timed samples
+     * @param samples count x, y, time triplets, e.g. from getCoalescedEvents();
+     *                time is in milliseconds since the startDrawing() sample
+     *
+     * Samples are smoothed (see setInkSmoothing()) before they are kept, and
+     * the predicted continuation (see setInkPrediction()) is redrawn. The
+     * prediction is never committed or streamed to peers.
+     */
+    void continueDrawingSamples(const float* samples, size_t count);
+
+
+    /**
+     * @brief One-euro smoothing of continueDrawingSamples() input
+     * @param minCutoff Cutoff frequency in Hz when the pen is slow; 0 disables smoothing
+     * @param beta Cutoff increase per board unit per second of speed
+     */
+    void setInkSmoothing(float minCutoff, float beta) {
+        ink.configure(minCutoff, beta);
+    }
+
+    /**
+     * @brief Draw the stroke this many milliseconds ahead of the last sample
+     *
+     * A frame or two (16-32 ms) hides most of the input latency; 0 disables.
+     */
+    void setInkPrediction(float horizon);
+
+    void endDrawing();
+
+    void startSelection(float x, float y);
+
+    void updateSelection(float x, float y);
+
+    uint32_t selectedPointCount() const;
+
+    /**
+     * @brief Whether the rubber band selects an element whose bounds touch it
+     */
+    bool selectionHits(uint32_t id, const Box& area) const;
+
+    // Lines are selected when any of their points is inside the box
+    bool selectionHits(const Line& line, const Box& area) const;
+
+    // Shapes must be fully contained
+    bool selectionHits(const Shape& shape, const Box& area) const;
+
+    void endSelection();
+
+    /**
+     * @brief Change an element's selected flag and repaint it
+     */
+    void setSelected(uint32_t id, bool selected);
+
+    /**
+     * @brief Reset the selected flag of every element in selectedIds
+     */
+    void deselectAll();
+
+    void clearSelection();
+
+    void moveSelected(float dx, float dy);
+
+    void deleteSelected();
+
+    void setColor(const std::string& color);
+
+    void setThickness(float thickness) {
+        currentThickness = thickness;
+    }
+
+    /**
+     * @brief Simplify finished freehand strokes with RDP
+     * @param tolerance Maximum deviation in pixels; 0 disables simplification
+     */
+    void setSimplifyTolerance(float tolerance) {
+        simplifyTolerance = tolerance;
+    }
+
+    /**
+     * @brief Fit committed freehand strokes with cubic Béziers for drawing, SVG and scenes
+     * @param tolerance Largest distance of a stroke point from its curve, in pixels,
+     *                  at most MAX_CURVE_TOLERANCE; 0 keeps polylines
+     *
+     * Curves are refitted lazily after a change. The polyline stays what hit
+     * testing, erasing, rasterizing and sync work on.
+     */
+    void setCurveFitting(float tolerance);
+
+    /**
+     * @brief Drop pointer samples closer than a distance to the previous point
+     * @param distance Minimum spacing in pixels; 0 keeps every sample
+     */
+    void setMinPointDistance(float distance) {
+        minPointDistance = distance;
+    }
+
+    void setShapeType(ShapeType shape) {
+        currentShape = shape;
+    }
+
+    // The headless build (Node, see CMakeLists.txt) keeps the scene model
+    // but has no canvas: everything that paints is left out of it
+#ifndef WHITEBOARD_HEADLESS
+    /**
+     * @brief Draw the visible scene onto a canvas, one call per vertex
+     * @tparam Canvas Provides the CanvasRenderingContext2D calls used here:
+     *         setTransform, beginPath, strokeStyle, lineWidth, roundCaps, moveTo,
+     *         lineTo, bezierCurveTo, stroke, rect, arc, strokeRect and lineDash
+     *         (0, 0 for a solid line)
+     *
+     * The embind binding drives a browser context through CanvasContext in
+     * wasm/whiteboard.cpp. drawCommands() is the fast path.
+     */
+    template <typename Canvas>
+    void draw(Canvas& canvas) {
+        perf.endFrame();
+        ScopedTimer timer(perf, PerfSection::DRAW);
+        canvas.setTransform(viewScale, 0, 0, viewScale, -viewX * viewScale, -viewY * viewScale);
+
+        // Only elements in view; ids are in draw order
+        queryVisible(queryHits);
+        forEachOfType<Line>(queryHits, [&](Line& line) {
+            const float* xs;
+            const float* ys;
+            uint32_t curveCount = lodLevel == 0 ? lineCurve(line, xs, ys) : 0;
+            uint32_t count = curveCount > 0 ? curveCount : linePoints(line, xs, ys);
+            if (count == 0) return;
+
+            canvas.beginPath();
+            canvas.strokeStyle(colors.name(line.color));
+            canvas.lineWidth(line.thickness);
+            canvas.roundCaps();
+
+            canvas.moveTo(xs[0], ys[0]);
+            if (curveCount > 0) {
+                for (uint32_t i = 1; i + 2 < count; i += 3) {
+                    canvas.bezierCurveTo(xs[i], ys[i], xs[i + 1], ys[i + 1], xs[i + 2], ys[i + 2]);
+                }
+            } else {
+                for (uint32_t i = 1; i < count; i++) {
+                    canvas.lineTo(xs[i], ys[i]);
+                }
+            }
+            canvas.stroke();
+
+            if (line.selected) {
+                canvas.strokeStyle("#0095ff");
+                canvas.lineWidth(line.thickness + 2);
+                canvas.stroke();
+            }
+        });
+
+        // Draw shapes
+        forEachOfType<Shape>(queryHits, [&](const Shape& shape) {
+            canvas.beginPath();
+            canvas.strokeStyle(colors.name(shape.color));
+            canvas.lineWidth(shape.thickness);
+
+            float width = shape.end.x - shape.start.x;
+            float height = shape.end.y - shape.start.y;
+
+            if (shape.type == ShapeType::RECTANGLE) {
+                canvas.rect(shape.start.x, shape.start.y, width, height);
+                canvas.stroke();
+            } else if (shape.type == ShapeType::CIRCLE) {
+                float centerX = shape.start.x + width / 2;
+                float centerY = shape.start.y + height / 2;
+                float radius = std::min(std::abs(width), std::abs(height)) / 2;
+                
+                canvas.beginPath();
+                canvas.arc(centerX, centerY, radius, 0, 2 * M_PI);
+                canvas.stroke();
+            }
+
+            if (shape.selected) {
+                canvas.strokeStyle("#0095ff");
+                canvas.lineWidth(shape.thickness + 2);
+                canvas.stroke();
+            }
+        });
+
+        if (const Line* line = drawingLine()) {
+            if (!predictionXs.empty()) {
+                canvas.beginPath();
+                canvas.strokeStyle(colors.name(line->color));
+                canvas.lineWidth(line->thickness);
+                canvas.roundCaps();
+                canvas.moveTo(predictionXs[0], predictionYs[0]);
+                for (size_t i = 1; i < predictionXs.size(); i++) {
+                    canvas.lineTo(predictionXs[i], predictionYs[i]);
+                }
+                canvas.stroke();
+            }
+        }
+
+        // Draw selection rectangle
+        if (isSelecting) {
+            canvas.beginPath();
+            canvas.strokeStyle("#0095ff");
+            canvas.lineWidth(1);
+            canvas.lineDash(5, 5);
+            canvas.strokeRect(std::min(selectionStart.x, selectionEnd.x), std::min(selectionStart.y, selectionEnd.y),
+                              std::abs(selectionEnd.x - selectionStart.x), std::abs(selectionEnd.y - selectionStart.y));
+            canvas.lineDash(0, 0);
+        }
+    }
+
+    /**
+     * @brief Encode the whole scene into the packed command buffer
+     * @return The commands, replayed by src/lib/commandReplay.ts from a Float32Array view
+     *
+     * Produces the same output as draw(), but with a single boundary crossing
+     * instead of one embind call per vertex.
+     */
+    const CommandBuffer& drawCommands();
+
+    /**
+     * @brief Encode only what changed since the last frame
+     * @return The commands, replayed by src/lib/commandReplay.ts from a Float32Array view
+     *
+     * Clears and clips to the damaged rectangles, then redraws the elements
+     * the spatial grid reports inside them, in normal draw order. The result
+     * is empty (header only) when nothing changed, and a full redraw after
+     * clear() or invalidateAll().
+     */
+    const CommandBuffer& drawDirtyCommands();
+
+#endif // WHITEBOARD_HEADLESS
+
+    /**
+     * @brief Use the tiled raster cache for committed elements
+     *
+     * When enabled, drawDirtyCommands() blits cached tiles and only strokes
+     * live elements (the one being drawn and the selection), which are
+     * painted above committed ones. Requires JavaScript tile support
+     * from CommandReplayer.
+     */
+    void setTileCaching(bool enabled);
+
+    /**
+     * @brief Size of the visible canvas area, repainted on full redraws
+     */
+    void setViewSize(float width, float height);
+
+    /**
+     * @brief Place the camera over the board
+     * @param x Board x shown at the left edge of the canvas
+     * @param y Board y shown at the top edge
+     * @param width Canvas width in pixels
+     * @param height Canvas height in pixels
+     * @param scale Canvas pixels per board unit; above 1 zooms in
+     *
+     * All other coordinates stay in board units. Frames only encode
+     * elements whose bounds in the spatial grid meet the visible area, so
+     * their cost follows what is on screen rather than the board size.
+     * With tile caching on, a pan or zoom repaints from cached tiles.
+     *
+     * Below scale 1, committed strokes are drawn from a simplified level
+     * (see stroke_lod.hpp) and tiles are rasterized at that level's zoom,
+     * so a zoomed-out frame stays about as cheap as a full-size one.
+     */
+    void setViewport(float x, float y, float width, float height, float scale);
+
+    /**
+     * @brief Mark a canvas area for repaint by drawDirtyCommands()
+     *
+     * Used by JavaScript for overlays it draws itself (e.g. the eraser cursor).
+     */
+    void invalidate(float x, float y, float width, float height);
+
+    /**
+     * @brief Force the next drawDirtyCommands() to repaint everything
+     *
+     * Needed whenever the canvas contents were lost, e.g. after a resize.
+     */
+    void invalidateAll() {
+        damage.markAll();
+    }
+
+#ifndef WHITEBOARD_HEADLESS
+    /**
+     * @brief Colors referenced by STROKE_STYLE commands, indexed by palette id
+     */
+    const std::vector<std::string>& getCommandPalette() const {
+        return commands.paletteColors();
+    }
+#endif
+
+    void clear();
+
+    /**
+     * @brief Erase everything under a circle
+     *
+     * Strokes are clipped against the circle and split where it cuts them
+     * (see splitPolylineByCircle()). The first piece keeps the stroke's
+     * id and uid; the others become new strokes, drawn above existing
+     * elements since ids set the draw order. Shapes are removed when their
+     * center is inside the circle. Strokes still being drawn are left alone.
+     */
+    void erase(float x, float y, float radius);
+
+    /**
+     * @brief Make a new committed line of points [from, to) of the erase scratch
+     * @param original Line the points were cut from; the piece takes its style
+     */
+    uint32_t splitOff(uint32_t original, uint32_t from, uint32_t to);
+
+    /**
+     * @brief Undo the newest step; a stroke in progress is finished first
+     * @return false if there was nothing to undo
+     */
+    bool undo();
+
+    /**
+     * @brief Redo the newest undone step
+     * @return false if there was nothing to redo
+     */
+    bool redo();
+
+    /**
+     * @brief Site part of uids created by this client
+     *
+     * Must differ between peers of one room; the wrapper picks a random one.
+     */
+    void setSiteId(uint32_t site);
+
+    uint32_t getSiteId() const {
+        return siteId;
+    }
+
+    bool hasElement(uint64_t uid) const {
+        return findUid(uid) != NO_ELEMENT;
+    }
+
+    /**
+     * @brief Translate one element by uid in O(1)
+     * @return false if no such element exists
+     */
+    bool moveElement(uint64_t uid, float dx, float dy);
+
+    /**
+     * @brief Remove one element by uid in amortized O(1)
+     *
+     * The element leaves the grid immediately; its vector slot is compacted
+     * out in batches.
+     *
+     * @return false if no such element exists
+     */
+    bool removeElement(uint64_t uid);
+
+    /**
+     * @brief Uids of the selected elements, ascending by draw order
+     * @return View valid until the next call
+     */
+    const std::vector<uint64_t>& getSelectedIds();
+
+    bool canUndo() const { return history.canUndo(); }
+    bool canRedo() const { return history.canRedo(); }
+
+    /**
+     * @brief End the current gesture; the next move or erase starts a new undo step
+     */
+    void endHistoryStep() {
+        history.closeStep();
+    }
+
+    /**
+     * @brief Cap the memory used by undo/redo history
+     * @param bytes Upper bound; the oldest steps are dropped beyond it
+     */
+    void setHistoryLimit(uint32_t bytes) {
+        history.setLimit(bytes);
+    }
+
+    uint32_t getHistorySize() const {
+        return static_cast<uint32_t>(history.size());
+    }
+
+    /**
+     * @brief Record local strokes and shapes for takeStrokeBatch()
+     */
+    void setStrokeStreaming(bool enabled);
+
+    /**
+     * @brief Take the local drawing activity since the last call as one binary batch
+     *
+     * Meant to be called once per animation frame while streaming is on.
+     * Layout: u8:version, then records until the end of the buffer
+     * (integers are LEB128 varints, coordinates 1/8 px quantized):
+     *
+     *     BEGIN   u8:1 uid color thickness x y
+     *     POINTS  u8:2 uid count (dx dy)*     deltas continue from the last point sent
+     *     END     u8:3 uid tolerance          receivers simplify with this tolerance
+     *     SHAPE   u8:4 uid u8:type color thickness x0 y0 dx dy
+     *
+     * The uid becomes the element's uid on every receiver.
+     *
+     * @return View of the batch, valid until the next call; empty when nothing happened
+     */
+    const std::vector<uint8_t>& takeStrokeBatch();
+
+    /**
+     * @brief Apply a batch produced by another client's takeStrokeBatch()
+     * @param sender Id of the sending client, for dropRemoteSender()
+     * @param data, size The batch
+     * @return false if the batch is malformed; records before the error are applied
+     */
+    bool applyStrokeBatch(const std::string& sender, const uint8_t* data, size_t size);
+
+    /**
+     * @brief Finish all strokes a client left open, e.g. when it disconnects
+     */
+    void dropRemoteSender(const std::string& sender);
+
+    /**
+     * @brief Start a peer's stroke that is then filled by appendPoints()
+     * @param sender Peer id as for applyStrokeBatch(); dropRemoteSender() finishes its strokes
+     * @return false if the uid is already on the board
+     *
+     * With appendPoints() and finishRemoteStroke() a whole stroke is three
+     * calls from JavaScript however many points it has, e.g. when
+     * replaying history on join.
+     */
+    bool beginRemoteStroke(const std::string& sender, uint64_t uid, const std::string& color,
+                           float thickness, float x, float y);
+
+    /**
+     * @brief Append points to a remote stroke in progress, read in place
+     * @param xy count interleaved x, y pairs, e.g. in a _malloc() buffer JavaScript filled
+     * @return false if no remote stroke with this uid is in progress
+     *
+     * The points are taken as they are; the new part of the stroke is
+     * repainted as one area and the spatial index is updated once.
+     */
+    bool appendPoints(uint64_t uid, const float* xy, size_t count);
+
+    /**
+     * @brief Simplify and commit a remote stroke started with beginRemoteStroke()
+     * @param tolerance Simplification tolerance; 0 keeps every point
+     */
+    bool finishRemoteStroke(uint64_t uid, float tolerance);
+
+    /**
+     * @brief Recolor or resize one element by uid
+     *
+     * Replicated to peers as a last-writer-wins style write; not recorded
+     * in the undo history.
+     *
+     * @return false if no such element exists
+     */
+    bool setElementStyle(uint64_t uid, const std::string& color, float thickness);
+
+    /**
+     * @brief Take the local edits since the last call as replication ops
+     *
+     * Peers merge them with applyRemoteOps() and converge on the same board
+     * whatever order ops arrive in, so a relay does not need to understand
+     * them. Changes are coalesced per element: only the latest value of
+     * each register is sent. Layout: u8:version, then records until the
+     * end of the buffer (integers are LEB128 varints, coordinates 1/8 px
+     * quantized, stamp = counter site):
+     *
+     *     ELEMENT   u8:1 uid addCount stamp* removedCount stamp* u8:hasBody
+     *               [stamp color thickness  stamp ox oy  stamp geometry]
+     *     STYLE     u8:2 uid stamp color thickness
+     *     OFFSET    u8:3 uid stamp ox oy                    total translation
+     *     GEOMETRY  u8:4 uid stamp geometry
+     *
+     * where geometry is `u8:0 count x0 y0 (dx dy)*` for lines and
+     * `u8:type x0 y0 dx dy` for shapes, both without the offset.
+     *
+     * Strokes still being drawn are not included; they stream through
+     * takeStrokeBatch() and are sent here once finished. Send stroke
+     * batches before ops taken at the same time.
+     *
+     * @return View of the ops, valid until the next call; empty when nothing changed
+     */
+    const std::vector<uint8_t>& collectLocalOps();
+
+    /**
+     * @brief Merge ops produced by a peer's collectLocalOps()
+     *
+     * Merged edits are not added to the local undo history and are not
+     * sent back out.
+     *
+     * @param data, size The ops
+     * @return false if the ops are malformed; records before the error are applied
+     */
+    bool applyRemoteOps(const uint8_t* data, size_t size);
+
+    /**
+     * @brief Encode the whole board, replication metadata included, as ops
+     *
+     * One ELEMENT record per element (in draw order) and per tombstone, in
+     * the collectLocalOps() format. Unlike serialize(), a board loaded from
+     * this keeps merging correctly with peers, so it is what a server
+     * holding the authoritative room state hands to joining clients.
+     *
+     * @return View of the ops, valid until the next call
+     */
+    const std::vector<uint8_t>& snapshotOps();
+
+    /**
+     * @brief Replace the board with one produced by snapshotOps()
+     *
+     * Like deserialize(), loading is not an edit: it starts a new history
+     * and nothing is sent to peers.
+     *
+     * @return false if the ops are malformed; records before the error are applied
+     */
+    bool loadOps(const uint8_t* data, size_t size);
+
+    /**
+     * @brief Encode the board in the compact binary scene format
+     *
+     * Layout (version 3, all integers LEB128 varints unless noted):
+     *
+     *     "WBSC" u8:version  quantization
+     *     palette:  count, then length-prefixed color strings
+     *     lines:    count, then per line
+     *                 u8:form uid color thickness pointCount x0 y0 (dx dy)*
+     *     shapes:   count, then per shape
+     *                 u8:type uid color thickness x0 y0 dx dy
+     *
+     * A line's form (LineForm) says what its points are. POLYLINE: the
+     * stroke's points. CURVE: its fitted cubic Béziers as 3n + 1 points
+     * (the start, then two control points and the end of each segment), so
+     * pointCount is at least 4; stored when shorter than the polyline and
+     * kept by the loading board.
+     *
+     * Version 2 is the same without the form byte (every line a polyline),
+     * version 1 also without uids; both are still accepted.
+     *
+     * Coordinates and thicknesses are multiplied by `quantization` and
+     * rounded; coordinates are zigzag deltas from the previous point of the
+     * same element. The palette holds only colors in use. Selection state
+     * is not stored.
+     *
+     * @return View of the encoded bytes, valid until the next serialize()
+     */
+    const std::vector<uint8_t>& serialize();
+
+    /**
+     * @brief Replace the board with a scene produced by serialize()
+     * @param data, size The encoded scene
+     * @return false if the data is not a valid scene; the board is unchanged then
+     */
+    bool deserialize(const uint8_t* data, size_t size);
+
+    /**
+     * @brief Convert the current drawing to SVG elements in one string
+     *
+     * Fine for small boards; large ones should stream with beginSVGExport().
+     */
+    std::string getSVGPaths();
+
+    /**
+     * @brief Start a chunked SVG export of the board
+     * @param decimals Digits kept after the decimal point, at most 4
+     *
+     * Chunks come from nextSVGChunk(), so the export can be spread over
+     * frames. Edits in between are picked up: elements are written in id
+     * order as they are when their chunk is produced, and elements created
+     * after this call are left out.
+     */
+    void beginSVGExport(uint32_t decimals);
+
+    /**
+     * @brief Next chunk of the export started by beginSVGExport()
+     * @param maxBytes Chunks stop at the first element ending past this size
+     * @return UTF-8 markup, valid until the next call; empty once the
+     *         export is complete
+     */
+    const std::vector<uint8_t>& nextSVGChunk(uint32_t maxBytes);
+
+    /**
+     * @brief Helper threads for parallel work, besides the calling thread
+     *
+     * Defaults to one per extra core. Only the pthreads build has threads;
+     * elsewhere this stays 0 and the work runs inline.
+     */
+    void setWorkerThreads(uint32_t count) {
+        pool.setHelpers(count);
+    }
+
+    uint32_t getWorkerThreads() const {
+        return pool.helpers();
+    }
+
+    /**
+     * @brief Render part of the board into an image without a canvas
+     * @param x, y Board point at the top-left pixel
+     * @param scale Pixels per board unit
+     * @param width, height Image size in pixels, each at most MAX_IMAGE_SIDE
+     * @param background CSS hex color behind the elements; anything else is transparent
+     * @param format ImageFormat of the result
+     * @return The image, valid until the next call; empty if the size is
+     *         out of range
+     *
+     * Uses the software rasterizer, so it also works in a worker or in the
+     * headless build. Selection highlights are not drawn. In the pthreads
+     * build, bands of the image and the PNG deflate run on the work pool.
+     */
+    const std::vector<uint8_t>& renderImage(float x, float y, float scale, uint32_t width, uint32_t height,
+                                            const std::string& background, uint32_t format);
+
+    /**
+     * @brief Element counts, memory, per-frame call counts and last timings
+     *
+     * Cheap enough to poll every frame for an overlay.
+     */
+    WhiteboardStats getStats() const;
+
+    /**
+     * @brief Time draws, hit tests, erases, serialization, export and sync
+     *
+     * Off by default; when off the timers read no clock.
+     */
+    void setProfiling(bool enabled) {
+        perf.setEnabled(enabled);
+    }
+
+    /**
+     * @brief Ring of PerfRecorder::CAPACITY timing samples
+     * @return Section, start and duration (ms) of each sample; see
+     *         perf_stats.hpp for how to find the newest
+     */
+    const double* getTimings() const { return perf.samples(); }
+
+    /// Count a call that crossed from JavaScript; the bindings call this for every method
+    void countBoundaryCall() { perf.countCall(); }
+};
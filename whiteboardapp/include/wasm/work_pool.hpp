@@ -0,0 +1,89 @@
+/**
+ * @file work_pool.hpp
+ * @brief Small work-stealing thread pool for data-parallel engine work
+ *
+ * The engine is driven from one thread; the pool only splits a single
+ * loop at a time across helper threads, and the calling thread works too.
+ * Each participant starts on a contiguous share of the chunks and, when it
+ * runs dry, steals from the far end of another's queue, so uneven chunks
+ * (a band full of strokes next to an empty one) still balance.
+ *
+ * Threads exist only in builds with WHITEBOARD_THREADS (the pthreads WASM
+ * variant). Elsewhere parallelFor() runs the whole range inline, so callers
+ * need no second code path.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#ifdef WHITEBOARD_THREADS
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#endif
+
+class WorkPool {
+public:
+    /// Called with a sub-range [begin, end) of the loop
+    using Task = std::function<void(uint32_t begin, uint32_t end)>;
+
+    static constexpr uint32_t MAX_HELPERS = 15;
+
+    /// Starts with one helper per extra core; threads are spawned on first use
+    WorkPool();
+    ~WorkPool();
+
+    WorkPool(const WorkPool&) = delete;
+    WorkPool& operator=(const WorkPool&) = delete;
+
+    /// Helper threads besides the caller, at most MAX_HELPERS; 0 disables threading
+    void setHelpers(uint32_t count);
+    uint32_t helpers() const { return helperCount; }
+
+    /// Threads that work on a parallelFor(), counting the caller
+    uint32_t concurrency() const { return helperCount + 1; }
+
+    /**
+     * @brief Run task over [0, count) and return when all of it is done
+     * @param grain Largest sub-range handed out at once; ranges this small run inline
+     *
+     * Sub-ranges may run concurrently and in any order, so the task must only
+     * write state owned by its indices. A parallelFor() inside a task runs inline.
+     */
+    void parallelFor(uint32_t count, uint32_t grain, const Task& task);
+
+private:
+    uint32_t helperCount = 0;
+
+#ifdef WHITEBOARD_THREADS
+    struct Range {
+        uint32_t begin, end;
+    };
+
+    struct Queue {
+        std::mutex lock;
+        std::deque<Range> ranges;
+    };
+
+    void start();
+    void stop();
+    void helperLoop(uint32_t self);
+    bool take(uint32_t self, Range& range);
+    void drain(uint32_t self);
+
+    std::vector<std::thread> threads;
+    std::vector<std::unique_ptr<Queue>> queues; ///< Index 0 belongs to the caller
+    std::mutex wakeLock;
+    std::condition_variable wake;
+    uint64_t generation = 0;                    ///< Bumped for each parallelFor()
+    bool stopping = false;
+    const Task* current = nullptr;
+    std::atomic<uint32_t> pending{0};           ///< Ranges not yet finished
+#endif
+};
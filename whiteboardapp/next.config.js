@@ -29,20 +29,29 @@ const nextConfig = {
     async headers() {
         return [
             {
-                source: '/wasm/:path*',
+                // Cross-origin isolation exposes SharedArrayBuffer, which the
+                // threaded WASM build needs; without it the loader falls back
+                source: '/:path*',
                 headers: [
                     {
-                        key: 'Content-Type',
-                        value: 'application/wasm',
+                        key: 'Cross-Origin-Opener-Policy',
+                        value: 'same-origin',
+                    },
+                    {
+                        key: 'Cross-Origin-Embedder-Policy',
+                        value: 'require-corp',
                     },
                 ],
             },
             {
-                source: '/wasm/whiteboard.js',
+                // Only the binaries: the loaders beside them (every variant,
+                // debug/ and profile/, pthread workers) keep the JavaScript
+                // type, which module imports require
+                source: '/wasm/:file(.*\\.wasm)',
                 headers: [
                     {
                         key: 'Content-Type',
-                        value: 'application/javascript',
+                        value: 'application/wasm',
                     },
                 ],
             },
@@ -28,7 +28,14 @@ app.prepare().then(() => {
     });
 
     // Initialize Socket.IO server
-    new SocketServer(server);
+    const sockets = new SocketServer(server);
+
+    // Save room state before exiting, so clients rejoining after a deploy only catch up
+    for (const signal of ['SIGTERM', 'SIGINT'] as const) {
+        process.once(signal, () => {
+            sockets.saveRooms().finally(() => process.exit(0));
+        });
+    }
 
     // Start server
     server.listen(port, () => {
@@ -0,0 +1,224 @@
+/**
+ * @file commandReplay.ts
+ * @brief Interpreter for the packed draw command buffer produced by the C++ engine
+ *
+ * The WebAssembly side records a whole frame into a Float32Array
+ * (see include/wasm/command_buffer.hpp). This file replays it onto a
+ * CanvasRenderingContext2D in one tight loop, so a full redraw costs a
+ * single JS/WASM boundary crossing instead of one per vertex.
+ */
+
+/**
+ * @brief Opcodes in the command buffer
+ *
+ * These values must match the C++ DrawOp enum exactly.
+ */
+export enum DrawOp {
+    BEGIN_PATH = 0,
+    POLYLINE = 1,
+    STROKE = 2,
+    STROKE_STYLE = 3,
+    LINE_WIDTH = 4,
+    ROUND_CAPS = 5,
+    RECT = 6,
+    STROKE_RECT = 7,
+    ARC = 8,
+    LINE_DASH = 9,
+    SAVE = 10,
+    RESTORE = 11,
+    CLEAR_RECT = 12,
+    CLIP = 13,
+    CLEAR_CANVAS = 14,
+    TILE_BEGIN = 15,
+    TILE_END = 16,
+    TILE_BLIT = 17,
+    TILE_DROP = 18,
+    TILE_DROP_ALL = 19,
+    VIEW_TRANSFORM = 20,
+    BEZIER = 21
+}
+
+export type Context2D = CanvasRenderingContext2D | OffscreenCanvasRenderingContext2D;
+type TileCanvas = HTMLCanvasElement | OffscreenCanvas;
+
+/**
+ * @brief Create a tile-sized canvas, preferring OffscreenCanvas
+ */
+function createTileCanvas(size: number): TileCanvas {
+    if (typeof OffscreenCanvas !== 'undefined') {
+        return new OffscreenCanvas(size, size);
+    }
+    const canvas = document.createElement('canvas');
+    canvas.width = size;
+    canvas.height = size;
+    return canvas;
+}
+
+/**
+ * @brief Replays command buffers and caches the engine's color palette
+ *
+ * The first float of every buffer is the palette revision. The palette is
+ * only fetched from WebAssembly again when that revision changes.
+ *
+ * It also owns the raster tiles of the engine's tile cache: TILE_BEGIN
+ * redirects drawing into a tile canvas until TILE_END, and TILE_BLIT
+ * copies a tile onto the visible canvas.
+ */
+export class CommandReplayer {
+    private palette: string[] = [];
+    private paletteRevision = -1;
+    private tiles = new Map<string, TileCanvas>();
+
+    /**
+     * @brief Replay a frame onto the canvas
+     * @param main Target canvas context; an OffscreenCanvas one when the engine runs in a worker
+     * @param commands Float32Array view returned by Whiteboard.drawCommands()
+     * @param getPalette Fetches the color palette when it is out of date
+     */
+    replay(
+        main: Context2D,
+        commands: Float32Array,
+        getPalette: () => string[]
+    ): void {
+        if (commands.length === 0) return;
+        let ctx: Context2D = main;
+
+        const revision = commands[0];
+        if (revision !== this.paletteRevision) {
+            this.palette = getPalette();
+            this.paletteRevision = revision;
+        }
+
+        const palette = this.palette;
+        const end = commands.length;
+        let i = 1;
+
+        while (i < end) {
+            switch (commands[i++]) {
+                case DrawOp.BEGIN_PATH:
+                    ctx.beginPath();
+                    break;
+                case DrawOp.POLYLINE: {
+                    const count = commands[i++];
+                    const stop = i + count * 2;
+                    ctx.moveTo(commands[i], commands[i + 1]);
+                    for (i += 2; i < stop; i += 2) {
+                        ctx.lineTo(commands[i], commands[i + 1]);
+                    }
+                    break;
+                }
+                case DrawOp.BEZIER: {
+                    const stop = i + 1 + commands[i] * 6 + 2;
+                    ctx.moveTo(commands[i + 1], commands[i + 2]);
+                    for (i += 3; i < stop; i += 6) {
+                        ctx.bezierCurveTo(commands[i], commands[i + 1], commands[i + 2],
+                            commands[i + 3], commands[i + 4], commands[i + 5]);
+                    }
+                    break;
+                }
+                case DrawOp.STROKE:
+                    ctx.stroke();
+                    break;
+                case DrawOp.STROKE_STYLE:
+                    ctx.strokeStyle = palette[commands[i++]];
+                    break;
+                case DrawOp.LINE_WIDTH:
+                    ctx.lineWidth = commands[i++];
+                    break;
+                case DrawOp.ROUND_CAPS:
+                    ctx.lineCap = 'round';
+                    ctx.lineJoin = 'round';
+                    break;
+                case DrawOp.RECT:
+                    ctx.rect(commands[i], commands[i + 1], commands[i + 2], commands[i + 3]);
+                    i += 4;
+                    break;
+                case DrawOp.STROKE_RECT:
+                    ctx.strokeRect(commands[i], commands[i + 1], commands[i + 2], commands[i + 3]);
+                    i += 4;
+                    break;
+                case DrawOp.ARC:
+                    ctx.arc(commands[i], commands[i + 1], commands[i + 2], commands[i + 3], commands[i + 4]);
+                    i += 5;
+                    break;
+                case DrawOp.LINE_DASH: {
+                    const on = commands[i];
+                    const off = commands[i + 1];
+                    ctx.setLineDash(on === 0 && off === 0 ? [] : [on, off]);
+                    i += 2;
+                    break;
+                }
+                case DrawOp.SAVE:
+                    ctx.save();
+                    break;
+                case DrawOp.RESTORE:
+                    ctx.restore();
+                    break;
+                case DrawOp.CLEAR_RECT:
+                    ctx.clearRect(commands[i], commands[i + 1], commands[i + 2], commands[i + 3]);
+                    i += 4;
+                    break;
+                case DrawOp.CLIP:
+                    ctx.clip();
+                    break;
+                case DrawOp.CLEAR_CANVAS:
+                    ctx.save();
+                    ctx.setTransform(1, 0, 0, 1, 0, 0);
+                    ctx.clearRect(0, 0, ctx.canvas.width, ctx.canvas.height);
+                    ctx.restore();
+                    break;
+                case DrawOp.TILE_BEGIN: {
+                    const tx = commands[i];
+                    const ty = commands[i + 1];
+                    const size = commands[i + 2];
+                    const zoom = commands[i + 3];
+                    i += 4;
+
+                    // A zoom change drops every tile first, so keys never mix zooms
+                    const key = `${tx},${ty}`;
+                    let tile = this.tiles.get(key);
+                    if (!tile) {
+                        tile = createTileCanvas(Math.round(size * zoom));
+                        this.tiles.set(key, tile);
+                    }
+                    const tileContext = tile.getContext('2d') as Context2D | null;
+                    if (!tileContext) throw new Error('Could not get tile context');
+
+                    // Draw in board coordinates; the tile sees only its own square
+                    tileContext.setTransform(zoom, 0, 0, zoom, -tx * size * zoom, -ty * size * zoom);
+                    tileContext.clearRect(tx * size, ty * size, size, size);
+                    ctx = tileContext;
+                    break;
+                }
+                case DrawOp.TILE_END:
+                    ctx = main;
+                    break;
+                case DrawOp.TILE_BLIT: {
+                    const tx = commands[i];
+                    const ty = commands[i + 1];
+                    const size = commands[i + 2];
+                    i += 3;
+                    const tile = this.tiles.get(`${tx},${ty}`);
+                    if (tile) main.drawImage(tile, tx * size, ty * size, size, size);
+                    break;
+                }
+                case DrawOp.TILE_DROP:
+                    this.tiles.delete(`${commands[i]},${commands[i + 1]}`);
+                    i += 2;
+                    break;
+                case DrawOp.TILE_DROP_ALL:
+                    this.tiles.clear();
+                    break;
+                case DrawOp.VIEW_TRANSFORM: {
+                    // Board coordinates onward; tiles keep their own transform
+                    const scale = commands[i];
+                    main.setTransform(scale, 0, 0, scale, -commands[i + 1] * scale, -commands[i + 2] * scale);
+                    i += 3;
+                    break;
+                }
+                default:
+                    throw new Error(`Unknown draw opcode ${commands[i - 1]} at offset ${i - 1}`);
+            }
+        }
+    }
+}
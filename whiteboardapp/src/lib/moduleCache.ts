@@ -0,0 +1,156 @@
+/**
+ * @file moduleCache.ts
+ * @brief Compile the engine's .wasm once and reuse it across page loads
+ *
+ * The module is compiled while the bytes download (compileStreaming),
+ * started at once; meanwhile a HEAD request reads the file's ETag or
+ * Last-Modified. If IndexedDB holds a module of that version under the
+ * URL, the download is aborted and the stored module used. Otherwise the
+ * compiled one is stored, so a new deploy is compiled again.
+ *
+ * Browsers that refuse to store modules (a DataCloneError on put, as in
+ * current Chrome and Firefox) are remembered in the database: later loads
+ * skip the HEAD request and just stream, relying on the browser's own
+ * HTTP code cache.
+ */
+
+const DB_NAME = 'whiteboard-wasm';
+const STORE = 'modules';
+const NO_MODULES_KEY = '#no-modules'; // Set once storing a module failed
+
+interface CachedModule {
+    version: string;
+    module: WebAssembly.Module;
+}
+
+function request<T>(req: IDBRequest<T>): Promise<T> {
+    return new Promise((resolve, reject) => {
+        req.onsuccess = () => resolve(req.result);
+        req.onerror = () => reject(req.error);
+    });
+}
+
+let database: Promise<IDBDatabase | null> | null = null;
+
+function openCache(): Promise<IDBDatabase | null> {
+    if (!database) {
+        database = new Promise(resolve => {
+            if (typeof indexedDB === 'undefined') {
+                resolve(null);
+                return;
+            }
+            const open = indexedDB.open(DB_NAME, 1);
+            open.onupgradeneeded = () => open.result.createObjectStore(STORE);
+            open.onsuccess = () => resolve(open.result);
+            // Private browsing and blocked storage: run without the cache
+            open.onerror = () => resolve(null);
+        });
+    }
+    return database;
+}
+
+/**
+ * @brief Version tag of the file at a URL, without downloading it
+ * @returns null when the server gives no validator; the module is not cached then
+ */
+async function remoteVersion(url: string): Promise<string | null> {
+    try {
+        const response = await fetch(url, { method: 'HEAD', cache: 'no-cache' });
+        if (!response.ok) return null;
+        return response.headers.get('ETag') ?? response.headers.get('Last-Modified');
+    } catch {
+        return null;
+    }
+}
+
+/**
+ * @brief False once this browser failed to store a module, or without a readable cache
+ */
+async function storesModules(db: IDBDatabase): Promise<boolean> {
+    try {
+        const flag = await request(db.transaction(STORE, 'readonly').objectStore(STORE).get(NO_MODULES_KEY));
+        return flag !== true;
+    } catch {
+        return false;
+    }
+}
+
+function storeModule(db: IDBDatabase, url: string, version: string, module: WebAssembly.Module) {
+    // Only a DataCloneError means modules cannot be stored; quota errors may pass
+    const failed = (error: unknown) => {
+        if (!(error instanceof DOMException) || error.name !== 'DataCloneError') return;
+        try {
+            db.transaction(STORE, 'readwrite').objectStore(STORE).put(true, NO_MODULES_KEY);
+        } catch {
+            // Storage went away; the next load tries again
+        }
+    };
+    try {
+        const entry: CachedModule = { version, module };
+        request(db.transaction(STORE, 'readwrite').objectStore(STORE).put(entry, url)).catch(failed);
+    } catch (error) {
+        failed(error);
+    }
+}
+
+async function compileModule(url: string, signal: AbortSignal): Promise<WebAssembly.Module> {
+    if (typeof WebAssembly.compileStreaming === 'function') {
+        try {
+            return await WebAssembly.compileStreaming(fetch(url, { signal }));
+        } catch (error) {
+            if (signal.aborted) throw error;
+            // Served without the application/wasm type; compile from the bytes below
+            console.warn('Streaming WebAssembly compilation failed, falling back:', error);
+        }
+    }
+    const bytes = await (await fetch(url, { signal })).arrayBuffer();
+    return WebAssembly.compile(bytes);
+}
+
+async function compileAndInstantiate(url: string, imports: WebAssembly.Imports): Promise<WebAssembly.WebAssemblyInstantiatedSource> {
+    if (typeof WebAssembly.instantiateStreaming === 'function') {
+        try {
+            return await WebAssembly.instantiateStreaming(fetch(url), imports);
+        } catch (error) {
+            // Served without the application/wasm type; compile from the bytes below
+            console.warn('Streaming WebAssembly compilation failed, falling back:', error);
+        }
+    }
+    const bytes = await (await fetch(url)).arrayBuffer();
+    return WebAssembly.instantiate(bytes, imports);
+}
+
+/**
+ * @brief Instantiate a .wasm, from the compiled-module cache when it is current
+ */
+export async function instantiateCached(url: string, imports: WebAssembly.Imports): Promise<WebAssembly.WebAssemblyInstantiatedSource> {
+    const db = await openCache();
+    if (!db || !(await storesModules(db))) return compileAndInstantiate(url, imports);
+
+    // Compile from the network at once; the version check runs alongside
+    const download = new AbortController();
+    const compiling = compileModule(url, download.signal);
+    compiling.catch(() => {}); // Rejects when aborted after a cache hit
+    const version = await remoteVersion(url);
+
+    let module: WebAssembly.Module | null = null;
+    if (version) {
+        try {
+            const cached = await request<CachedModule | undefined>(
+                db.transaction(STORE, 'readonly').objectStore(STORE).get(url));
+            if (cached && cached.version === version) {
+                module = cached.module;
+                download.abort();
+            }
+        } catch (error) {
+            console.warn('Ignoring unreadable WebAssembly module cache:', error);
+        }
+    }
+    if (!module) {
+        module = await compiling;
+        // Not awaited: the engine can start while the module is written
+        if (version) storeModule(db, url, version, module);
+    }
+    const instance = await WebAssembly.instantiate(module, imports);
+    return { module, instance };
+}
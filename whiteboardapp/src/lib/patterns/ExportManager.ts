@@ -3,8 +3,42 @@
  * @brief Export management system using the Factory pattern
  */
 
+import { ImageFormat, RenderRequest } from '../workers/rasterProtocol';
+
 export interface ExportStrategy {
-    export(canvas: HTMLCanvasElement, isDarkMode: boolean): void;
+    export(canvas: HTMLCanvasElement, isDarkMode: boolean): void | Promise<void>;
+}
+
+/**
+ * @brief Chunked SVG markup, e.g. the WhiteboardWrapper
+ */
+export interface SVGSource {
+    beginSVGExport(decimals?: number): void;
+    nextSVGChunk(): Uint8Array | null; // null once the export is complete
+}
+
+/**
+ * @brief Software-rendered board images, e.g. the WhiteboardWrapper
+ */
+export interface ImageSource {
+    renderImageInWorker(request: RenderRequest): Promise<Uint8Array>;
+    getViewport(): { x: number; y: number; scale: number };
+}
+
+// Time spent producing chunks before yielding to the event loop
+const SVG_SLICE_MS = 8;
+
+// setTimeout rather than requestAnimationFrame so this also works in a worker
+function yieldToEventLoop(): Promise<void> {
+    return new Promise(resolve => setTimeout(resolve, 0));
+}
+
+function download(filename: string, blob: Blob): void {
+    const link = document.createElement('a');
+    link.download = filename;
+    link.href = URL.createObjectURL(blob);
+    link.click();
+    URL.revokeObjectURL(link.href);
 }
 
 class PNGExporter implements ExportStrategy {
@@ -32,53 +66,80 @@ class PNGExporter implements ExportStrategy {
     }
 }
 
+/**
+ * @brief Renders the visible area in the engine's worker rasterizer
+ *
+ * Unlike PNGExporter it does not read back the canvas, so it exports at any
+ * resolution (scale > 1 for print quality) and leaves the page responsive.
+ */
+class RasterPNGExporter implements ExportStrategy {
+    constructor(private source: ImageSource, private resolution = 1) {}
+
+    async export(canvas: HTMLCanvasElement, isDarkMode: boolean): Promise<void> {
+        const view = this.source.getViewport();
+        const png = await this.source.renderImageInWorker({
+            x: view.x,
+            y: view.y,
+            scale: view.scale * this.resolution,
+            width: Math.round(canvas.width * this.resolution),
+            height: Math.round(canvas.height * this.resolution),
+            background: isDarkMode ? '#1a1a1a' : '#ffffff',
+            format: ImageFormat.PNG
+        });
+        if (png.length === 0) return;
+        download('whiteboard.png', new Blob([png], { type: 'image/png' }));
+    }
+}
+
+/**
+ * @brief Streams the engine's SVG chunks into a Blob
+ *
+ * Chunks are produced a few milliseconds at a time, so a big board does not
+ * freeze the tab, and the markup never exists as one JS string or DOM tree.
+ */
 class SVGExporter implements ExportStrategy {
-    constructor(private getSVGContent: () => string) {}
+    constructor(private source: SVGSource) {}
 
-    export(canvas: HTMLCanvasElement, isDarkMode: boolean): void {
-        // Create SVG element
-        const svg = document.createElementNS('http://www.w3.org/2000/svg', 'svg');
-        svg.setAttribute('width', canvas.width.toString());
-        svg.setAttribute('height', canvas.height.toString());
-        svg.setAttribute('xmlns', 'http://www.w3.org/2000/svg');
-        
-        // Add background rectangle
-        const background = document.createElementNS('http://www.w3.org/2000/svg', 'rect');
-        background.setAttribute('width', '100%');
-        background.setAttribute('height', '100%');
-        background.setAttribute('fill', isDarkMode ? '#1a1a1a' : '#ffffff');
-        svg.appendChild(background);
-        
-        // Get SVG content from the whiteboard
-        const svgContent = this.getSVGContent();
-        if (svgContent) {
-            svg.innerHTML += svgContent;
+    async export(canvas: HTMLCanvasElement, isDarkMode: boolean): Promise<void> {
+        const background = isDarkMode ? '#1a1a1a' : '#ffffff';
+        const parts: BlobPart[] = [
+            `<svg xmlns="http://www.w3.org/2000/svg" width="${canvas.width}" height="${canvas.height}">`,
+            `<rect width="100%" height="100%" fill="${background}"/>`
+        ];
+
+        this.source.beginSVGExport();
+        let sliceStart = performance.now();
+        for (let chunk = this.source.nextSVGChunk(); chunk; chunk = this.source.nextSVGChunk()) {
+            parts.push(chunk);
+            if (performance.now() - sliceStart > SVG_SLICE_MS) {
+                await yieldToEventLoop();
+                sliceStart = performance.now();
+            }
         }
-        
-        // Create download link
-        const svgBlob = new Blob([svg.outerHTML], { type: 'image/svg+xml' });
-        const link = document.createElement('a');
-        link.download = 'whiteboard.svg';
-        link.href = URL.createObjectURL(svgBlob);
-        link.click();
-        URL.revokeObjectURL(link.href);
+        parts.push('</svg>');
+
+        download('whiteboard.svg', new Blob(parts, { type: 'image/svg+xml' }));
     }
 }
 
 export class ExportManager {
     private exporters: Map<string, ExportStrategy>;
 
-    constructor(getSVGContent: () => string) {
-        this.exporters = new Map([
-            ['png', new PNGExporter()],
-            ['svg', new SVGExporter(getSVGContent)]
+    /**
+     * @param imageSource When given, PNGs are rendered by the engine in a
+     *                    worker instead of read back from the canvas
+     */
+    constructor(svgSource: SVGSource, imageSource?: ImageSource) {
+        this.exporters = new Map<string, ExportStrategy>([
+            ['png', imageSource ? new RasterPNGExporter(imageSource) : new PNGExporter()],
+            ['svg', new SVGExporter(svgSource)]
         ]);
     }
 
-    export(format: string, canvas: HTMLCanvasElement, isDarkMode: boolean): void {
+    async export(format: string, canvas: HTMLCanvasElement, isDarkMode: boolean): Promise<void> {
         const exporter = this.exporters.get(format.toLowerCase());
         if (exporter) {
-            exporter.export(canvas, isDarkMode);
+            await exporter.export(canvas, isDarkMode);
         } else {
             throw new Error(`Unsupported export format: ${format}`);
         }
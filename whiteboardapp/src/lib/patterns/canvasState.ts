@@ -4,6 +4,7 @@
  */
 
 import { SocketClient } from '../socket/client';
+import { WhiteboardWrapper } from '../whiteboard';
 
 export interface CanvasObserver {
     update(state: string): void;
@@ -108,4 +109,25 @@ export class CanvasStateSync {
     cleanup(): void {
         this.stateManager.removeObserver(this.socketObserver);
     }
-} 
\ No newline at end of file
+}
+
+/**
+ * @brief Syncs room state as a binary vector scene instead of a PNG
+ *
+ * The scene comes from the WebAssembly engine, stays editable after load
+ * and is typically a few KB. The server stores the latest scene per room
+ * and sends it on join, so no peer has to be online to answer.
+ */
+export class SceneStateSync {
+    constructor(private socketClient: SocketClient, private whiteboard: WhiteboardWrapper) {
+        socketClient.onSceneState(data => {
+            if (!this.whiteboard.loadScene(data.scene)) {
+                console.warn('Ignoring invalid scene state for room', data.roomId);
+            }
+        });
+    }
+
+    saveState(): void {
+        this.socketClient.updateSceneState(this.whiteboard.serializeScene());
+    }
+}
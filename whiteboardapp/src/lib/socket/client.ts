@@ -1,9 +1,10 @@
 import { io, Socket } from 'socket.io-client';
-import { DrawEvent, RoomEvent, ChatEvent, DrawEventData, ChatEventData, RoomEventData, UserListData, CanvasStateData } from './events';
+import { DrawEvent, RoomEvent, ChatEvent, DrawEventData, ChatEventData, RoomEventData, UserListData, CanvasStateData, SceneStateData, StrokeBatchData, OpsData, OpsSnapshotData, OpsCatchUpData, RoomPosition } from './events';
 
 export class SocketClient {
     private socket: Socket;
     private roomId: string | null = null;
+    private position: RoomPosition | null = null; // Last op log position applied in the room
 
     constructor() {
         this.socket = io('http://localhost:3000', {
@@ -11,6 +12,20 @@ export class SocketClient {
         });
 
         this.setupEventHandlers();
+        // The server forgets a dropped socket's rooms; rejoin, fetching only what was missed
+        this.socket.io.on('reconnect', () => {
+            if (this.roomId) this.socket.emit(RoomEvent.JOIN_ROOM, this.roomId, this.position ?? undefined);
+        });
+    }
+
+    /**
+     * @brief Remember the newest position seen, so a rejoin can resume from it
+     */
+    private track(position: RoomPosition | undefined) {
+        if (!position) return;
+        if (!this.position || position.epoch !== this.position.epoch || position.seq > this.position.seq) {
+            this.position = position;
+        }
     }
 
     get id(): string {
@@ -41,8 +56,9 @@ export class SocketClient {
 
     // Room methods
     joinRoom(roomId: string) {
+        if (roomId !== this.roomId) this.position = null;
         this.roomId = roomId;
-        this.socket.emit(RoomEvent.JOIN_ROOM, roomId);
+        this.socket.emit(RoomEvent.JOIN_ROOM, roomId, this.position ?? undefined);
     }
 
     leaveRoom() {
@@ -68,6 +84,17 @@ export class SocketClient {
         this.socket.emit(DrawEvent.END, { ...data, roomId: this.roomId });
     }
 
+    sendStrokeBatch(batch: Uint8Array) {
+        if (!this.roomId) return;
+        this.socket.emit(DrawEvent.STROKE_BATCH, { roomId: this.roomId, batch });
+    }
+
+    sendOps(ops: Uint8Array) {
+        if (!this.roomId) return;
+        // The acknowledgement carries the batch's position in the room's log
+        this.socket.emit(DrawEvent.OPS, { roomId: this.roomId, ops }, (position: RoomPosition) => this.track(position));
+    }
+
     clearCanvas() {
         if (!this.roomId) return;
         this.socket.emit(DrawEvent.CLEAR, this.roomId);
@@ -87,6 +114,14 @@ export class SocketClient {
         });
     }
 
+    updateSceneState(scene: Uint8Array) {
+        if (!this.roomId) return;
+        this.socket.emit(DrawEvent.SCENE_STATE, {
+            roomId: this.roomId,
+            scene
+        });
+    }
+
     // Chat methods
     sendMessage(message: string) {
         if (!this.roomId) return;
@@ -109,6 +144,42 @@ export class SocketClient {
         this.socket.on(DrawEvent.END, callback);
     }
 
+    onStrokeBatch(callback: (data: StrokeBatchData) => void) {
+        this.socket.on(DrawEvent.STROKE_BATCH, (data: StrokeBatchData) => {
+            // socket.io delivers binary attachments as ArrayBuffer in browsers
+            const batch = data.batch instanceof Uint8Array ? data.batch : new Uint8Array(data.batch);
+            callback({ ...data, batch });
+        });
+    }
+
+    onOps(callback: (data: OpsData) => void) {
+        this.socket.on(DrawEvent.OPS, (data: OpsData) => {
+            const ops = data.ops instanceof Uint8Array ? data.ops : new Uint8Array(data.ops);
+            callback({ ...data, ops });
+            this.track(data.position);
+        });
+    }
+
+    onOpsSnapshot(callback: (data: OpsSnapshotData) => void) {
+        this.socket.on(DrawEvent.OPS_SNAPSHOT, (data: OpsSnapshotData) => {
+            const ops = data.ops instanceof Uint8Array ? data.ops : new Uint8Array(data.ops);
+            callback({ ...data, ops });
+            // A snapshot replaces the board, so it also replaces the position
+            if (data.position) this.position = data.position;
+        });
+    }
+
+    /**
+     * @brief Batches missed while disconnected; merge each with Whiteboard.applyRemoteOps()
+     */
+    onOpsCatchUp(callback: (data: OpsCatchUpData) => void) {
+        this.socket.on(DrawEvent.OPS_CATCH_UP, (data: OpsCatchUpData) => {
+            const batches = data.batches.map(batch => batch instanceof Uint8Array ? batch : new Uint8Array(batch));
+            callback({ ...data, batches });
+            this.position = data.position;
+        });
+    }
+
     onClear(callback: () => void) {
         this.socket.on(DrawEvent.CLEAR, callback);
     }
@@ -121,6 +192,14 @@ export class SocketClient {
         this.socket.on(DrawEvent.CANVAS_STATE_UPDATE, callback);
     }
 
+    onSceneState(callback: (data: SceneStateData) => void) {
+        this.socket.on(DrawEvent.SCENE_STATE, (data: SceneStateData) => {
+            // socket.io delivers binary attachments as ArrayBuffer in browsers
+            const scene = data.scene instanceof Uint8Array ? data.scene : new Uint8Array(data.scene);
+            callback({ roomId: data.roomId, scene });
+        });
+    }
+
     onUserJoined(callback: (data: RoomEventData) => void) {
         this.socket.on(RoomEvent.USER_JOINED, callback);
     }
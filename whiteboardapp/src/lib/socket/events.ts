@@ -5,7 +5,12 @@ export enum DrawEvent {
     CLEAR = 'draw:clear',
     SHAPE_ADDED = 'draw:shape_added',
     REQUEST_CANVAS_STATE = 'draw:request_state',
-    CANVAS_STATE_UPDATE = 'draw:state_update'
+    CANVAS_STATE_UPDATE = 'draw:state_update',
+    SCENE_STATE = 'draw:scene_state',
+    STROKE_BATCH = 'draw:stroke_batch',
+    OPS = 'draw:ops',
+    OPS_SNAPSHOT = 'draw:ops_snapshot',
+    OPS_CATCH_UP = 'draw:ops_catch_up'
 }
 
 export enum RoomEvent {
@@ -31,11 +36,89 @@ export interface DrawEventData {
     shape?: string;
 }
 
+/**
+ * @deprecated Raster snapshot; only used when no SceneStateData is available
+ */
 export interface CanvasStateData {
     roomId: string;
     imageData: string; // base64 encoded canvas state
 }
 
+/**
+ * @brief Room state as a binary vector scene (Whiteboard.serialize())
+ *
+ * Sent as a socket.io binary attachment. The server keeps the latest one
+ * per room and sends it to users as they join.
+ */
+export interface SceneStateData {
+    roomId: string;
+    scene: Uint8Array;
+}
+
+/**
+ * @brief One animation frame of a client's drawing (Whiteboard.takeStrokeBatch())
+ *
+ * Replaces per-sample DrawEventData for clients running the WASM engine.
+ * The server fills in userId before relaying.
+ */
+export interface StrokeBatchData {
+    roomId: string;
+    userId?: string;
+    batch: Uint8Array;
+}
+
+/**
+ * @brief Position in a room's op log
+ *
+ * The server numbers every ops batch it relays. epoch identifies one log:
+ * it changes when the server starts a room from nothing, so seqs from
+ * before are not mistaken for the new log's. A client sends the last
+ * position it applied when it joins, to get only what it missed.
+ */
+export interface RoomPosition {
+    epoch: number;
+    seq: number;
+}
+
+/**
+ * @brief Merged edits of one client (Whiteboard.collectLocalOps())
+ *
+ * CRDT ops: any client can apply them in any order and still converge,
+ * so the server relays them without decoding. The server fills in userId
+ * and the batch's position before relaying, and acknowledges the sender
+ * with the position.
+ */
+export interface OpsData {
+    roomId: string;
+    userId?: string;
+    ops: Uint8Array;
+    position?: RoomPosition;
+}
+
+/**
+ * @brief Whole room state from the server (Whiteboard.snapshotOps())
+ *
+ * Sent to joining users when the server holds the room state in its
+ * headless engine; replaces SceneStateData and the peer round-trip.
+ */
+export interface OpsSnapshotData {
+    roomId: string;
+    ops: Uint8Array;
+    position?: RoomPosition; // The last batch the snapshot includes
+}
+
+/**
+ * @brief The ops batches a rejoining client missed, in order
+ *
+ * Sent instead of a snapshot when the client's last position is still in
+ * the server's op tail; empty when the client is up to date.
+ */
+export interface OpsCatchUpData {
+    roomId: string;
+    batches: Uint8Array[];
+    position: RoomPosition; // Of the last batch
+}
+
 export interface ChatEventData {
     roomId: string;
     userId: string;
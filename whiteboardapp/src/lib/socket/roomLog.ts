@@ -0,0 +1,255 @@
+/**
+ * @file roomLog.ts
+ * @brief Numbered op log of each room, compacted into snapshots on disk
+ *
+ * Every relayed ops batch gets the next seq of its room and joins a
+ * bounded tail. A client that rejoins with its last position (RoomPosition)
+ * gets the batches after it from the tail, usually a few and often none,
+ * instead of the whole room.
+ *
+ * Every COMPACT_EVERY batches, when a room empties and when the server
+ * stops, the room's merged state (RoomScenes) is written to disk with its
+ * position. A cold room, e.g. after a deploy, starts from that snapshot,
+ * so clients that were up to date need nothing at all.
+ *
+ * That holds only for a snapshot saved when the room closed or the server
+ * stopped cleanly (FINAL). Any other snapshot may be older than batches
+ * the server numbered before it died, which clients already hold; a room
+ * restored from one starts a new epoch, so rejoining clients merge the
+ * snapshot instead of trusting their position.
+ *
+ * Snapshots need the headless engine. Without it the tail still serves
+ * catch-up for as long as the server runs.
+ */
+
+import * as fs from 'fs';
+import * as path from 'path';
+import { randomInt } from 'crypto';
+import { RoomScenes } from './roomScenes';
+import { RoomPosition } from './events';
+
+const MAX_TAIL_BATCHES = 1024;           // Batches kept for catch-up, per room
+const MAX_TAIL_BYTES = 1 << 20;
+const COMPACT_EVERY = 256;               // Batches between snapshots written to disk
+const LARGE_CATCH_UP_BYTES = 64 * 1024;  // Above this, send the snapshot if it is smaller
+const SNAPSHOT_MAGIC = 0x32524257;       // "WBR2"
+const HEADER_BYTES = 20;                 // u32 magic, u32 epoch, f64 seq, u32 flags; then snapshotOps()
+const FINAL = 1;                         // Flag: saved on close or shutdown, nothing numbered after it
+const OLD_SNAPSHOT_MAGIC = 0x53524257;   // "WBRS": as above without flags, never FINAL
+const OLD_HEADER_BYTES = 16;
+
+// WHITEBOARD_ROOM_DIR moves the snapshots, e.g. to a persistent volume
+const ROOM_DIR = process.env.WHITEBOARD_ROOM_DIR ?? path.join(process.cwd(), 'server', 'rooms');
+
+interface RoomHistory {
+    epoch: number;
+    seq: number;             // Of the newest batch; 0 before the first
+    tail: Uint8Array[];      // Batches tailSeq + 1 to seq
+    tailSeq: number;
+    tailBytes: number;
+    snapshotSeq: number;     // Position of the last snapshot written
+}
+
+/**
+ * @brief What a joining client needs to be current
+ *
+ * 'batches' are merged with Whiteboard.applyRemoteOps(), on top of what
+ * the client has; a 'snapshot' replaces its board (Whiteboard.loadOps()).
+ */
+export type CatchUp =
+    | { kind: 'batches'; batches: Uint8Array[]; position: RoomPosition }
+    | { kind: 'snapshot'; ops: Uint8Array; position: RoomPosition };
+
+export class RoomLog {
+    private rooms: Map<string, RoomHistory> = new Map();
+    private unwritten: Map<string, Uint8Array> = new Map(); // roomId -> newest snapshot file not on disk yet
+    private writes: Map<string, Promise<void>> = new Map(); // roomId -> pending write
+
+    constructor(private scenes: RoomScenes, private directory = ROOM_DIR) {}
+
+    /**
+     * @brief Number a relayed ops batch and merge it into the room
+     * @returns The batch's position, for the sender and the peers it is relayed to
+     */
+    append(roomId: string, ops: Uint8Array): RoomPosition {
+        const room = this.open(roomId);
+        this.scenes.apply(roomId, ops);
+        room.seq++;
+        room.tail.push(ops);
+        room.tailBytes += ops.byteLength;
+        while (room.tail.length > MAX_TAIL_BATCHES || room.tailBytes > MAX_TAIL_BYTES) {
+            room.tailBytes -= room.tail.shift()!.byteLength;
+            room.tailSeq++;
+        }
+        if (room.seq - room.snapshotSeq >= COMPACT_EVERY) this.compact(roomId, room, false);
+        return { epoch: room.epoch, seq: room.seq };
+    }
+
+    /**
+     * @brief The state a client joining at a position is missing
+     * @param since Last position the client applied; none for a first join
+     * @returns null if the server has no state for the room
+     *
+     * A rejoining client always gets batches: the tail after its position,
+     * or the snapshot as one batch when that is smaller or its position is
+     * gone (another epoch, or trimmed from the tail). Merging keeps any
+     * edits the server never received.
+     */
+    catchUp(roomId: string, since?: RoomPosition): CatchUp | null {
+        const room = this.open(roomId);
+        const position = { epoch: room.epoch, seq: room.seq };
+
+        if (since && since.epoch === room.epoch && since.seq >= room.tailSeq && since.seq <= room.seq) {
+            const batches = room.tail.slice(since.seq - room.tailSeq);
+            const bytes = batches.reduce((total, batch) => total + batch.byteLength, 0);
+            if (bytes > LARGE_CATCH_UP_BYTES) {
+                const snapshot = this.scenes.snapshot(roomId);
+                if (snapshot && snapshot.byteLength < bytes) return { kind: 'batches', batches: [snapshot], position };
+            }
+            return { kind: 'batches', batches, position };
+        }
+
+        const snapshot = this.scenes.snapshot(roomId);
+        if (!snapshot) return null;
+        return since ? { kind: 'batches', batches: [snapshot], position } : { kind: 'snapshot', ops: snapshot, position };
+    }
+
+    /**
+     * @brief Save a room and free it, e.g. when its last user leaves
+     */
+    close(roomId: string) {
+        const room = this.rooms.get(roomId);
+        if (!room) return;
+        this.compact(roomId, room, true);
+        this.rooms.delete(roomId);
+        this.scenes.drop(roomId);
+    }
+
+    /**
+     * @brief Save every open room, e.g. before the server exits
+     */
+    async saveAll(): Promise<void> {
+        this.rooms.forEach((room, roomId) => this.compact(roomId, room, true));
+        await Promise.all(Array.from(this.writes.values()));
+    }
+
+    private open(roomId: string): RoomHistory {
+        let room = this.rooms.get(roomId);
+        if (!room) {
+            room = this.restore(roomId) ?? newHistory();
+            this.rooms.set(roomId, room);
+        }
+        return room;
+    }
+
+    /**
+     * @brief Load a cold room from its snapshot
+     *
+     * The read is synchronous so that batches arriving meanwhile cannot
+     * start a second log; a snapshot is a few KB.
+     */
+    private restore(roomId: string): RoomHistory | null {
+        if (!this.scenes.available) return null;
+        let file = this.unwritten.get(roomId);
+        if (!file) {
+            try {
+                file = new Uint8Array(fs.readFileSync(this.fileFor(roomId)));
+            } catch {
+                return null; // Never saved
+            }
+        }
+
+        const header = new DataView(file.buffer, file.byteOffset, file.byteLength);
+        const magic = file.byteLength >= OLD_HEADER_BYTES ? header.getUint32(0, true) : 0;
+        const headerBytes = magic === SNAPSHOT_MAGIC ? HEADER_BYTES : magic === OLD_SNAPSHOT_MAGIC ? OLD_HEADER_BYTES : 0;
+        if (headerBytes === 0 || file.byteLength < headerBytes ||
+            !this.scenes.restore(roomId, file.subarray(headerBytes))) {
+            console.warn('Ignoring unreadable snapshot of room', roomId);
+            return null;
+        }
+
+        // Positions are only trusted from a FINAL snapshot, and only once
+        // it is marked live: a crash from now on must not bring it back
+        const final = headerBytes === HEADER_BYTES && (header.getUint32(16, true) & FINAL) !== 0;
+        if (!final || !this.markLive(roomId, file)) return newHistory();
+        const seq = header.getFloat64(8, true);
+        return { epoch: header.getUint32(4, true), seq, tail: [], tailSeq: seq, tailBytes: 0, snapshotSeq: seq };
+    }
+
+    /**
+     * @brief Clear the FINAL flag of a snapshot about to be resumed, on disk before anything is numbered
+     * @returns false if the file could not be written; the room then starts a new epoch
+     */
+    private markLive(roomId: string, file: Uint8Array): boolean {
+        const live = file.slice();
+        new DataView(live.buffer).setUint32(16, 0, true);
+        const target = this.fileFor(roomId);
+        try {
+            fs.mkdirSync(this.directory, { recursive: true });
+            fs.writeFileSync(`${target}.live.tmp`, live);
+            fs.renameSync(`${target}.live.tmp`, target);
+        } catch (error) {
+            console.error('Failed to reopen the snapshot of room', roomId, error);
+            return false;
+        }
+        // A write still queued or in flight would put the FINAL file back; queue the live one after it
+        this.queueWrite(roomId, live);
+        return true;
+    }
+
+    /**
+     * @brief Write the room's merged state with its position
+     * @param final The room is closing or the server stopping: nothing is numbered after this
+     */
+    private compact(roomId: string, room: RoomHistory, final: boolean) {
+        // Saved on close even if unchanged: a resumed room's file is no longer FINAL
+        if (!final && room.seq === room.snapshotSeq) return;
+        room.snapshotSeq = room.seq;
+        const snapshot = this.scenes.snapshot(roomId);
+        if (!snapshot) return;
+
+        const file = new Uint8Array(HEADER_BYTES + snapshot.byteLength);
+        const header = new DataView(file.buffer);
+        header.setUint32(0, SNAPSHOT_MAGIC, true);
+        header.setUint32(4, room.epoch, true);
+        header.setFloat64(8, room.seq, true);
+        header.setUint32(16, final ? FINAL : 0, true);
+        file.set(snapshot, HEADER_BYTES);
+        this.queueWrite(roomId, file);
+    }
+
+    private queueWrite(roomId: string, file: Uint8Array) {
+        this.unwritten.set(roomId, file);
+
+        // One write at a time per room; a queued write takes the newest snapshot
+        const previous = this.writes.get(roomId) ?? Promise.resolve();
+        const write: Promise<void> = previous.then(() => this.writeSnapshot(roomId)).finally(() => {
+            if (this.writes.get(roomId) === write) this.writes.delete(roomId);
+        });
+        this.writes.set(roomId, write);
+    }
+
+    private async writeSnapshot(roomId: string) {
+        const file = this.unwritten.get(roomId);
+        if (!file) return;
+        const target = this.fileFor(roomId);
+        try {
+            await fs.promises.mkdir(this.directory, { recursive: true });
+            // Rename over the old file, so a crash never leaves half a snapshot
+            await fs.promises.writeFile(`${target}.tmp`, file);
+            await fs.promises.rename(`${target}.tmp`, target);
+            if (this.unwritten.get(roomId) === file) this.unwritten.delete(roomId);
+        } catch (error) {
+            // Kept in memory; the next compaction tries again
+            console.error('Failed to save the snapshot of room', roomId, error);
+        }
+    }
+
+    private fileFor(roomId: string): string {
+        return path.join(this.directory, `${encodeURIComponent(roomId)}.ops`);
+    }
+}
+
+function newHistory(): RoomHistory {
+    return { epoch: randomInt(1, 0xffffffff), seq: 0, tail: [], tailSeq: 0, tailBytes: 0, snapshotSeq: 0 };
+}
@@ -0,0 +1,109 @@
+/**
+ * @file roomScenes.ts
+ * @brief Authoritative room state, held by the server in the headless engine
+ *
+ * Loads the Node build of the C++ engine (server/wasm/whiteboard_node.js,
+ * produced by build.sh) and keeps one Whiteboard per room. Every ops batch
+ * the server relays is also merged here, so a joining client gets the
+ * current board straight from memory instead of asking a peer for it.
+ */
+
+import * as fs from 'fs';
+import * as path from 'path';
+
+interface HeadlessWhiteboard {
+    applyRemoteOps(ops: Uint8Array): boolean;
+    snapshotOps(): Uint8Array;
+    loadOps(ops: Uint8Array): boolean;
+    delete(): void; // Free the embind object
+}
+
+interface HeadlessModule {
+    Whiteboard: new () => HeadlessWhiteboard;
+}
+
+// WHITEBOARD_WASM_BUILD=debug (or profile) loads that build from its subdirectory (see build.sh)
+const BUILD = process.env.WHITEBOARD_WASM_BUILD;
+const BUILD_DIR = BUILD === 'debug' || BUILD === 'profile' ? BUILD : '';
+const MODULE_PATH = path.join(process.cwd(), 'server', 'wasm', BUILD_DIR, 'whiteboard_node.js');
+
+export class RoomScenes {
+    private module: HeadlessModule | null = null;
+    private scenes: Map<string, HeadlessWhiteboard> = new Map(); // roomId -> merged board
+
+    /**
+     * @brief Load the headless engine
+     * @returns false if it is not built or fails to start; rooms then have no state here
+     */
+    async load(): Promise<boolean> {
+        if (!fs.existsSync(MODULE_PATH)) return false;
+        try {
+            // Emscripten's CommonJS output exports the module factory
+            // eslint-disable-next-line @typescript-eslint/no-var-requires
+            const createModule = require(MODULE_PATH);
+            this.module = await createModule();
+            return true;
+        } catch (error) {
+            console.error('Failed to load the headless whiteboard engine:', error);
+            return false;
+        }
+    }
+
+    /**
+     * @brief Whether room state is kept here, i.e. the engine loaded
+     */
+    get available(): boolean {
+        return this.module !== null;
+    }
+
+    /**
+     * @brief Merge a relayed ops batch into the room's board
+     */
+    apply(roomId: string, ops: Uint8Array) {
+        if (!this.module) return;
+        let scene = this.scenes.get(roomId);
+        if (!scene) {
+            scene = new this.module.Whiteboard();
+            this.scenes.set(roomId, scene);
+        }
+        if (!scene.applyRemoteOps(ops)) {
+            console.warn('Ignoring malformed ops batch for room', roomId);
+        }
+    }
+
+    /**
+     * @brief The room's board as ops, for Whiteboard.loadOps() on a joining client
+     * @returns null if no ops were merged for the room yet
+     */
+    snapshot(roomId: string): Uint8Array | null {
+        const scene = this.scenes.get(roomId);
+        // The snapshot is a view into WASM memory; copy it before it is sent
+        return scene ? scene.snapshotOps().slice() : null;
+    }
+
+    /**
+     * @brief Replace the room's board with a snapshot(), e.g. one read back from disk
+     * @returns false if the engine is not loaded or the snapshot is malformed
+     */
+    restore(roomId: string, ops: Uint8Array): boolean {
+        if (!this.module) return false;
+        this.drop(roomId);
+        const scene = new this.module.Whiteboard();
+        if (!scene.loadOps(ops)) {
+            scene.delete();
+            return false;
+        }
+        this.scenes.set(roomId, scene);
+        return true;
+    }
+
+    /**
+     * @brief Forget a room, e.g. when its last user leaves
+     */
+    drop(roomId: string) {
+        const scene = this.scenes.get(roomId);
+        if (!scene) return;
+        scene.delete();
+        this.scenes.delete(roomId);
+    }
+}
@@ -1,11 +1,16 @@
 import { Server as HTTPServer } from 'http';
 import { Server as SocketIOServer, Socket } from 'socket.io';
-import { DrawEvent, RoomEvent, ChatEvent, CanvasStateData } from './events';
+import { DrawEvent, RoomEvent, ChatEvent, CanvasStateData, SceneStateData, StrokeBatchData, OpsData, RoomPosition } from './events';
+import { RoomScenes } from './roomScenes';
+import { RoomLog } from './roomLog';
 
 export class SocketServer {
     private io: SocketIOServer;
     private rooms: Map<string, Set<string>> = new Map(); // roomId -> Set of userIds
     private canvasStates: Map<string, string> = new Map(); // roomId -> canvas state (base64)
+    private sceneStates: Map<string, Uint8Array> = new Map(); // roomId -> binary vector scene
+    private roomScenes = new RoomScenes(); // Authoritative merged state, when the headless engine is built
+    private roomLog = new RoomLog(this.roomScenes); // Numbered ops and saved snapshots of each room
 
     constructor(server: HTTPServer) {
         this.io = new SocketIOServer(server, {
@@ -16,6 +21,9 @@ export class SocketServer {
         });
 
         this.setupEventHandlers();
+        this.roomScenes.load().then(loaded => {
+            if (loaded) console.log('Serving room state from the headless engine');
+        });
     }
 
     private setupEventHandlers() {
@@ -23,8 +31,9 @@ export class SocketServer {
             console.log('Client connected:', socket.id);
 
             // Room events
-            socket.on(RoomEvent.JOIN_ROOM, (roomId: string) => {
-                this.handleJoinRoom(socket, roomId);
+            // A rejoining client sends the last position it applied
+            socket.on(RoomEvent.JOIN_ROOM, (roomId: string, since?: RoomPosition) => {
+                this.handleJoinRoom(socket, roomId, since);
             });
 
             socket.on(RoomEvent.LEAVE_ROOM, (roomId: string) => {
@@ -44,9 +53,33 @@ export class SocketServer {
                 socket.to(data.roomId).emit(DrawEvent.END, data);
             });
 
+            // One binary message per frame per drawer; relayed without decoding
+            socket.on(DrawEvent.STROKE_BATCH, (data: StrokeBatchData) => {
+                if (!(data.batch instanceof Uint8Array)) return;
+                socket.to(data.roomId).emit(DrawEvent.STROKE_BATCH, {
+                    roomId: data.roomId,
+                    userId: socket.id,
+                    batch: data.batch
+                });
+            });
+
+            socket.on(DrawEvent.OPS, (data: OpsData, ack?: (position: RoomPosition) => void) => {
+                if (!(data.ops instanceof Uint8Array)) return;
+                const position = this.roomLog.append(data.roomId, data.ops);
+                socket.to(data.roomId).emit(DrawEvent.OPS, {
+                    roomId: data.roomId,
+                    userId: socket.id,
+                    ops: data.ops,
+                    position
+                });
+                // The sender is not relayed its own batch; this is how it learns the position
+                if (typeof ack === 'function') ack(position);
+            });
+
             socket.on(DrawEvent.CLEAR, (roomId: string) => {
                 socket.to(roomId).emit(DrawEvent.CLEAR);
                 this.canvasStates.set(roomId, ''); // Clear saved state
+                this.sceneStates.delete(roomId);
             });
 
             socket.on(DrawEvent.REQUEST_CANVAS_STATE, (roomId: string) => {
@@ -63,6 +96,11 @@ export class SocketServer {
                 this.canvasStates.set(data.roomId, data.imageData);
             });
 
+            socket.on(DrawEvent.SCENE_STATE, (data: SceneStateData) => {
+                if (!(data.scene instanceof Uint8Array)) return;
+                this.sceneStates.set(data.roomId, data.scene);
+            });
+
             // Chat events
             socket.on(ChatEvent.MESSAGE, (data) => {
                 this.io.to(data.roomId).emit(ChatEvent.MESSAGE, {
@@ -79,7 +117,14 @@ export class SocketServer {
         });
     }
 
-    private handleJoinRoom(socket: Socket, roomId: string) {
+    /**
+     * @brief Save every room's state, e.g. before the server exits
+     */
+    saveRooms(): Promise<void> {
+        return this.roomLog.saveAll();
+    }
+
+    private handleJoinRoom(socket: Socket, roomId: string, since?: RoomPosition) {
         socket.join(roomId);
         
         if (!this.rooms.has(roomId)) {
@@ -99,6 +144,25 @@ export class SocketServer {
             roomId
         });
 
+        // Answer from the server's own copy of the room when there is one:
+        // only the missed batches for a rejoining client, else the snapshot
+        const catchUp = this.roomLog.catchUp(roomId, since);
+        if (catchUp?.kind === 'batches') {
+            socket.emit(DrawEvent.OPS_CATCH_UP, { roomId, batches: catchUp.batches, position: catchUp.position });
+            return;
+        }
+        if (catchUp?.kind === 'snapshot') {
+            socket.emit(DrawEvent.OPS_SNAPSHOT, { roomId, ops: catchUp.ops, position: catchUp.position });
+            return;
+        }
+
+        // Send the stored vector scene; fall back to asking a peer for a raster
+        const scene = this.sceneStates.get(roomId);
+        if (scene) {
+            socket.emit(DrawEvent.SCENE_STATE, { roomId, scene });
+            return;
+        }
+
         // Request canvas state from an existing user
         const roomUsers = this.rooms.get(roomId);
         if (roomUsers && roomUsers.size > 1) {
@@ -119,6 +183,8 @@ export class SocketServer {
             if (room.size === 0) {
                 this.rooms.delete(roomId);
                 this.canvasStates.delete(roomId); // Clean up canvas state when room is empty
+                this.sceneStates.delete(roomId);
+                this.roomLog.close(roomId); // Saved, so the room loads at once when it is next used
             }
         }
 
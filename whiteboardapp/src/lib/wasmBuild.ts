@@ -0,0 +1,14 @@
+/**
+ * @file wasmBuild.ts
+ * @brief Which engine build the browser loads
+ *
+ * build.sh writes the Release build to public/wasm and the Debug and
+ * Profile builds to public/wasm/debug and public/wasm/profile. Setting
+ * NEXT_PUBLIC_WASM_BUILD=debug (or profile) loads one of those instead,
+ * e.g. to get assertions and SAFE_HEAP checks while developing.
+ */
+
+const build = process.env.NEXT_PUBLIC_WASM_BUILD;
+
+/// URL directory of the engine's .js and .wasm files, without a trailing slash
+export const WASM_BASE = build === 'debug' || build === 'profile' ? `/wasm/${build}` : '/wasm';
@@ -10,6 +10,15 @@
  * - Touch and mouse input handling
  */
 
+import { CommandReplayer, Context2D } from './commandReplay';
+import { ImageFormat, RenderRequest, RenderMessage, RenderReply } from './workers/rasterProtocol';
+import { WASM_BASE } from './wasmBuild';
+import { instantiateCached } from './moduleCache';
+import { InputKind, InputFlag, INPUT_STRIDE } from './workers/engineProtocol';
+
+export { ImageFormat };
+export type { RenderRequest };
+
 /**
  * @brief Shape types available for drawing
  * 
@@ -24,6 +33,49 @@ export enum ShapeType {
     TRIANGLE = 'TRIANGLE'   // Triangle shape tool (future use)
 }
 
+/**
+ * @brief Counters from Whiteboard.getStats(); mirrors WhiteboardStats in whiteboard.hpp
+ *
+ * Timings are the last duration of each section in milliseconds, 0 unless
+ * profiling is on.
+ */
+export interface WhiteboardStats {
+    lines: number;
+    shapes: number;
+    points: number;          // Full-detail stroke points
+    bytesInUse: number;      // Element, point, history and command storage
+    frames: number;          // Frames drawn since creation
+    boundaryCalls: number;   // Calls into WASM during the last frame
+    commandFloats: number;   // Size of the last command buffer
+    timingsWritten: number;  // Samples ever written to the timing ring
+    drawMs: number;
+    hitTestMs: number;
+    eraseMs: number;
+    serializeMs: number;
+    deserializeMs: number;
+    exportMs: number;
+    syncMs: number;
+}
+
+/**
+ * @brief Timed sections; values match the C++ PerfSection enum
+ */
+export enum PerfSection {
+    DRAW = 0,
+    HIT_TEST = 1,
+    ERASE = 2,
+    SERIALIZE = 3,
+    DESERIALIZE = 4,
+    EXPORT = 5,
+    SYNC = 6
+}
+
+export interface PerfSample {
+    section: PerfSection;
+    start: number;     // Milliseconds since the engine was created
+    duration: number;  // Milliseconds
+}
+
 /**
  * @brief Interface for the WebAssembly module's Whiteboard constructor
  * 
@@ -35,6 +87,9 @@ interface WhiteboardModule {
         new(): Whiteboard;
     };
     ShapeType: typeof ShapeType;
+    _malloc(bytes: number): number;                 // Heap offset of a new allocation
+    _free(pointer: number): void;
+    HEAPF32: Float32Array;                          // The heap; replaced when memory grows
 }
 
 /**
@@ -48,10 +103,61 @@ interface Whiteboard {
     startDrawing(x: number, y: number): void;        // Start a drawing operation
     continueDrawing(x: number, y: number): void;     // Continue current drawing
     endDrawing(): void;                             // End current drawing
+    continueDrawingSamples(samples: Float32Array): void; // Continue with x, y, time triplets (smoothed, predicted)
+    setInkSmoothing(minCutoff: number, beta: number): void; // One-euro filter of timed samples; 0 disables
+    setInkPrediction(horizon: number): void;        // Milliseconds of predicted ink drawn ahead; 0 disables
     setShapeType(type: ShapeType): void;            // Set the current shape tool
+    setSimplifyTolerance(tolerance: number): void;  // RDP tolerance for finished strokes
+    setMinPointDistance(distance: number): void;    // Drop samples closer than this
+    setCurveFitting(tolerance: number): void;       // Bézier fit error of finished strokes; 0 keeps polylines
+    serialize(): Uint8Array;                        // Encode the board (view into WASM memory)
+    getSVGPaths(): string;                          // Whole board as SVG elements
+    beginSVGExport(decimals: number): void;         // Start a chunked SVG export
+    nextSVGChunk(maxBytes: number): Uint8Array;     // Next UTF-8 chunk (view into WASM memory); empty when done
+    renderImage(x: number, y: number, scale: number, width: number, height: number,
+                background: string, format: ImageFormat): Uint8Array; // Software render (view into WASM memory)
+    setWorkerThreads(count: number): void;          // Helper threads of the threaded build's pool
+    getWorkerThreads(): number;                     // 0 outside the threaded build
+    deserialize(bytes: Uint8Array): boolean;        // Replace the board with an encoded scene
+    setStrokeStreaming(enabled: boolean): void;     // Record local edits as stroke batches
+    takeStrokeBatch(): Uint8Array;                  // Local edits since last call (view into WASM memory)
+    applyStrokeBatch(sender: string, batch: Uint8Array): boolean; // Apply a peer's batch
+    collectLocalOps(): Uint8Array;                  // CRDT ops of local edits since last call (view into WASM memory)
+    applyRemoteOps(ops: Uint8Array): boolean;       // Merge a peer's CRDT ops
+    loadOps(ops: Uint8Array): boolean;              // Replace the board with a snapshotOps() state
+    setElementStyle(uid: bigint, color: string, thickness: number): boolean;
+    dropRemoteSender(sender: string): void;         // Finish strokes a peer left open
+    beginRemoteStroke(sender: string, uid: bigint, color: string, thickness: number,
+                      x: number, y: number): boolean; // Start a peer's stroke for appendPoints()
+    appendPoints(uid: bigint, pointer: number, count: number): boolean; // x, y pairs read in place from the heap
+    finishRemoteStroke(uid: bigint, tolerance: number): boolean; // Simplify and commit it
+    setSiteId(site: number): void;                  // High half of uids created here
+    getSiteId(): number;
+    hasElement(uid: bigint): boolean;
+    moveElement(uid: bigint, dx: number, dy: number): boolean; // O(1) move by stable id
+    removeElement(uid: bigint): boolean;            // O(1) remove by stable id
+    getSelectedIds(): BigUint64Array;               // Uids of selected elements (view into WASM memory)
+    undo(): boolean;                                // Undo the newest step
+    redo(): boolean;                                // Redo the newest undone step
+    canUndo(): boolean;
+    canRedo(): boolean;
+    endHistoryStep(): void;                         // Close the current gesture's undo step
+    setHistoryLimit(bytes: number): void;           // Cap undo history memory
+    getHistorySize(): number;                       // Bytes used by undo history
+    getStats(): WhiteboardStats;                    // Counters and last timings
+    setProfiling(enabled: boolean): void;           // Time draws, hit tests, erases, serialization
+    getTimings(): Float64Array;                     // Ring of section, start, duration samples (view into WASM memory)
     setColor(color: string): void;                  // Set drawing color
     setThickness(thickness: number): void;          // Set line thickness
     draw(context: CanvasRenderingContext2D): void;  // Draw to canvas
+    drawCommands(): Float32Array;                   // Encode frame into packed command buffer
+    getCommandPalette(): string[];                  // Colors referenced by the command buffer
+    drawDirtyCommands(): Float32Array;              // Encode only areas changed since last frame
+    invalidate(x: number, y: number, width: number, height: number): void; // Mark area for repaint
+    invalidateAll(): void;                          // Force a full repaint on the next frame
+    setTileCaching(enabled: boolean): void;         // Blit committed elements from raster tiles
+    setViewSize(width: number, height: number): void; // Visible canvas size for full repaints
+    setViewport(x: number, y: number, width: number, height: number, scale: number): void; // Camera; culls off-screen elements
     clear(): void;                                  // Clear the canvas
     erase(x: number, y: number, radius: number): void; // Erase at point
     startSelection(x: number, y: number): void;     // Start selection operation
@@ -60,11 +166,105 @@ interface Whiteboard {
     moveSelected(dx: number, dy: number): void;     // Move selected elements
     deleteSelected(): void;                        // Delete selected elements
     clearSelection(): void;                        // Clear selection state
-    redraw(): void;
 }
 
-// Module cache to prevent reloading the WebAssembly module
-let wasmModule: any = null;
+/**
+ * @brief Detect WebAssembly SIMD128 support
+ *
+ * Validates a minimal module containing a v128 instruction. When it passes,
+ * the SIMD build (whiteboard_simd) is loaded instead of the scalar one.
+ */
+function supportsWasmSimd(): boolean {
+    try {
+        return WebAssembly.validate(new Uint8Array([
+            0, 97, 115, 109, 1, 0, 0, 0, 1, 5, 1, 96, 0, 1, 123, 3,
+            2, 1, 0, 10, 10, 1, 8, 0, 65, 0, 253, 15, 253, 98, 11
+        ]));
+    } catch {
+        return false;
+    }
+}
+
+/**
+ * @brief Touch pointers are handled by the touch event listeners
+ */
+function isTouch(e: MouseEvent): boolean {
+    return 'pointerType' in e && (e as PointerEvent).pointerType === 'touch';
+}
+
+/**
+ * @brief Whether the threaded build (whiteboard_threads) can run here
+ *
+ * Its memory is a SharedArrayBuffer, which browsers only expose on
+ * cross-origin isolated pages (COOP/COEP headers).
+ */
+function supportsWasmThreads(): boolean {
+    return typeof SharedArrayBuffer !== 'undefined' &&
+           typeof crossOriginIsolated !== 'undefined' && crossOriginIsolated;
+}
+
+// One load per page, shared by every wrapper
+let modulePromise: Promise<WhiteboardModule> | null = null;
+
+/**
+ * @brief Load the engine build that suits this browser
+ *
+ * The .wasm is compiled while it downloads and comes from the compiled
+ * module cache on later visits (see moduleCache.ts).
+ */
+async function createWhiteboardModule(): Promise<WhiteboardModule> {
+    // The threaded build also uses SIMD; every browser with one has the other
+    const simd = supportsWasmSimd();
+    const variant = simd && supportsWasmThreads() ? 'whiteboard_threads'
+                  : simd ? 'whiteboard_simd' : 'whiteboard';
+    const wasmUrl = `${WASM_BASE}/${variant}.wasm`;
+    const { default: createModule } = await import(/* webpackIgnore: true */ `${WASM_BASE}/${variant}.js`);
+
+    // Emscripten has no error path for instantiateWasm; fail the load from here
+    let fail: (error: unknown) => void = () => {};
+    const failed = new Promise<never>((_, reject) => { fail = reject; });
+    return Promise.race([createModule({
+        locateFile: (path: string) => {
+            // Handle WebAssembly file location
+            if (path.endsWith('.wasm')) {
+                return wasmUrl;
+            }
+            // Pool threads of the threaded build, on older Emscripten versions
+            if (path.endsWith('.worker.js')) {
+                return `${WASM_BASE}/${variant}.worker.js`;
+            }
+            return path;
+        },
+        // Returning {} makes Emscripten wait for receiveInstance
+        instantiateWasm: (imports: WebAssembly.Imports,
+                          receiveInstance: (instance: WebAssembly.Instance, module: WebAssembly.Module) => void) => {
+            instantiateCached(wasmUrl, imports)
+                .then(({ instance, module }) => receiveInstance(instance, module))
+                .catch(fail);
+            return {};
+        },
+    }), failed]);
+}
+
+function loadWhiteboardModule(): Promise<WhiteboardModule> {
+    if (!modulePromise) {
+        modulePromise = createWhiteboardModule();
+        // Let a later call retry a failed load
+        modulePromise.catch(() => { modulePromise = null; });
+    }
+    return modulePromise;
+}
+
+/**
+ * @brief Start loading the engine before any whiteboard needs it
+ *
+ * Call as early as possible on pages with a board, e.g. when a room page
+ * mounts, so download and compilation overlap with joining the room and
+ * setting up the canvas.
+ */
+export function preloadWhiteboardModule(): void {
+    loadWhiteboardModule().catch(error => console.warn('Preloading the whiteboard engine failed:', error));
+}
 
 /**
  * @brief Tool types available for drawing
@@ -78,6 +278,20 @@ export enum Tool {
     ERASE = 'ERASE'
 }
 
+/**
+ * @brief CSS cursor of a tool over the canvas
+ */
+export function cursorFor(tool: Tool, shape: ShapeType): string {
+    switch (tool) {
+        case Tool.SELECT:
+            return 'crosshair';
+        case Tool.ERASE:
+            return 'none';
+        case Tool.DRAW:
+            return shape === ShapeType.FREEHAND ? 'default' : 'crosshair';
+    }
+}
+
 /**
  * @brief Main wrapper class for the WebAssembly whiteboard
  * 
@@ -92,7 +306,7 @@ export class WhiteboardWrapper {
     private module: WhiteboardModule | null = null;        // WebAssembly module reference
     private whiteboard: Whiteboard | null = null;          // Whiteboard instance
     private canvas: HTMLCanvasElement | null = null;       // Canvas element
-    private context: CanvasRenderingContext2D | null = null; // Canvas context
+    private context: Context2D | null = null;              // Canvas context; offscreen in the engine worker
     private isDrawing = false;                            // Drawing state flag
     private lastX = 0;                                    // Last mouse/touch X position
     private lastY = 0;                                    // Last mouse/touch Y position
@@ -102,14 +316,75 @@ export class WhiteboardWrapper {
     private dragStartX = 0;
     private dragStartY = 0;
     private isDraggingSelection = false;
+    private replayer = new CommandReplayer();             // Replays packed draw commands
+    private eraserCursor: { x: number; y: number } | null = null; // Last eraser circle drawn
+    private simplifyTolerance = 0.5;                      // Stroke simplification tolerance (px)
+    private minPointDistance = 1;                         // Minimum spacing of captured samples (px)
+    private viewX = 0;                                    // Board point at the canvas origin
+    private viewY = 0;
+    private viewScale = 1;                                // Canvas pixels per board unit
+    private strokeBatchListener: ((batch: Uint8Array) => void) | null = null; // Receives local stroke batches
+    private opsListener: ((ops: Uint8Array) => void) | null = null; // Receives local CRDT ops
+    private strokeFlushScheduled = false;                 // A batch flush is queued for the next frame
+    private strokeStartTime = 0;                          // Event time of the stroke's first sample
+    private inkSmoothing = { minCutoff: 1, beta: 0.007 }; // One-euro filter of pointer samples
+    private inkPrediction = 16;                           // Milliseconds of ink drawn ahead of the pointer
+    private curveTolerance = 0.5;                         // Bézier fit error of finished strokes (px)
+    private rasterWorker: Worker | null = null;           // Renders exports off the main thread
+    private rasterRequests = new Map<number, (reply: RenderReply) => void>(); // Pending worker renders
+    private nextRasterRequest = 1;
+    private rasterWorkerFailed = false;                   // Stop recreating a worker that cannot load
+    private timingsRead = 0;                              // Timing samples already returned by takeTimings()
+    private engineReady: Promise<void> | null = null;     // Engine creation, shared by prepare() and initialize()
+    private pendingScene: Uint8Array | null = null;       // Scene that arrived before the engine
+    private pointHeap = { pointer: 0, floats: 0 };       // Reused _malloc() buffer for appendPoints()
+
+    /**
+     * @brief Create the engine without a canvas
+     *
+     * Lets a room load its scene (loadScene()) while the canvas and the
+     * rendering path are still being set up; initialize() waits for the
+     * same engine. Safe to call more than once.
+     *
+     * @throws Error if the WebAssembly module fails to load
+     */
+    prepare(): Promise<void> {
+        if (!this.engineReady) {
+            this.engineReady = this.createEngine();
+            this.engineReady.catch(() => { this.engineReady = null; });
+        }
+        return this.engineReady;
+    }
+
+    private async createEngine() {
+        this.module = await loadWhiteboardModule();
+        this.whiteboard = new this.module.Whiteboard();
+        this.whiteboard.init();
+        // Uids are site << 32 | counter; a random site keeps peers' uids apart
+        this.whiteboard.setSiteId(crypto.getRandomValues(new Uint32Array(1))[0]);
+        this.whiteboard.setSimplifyTolerance(this.simplifyTolerance);
+        this.whiteboard.setMinPointDistance(this.minPointDistance);
+        this.whiteboard.setCurveFitting(this.curveTolerance);
+        this.whiteboard.setInkSmoothing(this.inkSmoothing.minCutoff, this.inkSmoothing.beta);
+        this.whiteboard.setInkPrediction(this.inkPrediction);
+        this.whiteboard.setStrokeStreaming(this.strokeBatchListener !== null);
+
+        if (this.pendingScene) {
+            const scene = this.pendingScene;
+            this.pendingScene = null;
+            if (!this.whiteboard.deserialize(scene)) {
+                console.warn('Ignoring invalid scene loaded before the engine was ready');
+            }
+        }
+    }
 
     /**
      * @brief Initialize the whiteboard with a canvas element
      * 
      * This method:
      * 1. Sets up the canvas and context
-     * 2. Loads the WebAssembly module
-     * 3. Initializes the whiteboard
+     * 2. Loads the WebAssembly module and creates the engine (see prepare())
+     * 3. Attaches the engine to the canvas and draws what is already loaded
      * 4. Sets up event listeners
      * 
      * @param canvas HTML Canvas element to draw on
@@ -118,32 +393,36 @@ export class WhiteboardWrapper {
      */
     async initialize(canvas: HTMLCanvasElement) {
         this.canvas = canvas;
-        this.context = canvas.getContext('2d');
-        
-        if (!this.context) {
+        await this.attach(canvas.getContext('2d'));
+        this.setupEventListeners();
+    }
+
+    /**
+     * @brief Initialize on a canvas transferred to a worker
+     *
+     * Used by the engine worker (see workerWhiteboard.ts). No listeners are
+     * added; the page sends its input through applyInput().
+     *
+     * @throws Error if canvas context cannot be obtained
+     * @throws Error if WebAssembly module fails to load
+     */
+    async initializeOffscreen(canvas: OffscreenCanvas) {
+        await this.attach(canvas.getContext('2d'));
+    }
+
+    private async attach(context: Context2D | null) {
+        this.context = context;
+        if (!context) {
             throw new Error('Could not get canvas context');
         }
 
         try {
-            // Load WebAssembly module if not already loaded
-            if (!wasmModule) {
-                const { default: createModule } = await import(/* webpackIgnore: true */ '/wasm/whiteboard.js');
-                wasmModule = await createModule({
-                    locateFile: (path: string) => {
-                        // Handle WebAssembly file location
-                        if (path.endsWith('.wasm')) {
-                            return '/wasm/whiteboard.wasm';
-                        }
-                        return path;
-                    },
-                });
-            }
-
-            // Initialize whiteboard instance
-            this.module = wasmModule;
-            this.whiteboard = new this.module.Whiteboard();
-            this.whiteboard.init();
-            this.setupEventListeners();
+            await this.prepare();
+            const whiteboard = this.whiteboard!;
+            whiteboard.setTileCaching(true);
+            whiteboard.setViewport(this.viewX, this.viewY, context.canvas.width, context.canvas.height, this.viewScale);
+            // A scene may have been loaded before the canvas existed
+            this.draw();
         } catch (error) {
             console.error('Failed to initialize WebAssembly module:', error);
             throw error;
@@ -154,38 +433,137 @@ export class WhiteboardWrapper {
      * @brief Set up canvas event listeners
      * 
      * Adds listeners for:
-     * - Mouse events (desktop)
+     * - Pointer events (mouse and pen), which carry coalesced samples
      * - Touch events (mobile)
-     * - Pointer events (future use)
      */
     private setupEventListeners() {
         if (!this.canvas) return;
 
-        // Mouse event listeners
-        this.canvas.addEventListener('mousedown', this.handleMouseDown);
-        this.canvas.addEventListener('mousemove', this.handleMouseMove);
-        this.canvas.addEventListener('mouseup', this.handleMouseUp);
-        this.canvas.addEventListener('mouseleave', this.handleMouseUp);
+        // Mouse and pen; touch input has its own handlers below
+        this.canvas.addEventListener('pointerdown', this.handleMouseDown);
+        this.canvas.addEventListener('pointermove', this.handleMouseMove);
+        this.canvas.addEventListener('pointerup', this.handleMouseUp);
+        this.canvas.addEventListener('pointerleave', this.handleMouseUp);
 
         // Touch event listeners
         this.canvas.addEventListener('touchstart', this.handleTouchStart);
         this.canvas.addEventListener('touchmove', this.handleTouchMove);
         this.canvas.addEventListener('touchend', this.handleTouchEnd);
+
+        // Wheel pans; ctrl+wheel (and trackpad pinch) zooms
+        this.canvas.addEventListener('wheel', this.handleWheel, { passive: false });
     }
 
     /**
-     * @brief Handle mouse down event
-     * 
-     * Starts drawing or selection operation based on current mode.
-     * Converts window coordinates to canvas coordinates.
+     * @brief Convert a pointer position to board coordinates
      */
-    private handleMouseDown = (e: MouseEvent) => {
-        if (!this.whiteboard || !this.canvas) return;
+    private toBoard(clientX: number, clientY: number): { x: number; y: number } {
+        const rect = this.canvas!.getBoundingClientRect();
+        return this.canvasToBoard(clientX - rect.left, clientY - rect.top);
+    }
 
+    /**
+     * @brief Convert a position in canvas pixels to board coordinates
+     */
+    private canvasToBoard(x: number, y: number): { x: number; y: number } {
+        return { x: x / this.viewScale + this.viewX, y: y / this.viewScale + this.viewY };
+    }
+
+    /**
+     * @brief Send every sample since the last event to the engine in one call
+     *
+     * Browsers deliver one pointermove per frame but keep the samples in
+     * between, which getCoalescedEvents() returns. Times are relative to the
+     * stroke's first sample, so they fit a Float32Array.
+     */
+    private continueStroke(e: MouseEvent) {
+        const events: PointerEvent[] = 'getCoalescedEvents' in e ? (e as PointerEvent).getCoalescedEvents() : [];
+        if (events.length === 0) events.push(e as PointerEvent);
+
+        const rect = this.canvas!.getBoundingClientRect();
+        const samples = new Float32Array(events.length * 3);
+        events.forEach((event, i) => {
+            samples[i * 3] = (event.clientX - rect.left) / this.viewScale + this.viewX;
+            samples[i * 3 + 1] = (event.clientY - rect.top) / this.viewScale + this.viewY;
+            samples[i * 3 + 2] = event.timeStamp - this.strokeStartTime;
+        });
+        this.whiteboard!.continueDrawingSamples(samples);
+    }
+
+    /**
+     * @brief Smoothing of pointer samples before they are kept
+     * @param minCutoff Cutoff in Hz when the pen is slow; lower removes more jitter, 0 disables
+     * @param beta Cutoff increase with speed; higher lags less on fast strokes
+     */
+    setInkSmoothing(minCutoff: number, beta: number): void {
+        this.inkSmoothing = { minCutoff, beta };
+        this.whiteboard?.setInkSmoothing(minCutoff, beta);
+    }
+
+    /**
+     * @brief How far ahead of the pointer the stroke is drawn
+     * @param horizon Milliseconds; about a frame hides most latency, 0 disables
+     */
+    setInkPrediction(horizon: number): void {
+        this.inkPrediction = horizon;
+        this.whiteboard?.setInkPrediction(horizon);
+    }
+
+    /**
+     * @brief Pan, or zoom around the pointer when ctrl is held
+     */
+    private handleWheel = (e: WheelEvent) => {
+        if (!this.whiteboard || !this.canvas) return;
+        e.preventDefault();
         const rect = this.canvas.getBoundingClientRect();
-        const x = e.clientX - rect.left;
-        const y = e.clientY - rect.top;
+        this.wheel(e.clientX - rect.left, e.clientY - rect.top, e.deltaX, e.deltaY, e.ctrlKey);
+    };
 
+    /**
+     * @brief Pan by a wheel delta, or zoom around a canvas position
+     */
+    private wheel(x: number, y: number, deltaX: number, deltaY: number, zoom: boolean) {
+        if (zoom) {
+            const anchor = this.canvasToBoard(x, y);
+            const scale = Math.min(8, Math.max(0.05, this.viewScale * Math.exp(-deltaY * 0.01)));
+            // Keep the board point under the pointer in place
+            this.setViewport(anchor.x - x / scale, anchor.y - y / scale, scale);
+        } else {
+            this.setViewport(
+                this.viewX + deltaX / this.viewScale,
+                this.viewY + deltaY / this.viewScale,
+                this.viewScale
+            );
+        }
+    }
+
+    /**
+     * @brief Move the camera
+     * @param x Board x shown at the left edge of the canvas
+     * @param y Board y shown at the top edge
+     * @param scale Canvas pixels per board unit; above 1 zooms in
+     */
+    setViewport(x: number, y: number, scale: number) {
+        if (!this.whiteboard || !this.context) return;
+        this.viewX = x;
+        this.viewY = y;
+        this.viewScale = scale;
+        this.invalidateEraserCursor();
+        this.eraserCursor = null;
+        this.whiteboard.setViewport(x, y, this.context.canvas.width, this.context.canvas.height, scale);
+        this.draw();
+    }
+
+    getViewport(): { x: number; y: number; scale: number } {
+        return { x: this.viewX, y: this.viewY, scale: this.viewScale };
+    }
+
+    /**
+     * @brief Start drawing, a selection or erasing at a board position
+     * @param selectBox Start a selection box instead of dragging the selection
+     */
+    private pointerDown(x: number, y: number, time: number, selectBox: boolean) {
+        const whiteboard = this.whiteboard!;
         this.isDrawing = true;
         this.lastX = x;
         this.lastY = y;
@@ -194,22 +572,71 @@ export class WhiteboardWrapper {
 
         switch (this.currentTool) {
             case Tool.DRAW:
-                this.whiteboard.startDrawing(x, y);
+                this.strokeStartTime = time;
+                whiteboard.startDrawing(x, y);
                 break;
             case Tool.SELECT:
-                if (e.shiftKey) {
-                    // Start selection box
-                    this.whiteboard.startSelection(x, y);
-                    this.isDraggingSelection = false;
+                // Start a selection box, or drag the selected shapes
+                if (selectBox) whiteboard.startSelection(x, y);
+                this.isDraggingSelection = !selectBox;
+                break;
+            case Tool.ERASE:
+                whiteboard.erase(x, y, this.eraserRadius);
+                break;
+        }
+    }
+
+    /**
+     * @brief Selection and eraser work of a pointer move; drawing takes samples instead
+     */
+    private pointerDrag(x: number, y: number) {
+        const whiteboard = this.whiteboard!;
+        switch (this.currentTool) {
+            case Tool.SELECT:
+                if (!this.isDraggingSelection) {
+                    // Update selection box
+                    whiteboard.updateSelection(x, y);
                 } else {
-                    // Start dragging selected shapes
-                    this.isDraggingSelection = true;
+                    // Move selected shapes
+                    whiteboard.moveSelected(x - this.lastX, y - this.lastY);
                 }
                 break;
             case Tool.ERASE:
-                this.whiteboard.erase(x, y, this.eraserRadius);
+                whiteboard.erase(x, y, this.eraserRadius);
                 break;
         }
+        this.lastX = x;
+        this.lastY = y;
+    }
+
+    private pointerUp() {
+        const whiteboard = this.whiteboard!;
+        this.isDrawing = false;
+        this.isDraggingSelection = false;
+
+        switch (this.currentTool) {
+            case Tool.DRAW:
+                whiteboard.endDrawing();
+                break;
+            case Tool.SELECT:
+                whiteboard.endSelection();
+                break;
+        }
+        // One drag or erase gesture is one undo step
+        whiteboard.endHistoryStep();
+    }
+
+    /**
+     * @brief Handle mouse down event
+     * 
+     * Starts drawing or selection operation based on current mode.
+     * Converts window coordinates to board coordinates.
+     */
+    private handleMouseDown = (e: MouseEvent) => {
+        if (!this.whiteboard || !this.canvas || isTouch(e)) return;
+
+        const { x, y } = this.toBoard(e.clientX, e.clientY);
+        this.pointerDown(x, y, e.timeStamp, e.shiftKey);
         this.draw();
     };
 
@@ -217,14 +644,12 @@ export class WhiteboardWrapper {
      * @brief Handle mouse move event
      * 
      * Continues drawing or updates selection based on current mode.
-     * Converts window coordinates to canvas coordinates.
+     * Converts window coordinates to board coordinates.
      */
     private handleMouseMove = (e: MouseEvent) => {
-        if (!this.whiteboard || !this.canvas) return;
+        if (!this.whiteboard || !this.canvas || isTouch(e)) return;
 
-        const rect = this.canvas.getBoundingClientRect();
-        const x = e.clientX - rect.left;
-        const y = e.clientY - rect.top;
+        const { x, y } = this.toBoard(e.clientX, e.clientY);
 
         // Always draw eraser circle if in erase mode
         if (this.currentTool === Tool.ERASE) {
@@ -233,28 +658,13 @@ export class WhiteboardWrapper {
 
         if (!this.isDrawing) return;
 
-        switch (this.currentTool) {
-            case Tool.DRAW:
-                this.whiteboard.continueDrawing(x, y);
-                break;
-            case Tool.SELECT:
-                if (!this.isDraggingSelection) {
-                    // Update selection box
-                    this.whiteboard.updateSelection(x, y);
-                } else {
-                    // Move selected shapes
-                    const dx = x - this.lastX;
-                    const dy = y - this.lastY;
-                    this.whiteboard.moveSelected(dx, dy);
-                }
-                break;
-            case Tool.ERASE:
-                this.whiteboard.erase(x, y, this.eraserRadius);
-                break;
+        if (this.currentTool === Tool.DRAW) {
+            this.continueStroke(e);
+            this.lastX = x;
+            this.lastY = y;
+        } else {
+            this.pointerDrag(x, y);
         }
-
-        this.lastX = x;
-        this.lastY = y;
         this.draw();
     };
 
@@ -263,20 +673,9 @@ export class WhiteboardWrapper {
      * 
      * Ends drawing or selection operation based on current mode.
      */
-    private handleMouseUp = () => {
-        if (!this.whiteboard || !this.isDrawing) return;
-
-        this.isDrawing = false;
-        this.isDraggingSelection = false;
-
-        switch (this.currentTool) {
-            case Tool.DRAW:
-                this.whiteboard.endDrawing();
-                break;
-            case Tool.SELECT:
-                this.whiteboard.endSelection();
-                break;
-        }
+    private handleMouseUp = (e: MouseEvent) => {
+        if (!this.whiteboard || !this.isDrawing || isTouch(e)) return;
+        this.pointerUp();
         this.draw();
     };
 
@@ -284,41 +683,16 @@ export class WhiteboardWrapper {
      * @brief Handle touch start event
      * 
      * Starts drawing or selection operation based on current mode.
-     * Converts window coordinates to canvas coordinates.
+     * Converts window coordinates to board coordinates.
      */
     private handleTouchStart = (e: TouchEvent) => {
         if (!this.whiteboard || !this.canvas) return;
         e.preventDefault();
 
-        const rect = this.canvas.getBoundingClientRect();
         const touch = e.touches[0];
-        const x = touch.clientX - rect.left;
-        const y = touch.clientY - rect.top;
-
-        this.isDrawing = true;
-        this.lastX = x;
-        this.lastY = y;
-        this.dragStartX = x;
-        this.dragStartY = y;
-
-        switch (this.currentTool) {
-            case Tool.DRAW:
-                this.whiteboard.startDrawing(x, y);
-                break;
-            case Tool.SELECT:
-                if (e.touches.length === 2) {
-                    // Two-finger touch starts selection
-                    this.whiteboard.startSelection(x, y);
-                    this.isDraggingSelection = false;
-                } else {
-                    // Single-finger touch starts dragging
-                    this.isDraggingSelection = true;
-                }
-                break;
-            case Tool.ERASE:
-                this.whiteboard.erase(x, y, this.eraserRadius);
-                break;
-        }
+        const { x, y } = this.toBoard(touch.clientX, touch.clientY);
+        // Two-finger touch starts selection
+        this.pointerDown(x, y, e.timeStamp, e.touches.length === 2);
         this.draw();
     };
 
@@ -326,37 +700,22 @@ export class WhiteboardWrapper {
      * @brief Handle touch move event
      * 
      * Continues drawing or updates selection based on current mode.
-     * Converts window coordinates to canvas coordinates.
+     * Converts window coordinates to board coordinates.
      */
     private handleTouchMove = (e: TouchEvent) => {
         if (!this.whiteboard || !this.canvas || !this.isDrawing) return;
         e.preventDefault();
 
-        const rect = this.canvas.getBoundingClientRect();
         const touch = e.touches[0];
-        const x = touch.clientX - rect.left;
-        const y = touch.clientY - rect.top;
+        const { x, y } = this.toBoard(touch.clientX, touch.clientY);
 
-        switch (this.currentTool) {
-            case Tool.DRAW:
-                this.whiteboard.continueDrawing(x, y);
-                break;
-            case Tool.SELECT:
-                if (!this.isDraggingSelection) {
-                    this.whiteboard.updateSelection(x, y);
-                } else {
-                    const dx = x - this.lastX;
-                    const dy = y - this.lastY;
-                    this.whiteboard.moveSelected(dx, dy);
-                }
-                break;
-            case Tool.ERASE:
-                this.whiteboard.erase(x, y, this.eraserRadius);
-                break;
+        if (this.currentTool === Tool.DRAW) {
+            this.whiteboard.continueDrawingSamples(new Float32Array([x, y, e.timeStamp - this.strokeStartTime]));
+            this.lastX = x;
+            this.lastY = y;
+        } else {
+            this.pointerDrag(x, y);
         }
-
-        this.lastX = x;
-        this.lastY = y;
         this.draw();
     };
 
@@ -368,20 +727,73 @@ export class WhiteboardWrapper {
     private handleTouchEnd = (e: TouchEvent) => {
         e.preventDefault();
         if (!this.whiteboard || !this.isDrawing) return;
+        this.pointerUp();
+        this.draw();
+    };
 
-        this.isDrawing = false;
-        this.isDraggingSelection = false;
+    /**
+     * @brief Apply a frame's worth of input records from the page (see engineProtocol.ts)
+     *
+     * The worker-hosted counterpart of the event handlers above. The
+     * samples of a stroke go to the engine in one call per batch and the
+     * board is drawn once at the end, however many records there are.
+     */
+    applyInput(events: Float64Array) {
+        if (!this.whiteboard || !this.context) return;
+        const whiteboard = this.whiteboard;
+        let samples: number[] = [];
+        const flushSamples = () => {
+            if (samples.length === 0) return;
+            whiteboard.continueDrawingSamples(new Float32Array(samples));
+            samples = [];
+        };
 
-        switch (this.currentTool) {
-            case Tool.DRAW:
-                this.whiteboard.endDrawing();
-                break;
-            case Tool.SELECT:
-                this.whiteboard.endSelection();
-                break;
+        for (let i = 0; i + INPUT_STRIDE <= events.length; i += INPUT_STRIDE) {
+            const kind: InputKind = events[i];
+            const flags = events[i + 1];
+            const { x, y } = this.canvasToBoard(events[i + 2], events[i + 3]);
+            switch (kind) {
+                case InputKind.DOWN:
+                    if (!this.isDrawing) this.pointerDown(x, y, events[i + 4], (flags & InputFlag.SELECT_BOX) !== 0);
+                    break;
+                case InputKind.MOVE:
+                    if (this.currentTool === Tool.ERASE) this.drawEraserCircle(x, y);
+                    if (!this.isDrawing) break;
+                    if (this.currentTool === Tool.DRAW) {
+                        samples.push(x, y, events[i + 4] - this.strokeStartTime);
+                        this.lastX = x;
+                        this.lastY = y;
+                    } else {
+                        this.pointerDrag(x, y);
+                    }
+                    break;
+                case InputKind.UP:
+                    if (!this.isDrawing) break;
+                    flushSamples();
+                    this.pointerUp();
+                    break;
+                case InputKind.WHEEL:
+                    flushSamples();
+                    this.wheel(events[i + 2], events[i + 3], events[i + 4], events[i + 5], (flags & InputFlag.ZOOM) !== 0);
+                    break;
+            }
         }
+        flushSamples();
         this.draw();
-    };
+    }
+
+    /**
+     * @brief Resize the canvas and repaint all of it
+     *
+     * A canvas transferred to a worker can only be resized from there, so
+     * this is the way to resize in both modes.
+     */
+    resize(width: number, height: number) {
+        if (!this.context) return;
+        this.context.canvas.width = width;
+        this.context.canvas.height = height;
+        this.redraw();
+    }
 
     /**
      * @brief Set the current shape type
@@ -398,19 +810,15 @@ export class WhiteboardWrapper {
      * @param tool Tool type to use for drawing
      */
     setTool(tool: Tool) {
+        if (this.currentTool === Tool.ERASE && tool !== Tool.ERASE) {
+            // Remove the leftover eraser circle
+            this.invalidateEraserCursor();
+            this.eraserCursor = null;
+            this.draw();
+        }
         this.currentTool = tool;
         if (this.canvas) {
-            switch (tool) {
-                case Tool.SELECT:
-                    this.canvas.style.cursor = 'crosshair';
-                    break;
-                case Tool.ERASE:
-                    this.canvas.style.cursor = 'none';
-                    break;
-                case Tool.DRAW:
-                    this.canvas.style.cursor = this.currentShape === ShapeType.FREEHAND ? 'default' : 'crosshair';
-                    break;
-            }
+            this.canvas.style.cursor = cursorFor(tool, this.currentShape);
         }
     }
 
@@ -419,6 +827,7 @@ export class WhiteboardWrapper {
      * @param size Eraser size in pixels
      */
     setEraserSize(size: number) {
+        this.invalidateEraserCursor();
         this.eraserRadius = size;
     }
 
@@ -460,13 +869,142 @@ export class WhiteboardWrapper {
         this.whiteboard.setThickness(thickness);
     }
 
+    /**
+     * @brief Move one element by its stable id
+     * @returns false if the element does not exist
+     */
+    moveElement(uid: bigint, dx: number, dy: number): boolean {
+        if (!this.whiteboard) return false;
+        const moved = this.whiteboard.moveElement(uid, dx, dy);
+        this.draw();
+        return moved;
+    }
+
+    /**
+     * @brief Remove one element by its stable id
+     * @returns false if the element does not exist
+     */
+    removeElement(uid: bigint): boolean {
+        if (!this.whiteboard) return false;
+        const removed = this.whiteboard.removeElement(uid);
+        this.draw();
+        return removed;
+    }
+
+    /**
+     * @brief Stable ids of the selected elements
+     */
+    getSelectedIds(): bigint[] {
+        if (!this.whiteboard) return [];
+        return Array.from(this.whiteboard.getSelectedIds());
+    }
+
+    /**
+     * @brief Undo the last drawing step
+     * @returns false if there was nothing to undo
+     */
+    undo(): boolean {
+        if (!this.whiteboard) return false;
+        const undone = this.whiteboard.undo();
+        this.draw();
+        return undone;
+    }
+
+    /**
+     * @brief Redo the last undone step
+     * @returns false if there was nothing to redo
+     */
+    redo(): boolean {
+        if (!this.whiteboard) return false;
+        const redone = this.whiteboard.redo();
+        this.draw();
+        return redone;
+    }
+
+    canUndo(): boolean {
+        return this.whiteboard ? this.whiteboard.canUndo() : false;
+    }
+
+    canRedo(): boolean {
+        return this.whiteboard ? this.whiteboard.canRedo() : false;
+    }
+
+    /**
+     * @brief Cap the memory used by undo history; the oldest steps are dropped first
+     * @param bytes Maximum history size in bytes
+     */
+    setHistoryLimit(bytes: number) {
+        if (!this.whiteboard) return;
+        this.whiteboard.setHistoryLimit(bytes);
+    }
+
+    /**
+     * @brief Set how aggressively finished freehand strokes are simplified
+     * @param tolerance Maximum deviation in pixels; 0 keeps every captured point
+     * @param minPointDistance Samples closer than this to the previous point are dropped while drawing
+     */
+    setSimplification(tolerance: number, minPointDistance: number = this.minPointDistance) {
+        this.simplifyTolerance = tolerance;
+        this.minPointDistance = minPointDistance;
+        if (!this.whiteboard) return;
+        this.whiteboard.setSimplifyTolerance(tolerance);
+        this.whiteboard.setMinPointDistance(minPointDistance);
+    }
+
+    /**
+     * @brief Set how closely finished strokes are fitted with Bézier curves
+     * @param tolerance Maximum deviation in pixels, up to 1; 0 draws and saves polylines
+     */
+    setCurveFitting(tolerance: number) {
+        this.curveTolerance = tolerance;
+        this.whiteboard?.setCurveFitting(tolerance);
+    }
+
+    /**
+     * @brief Engine counters for an overlay or telemetry; cheap enough to poll every frame
+     */
+    getStats(): WhiteboardStats | null {
+        return this.whiteboard ? this.whiteboard.getStats() : null;
+    }
+
+    /**
+     * @brief Time the engine's expensive calls into the timing ring (off by default)
+     */
+    setProfiling(enabled: boolean) {
+        this.whiteboard?.setProfiling(enabled);
+    }
+
+    /**
+     * @brief Timing samples recorded since the last call
+     *
+     * The ring holds the newest samples only; older ones not taken in time
+     * are skipped.
+     */
+    takeTimings(): PerfSample[] {
+        if (!this.whiteboard) return [];
+        const written = this.whiteboard.getStats().timingsWritten;
+        // A view into WASM memory; read it before anything else calls in
+        const ring = this.whiteboard.getTimings();
+        const capacity = ring.length / 3;
+        const samples: PerfSample[] = [];
+        for (let i = Math.max(this.timingsRead, written - capacity); i < written; i++) {
+            const at = (i % capacity) * 3;
+            samples.push({ section: ring[at] as PerfSection, start: ring[at + 1], duration: ring[at + 2] });
+        }
+        this.timingsRead = written;
+        return samples;
+    }
+
     /**
      * @brief Clear the entire canvas
      */
     clear() {
-        if (!this.whiteboard || !this.context || !this.canvas) return;
+        if (!this.whiteboard || !this.context) return;
         this.whiteboard.clear();
-        this.context.clearRect(0, 0, this.canvas.width, this.canvas.height);
+        this.eraserCursor = null;
+        // A full repaint starts with CLEAR_CANVAS, which ignores the view
+        // transform; drawing also sends the removals to peers now
+        this.draw();
     }
 
     /**
@@ -481,16 +1019,191 @@ export class WhiteboardWrapper {
         this.draw();
     }
 
+    /**
+     * @brief Stream local drawing as binary batches, at most one per animation frame
+     * @param listener Called with each batch (e.g. to send it over the socket); null stops streaming
+     */
+    setStrokeBatchListener(listener: ((batch: Uint8Array) => void) | null) {
+        this.strokeBatchListener = listener;
+        if (!this.whiteboard) return;
+        this.whiteboard.setStrokeStreaming(listener !== null);
+    }
+
+    /**
+     * @brief Apply a stroke batch received from another client
+     * @param sender Id of the client that produced the batch
+     */
+    applyRemoteStrokeBatch(sender: string, batch: Uint8Array) {
+        if (!this.whiteboard) return;
+        if (!this.whiteboard.applyStrokeBatch(sender, batch)) {
+            console.warn('Ignoring malformed stroke batch from', sender);
+        }
+        this.draw();
+    }
+
+    /**
+     * @brief Send merged edits (CRDT ops) of this board, at most once per animation frame
+     *
+     * Unlike stroke batches, ops carry every committed change (moves,
+     * deletes, erases, undo), and peers applying them converge on the same
+     * board regardless of delivery order.
+     *
+     * @param listener Called with each batch of ops; null stops sending
+     */
+    setOpsListener(listener: ((ops: Uint8Array) => void) | null) {
+        this.opsListener = listener;
+    }
+
+    /**
+     * @brief Merge CRDT ops received from another client
+     */
+    applyRemoteOps(ops: Uint8Array) {
+        if (!this.whiteboard) return;
+        if (!this.whiteboard.applyRemoteOps(ops)) {
+            console.warn('Ignoring malformed ops batch');
+        }
+        this.draw();
+    }
+
+    /**
+     * @brief Replace the board with the room state sent by the server
+     */
+    loadOpsSnapshot(ops: Uint8Array) {
+        if (!this.whiteboard) return;
+        if (!this.whiteboard.loadOps(ops)) {
+            console.warn('Room state snapshot is malformed; board may be incomplete');
+        }
+        this.draw();
+    }
+
+    /**
+     * @brief Recolor or resize one element by its stable id
+     * @returns false if the element does not exist
+     */
+    setElementStyle(uid: bigint, color: string, thickness: number): boolean {
+        if (!this.whiteboard) return false;
+        const changed = this.whiteboard.setElementStyle(uid, color, thickness);
+        this.draw();
+        return changed;
+    }
+
+    /**
+     * @brief Finish any strokes a client left open, e.g. when it leaves the room
+     */
+    dropRemoteSender(sender: string) {
+        if (!this.whiteboard) return;
+        this.whiteboard.dropRemoteSender(sender);
+        this.draw();
+    }
+
+    /**
+     * @brief Add a whole remote stroke in three engine calls, however many points it has
+     * @param points Interleaved x, y board coordinates; the first pair starts the stroke
+     * @param tolerance Simplification applied when the stroke is committed
+     * @returns false if the stroke already exists or has no points
+     *
+     * Suited to replaying history on join. For a stroke that arrives in
+     * pieces, use beginRemoteStroke() and appendRemotePoints().
+     */
+    replayRemoteStroke(sender: string, uid: bigint, color: string, thickness: number,
+                       points: Float32Array, tolerance = this.simplifyTolerance): boolean {
+        if (!this.whiteboard || points.length < 2) return false;
+        if (!this.whiteboard.beginRemoteStroke(sender, uid, color, thickness, points[0], points[1])) return false;
+        this.appendRemotePoints(uid, points.subarray(2));
+        this.whiteboard.finishRemoteStroke(uid, tolerance);
+        this.draw();
+        return true;
+    }
+
+    /**
+     * @brief Start a remote stroke that appendRemotePoints() continues
+     * @returns false if the uid is already on the board
+     */
+    beginRemoteStroke(sender: string, uid: bigint, color: string, thickness: number, x: number, y: number): boolean {
+        return this.whiteboard ? this.whiteboard.beginRemoteStroke(sender, uid, color, thickness, x, y) : false;
+    }
+
+    /**
+     * @brief Append interleaved x, y points to a remote stroke in one call
+     *
+     * The points are copied once into a heap buffer the engine reads in
+     * place; nothing is marshalled per point.
+     */
+    appendRemotePoints(uid: bigint, points: Float32Array): boolean {
+        if (!this.whiteboard || !this.module) return false;
+        const count = points.length >> 1;
+        if (count === 0) return true;
+        const module = this.module;
+        if (this.pointHeap.floats < count * 2) {
+            if (this.pointHeap.pointer) module._free(this.pointHeap.pointer);
+            // Grow geometrically so a stroke arriving in pieces allocates rarely
+            const floats = Math.max(count * 2, this.pointHeap.floats * 2, 4096);
+            this.pointHeap = { pointer: module._malloc(floats * 4), floats };
+        }
+        // Read HEAPF32 after _malloc(), which may have grown the heap
+        module.HEAPF32.set(points.subarray(0, count * 2), this.pointHeap.pointer >> 2);
+        return this.whiteboard.appendPoints(uid, this.pointHeap.pointer, count);
+    }
+
+    /**
+     * @brief Simplify and commit a remote stroke started with beginRemoteStroke()
+     */
+    finishRemoteStroke(uid: bigint, tolerance = this.simplifyTolerance): boolean {
+        if (!this.whiteboard) return false;
+        const finished = this.whiteboard.finishRemoteStroke(uid, tolerance);
+        this.draw();
+        return finished;
+    }
+
+    /**
+     * @brief Hand the local edits of this frame to the batch listener on the next animation frame
+     */
+    private scheduleStrokeFlush() {
+        if ((!this.strokeBatchListener && !this.opsListener) || this.strokeFlushScheduled) return;
+        this.strokeFlushScheduled = true;
+        requestAnimationFrame(() => {
+            this.strokeFlushScheduled = false;
+            if (!this.whiteboard) return;
+            // Batches are views into WASM memory; copy them before handing them out.
+            // Stroke batches go first so peers finish a stroke before its ops arrive.
+            if (this.strokeBatchListener) {
+                const batch = this.whiteboard.takeStrokeBatch();
+                if (batch.length > 0) this.strokeBatchListener(batch.slice());
+            }
+            if (this.opsListener) {
+                const ops = this.whiteboard.collectLocalOps();
+                if (ops.length > 0) this.opsListener(ops.slice());
+            }
+        });
+    }
+
     /**
      * @brief Draw the current state to the canvas
      * 
-     * Clears the canvas and redraws all elements.
+     * Repaints the areas that changed since the last frame.
      * Called after each operation that modifies the drawing.
+     * The engine tracks damaged rectangles and encodes a clipped redraw of
+     * just those areas into a command buffer, which is replayed here, so
+     * the whole update is a single WebAssembly call.
      */
     private draw() {
-        if (!this.whiteboard || !this.context || !this.canvas) return;
-        this.context.clearRect(0, 0, this.canvas.width, this.canvas.height);
-        this.whiteboard.draw(this.context);
+        if (!this.whiteboard || !this.context) return;
+        const whiteboard = this.whiteboard;
+        this.replayer.replay(
+            this.context,
+            whiteboard.drawDirtyCommands(),
+            () => whiteboard.getCommandPalette()
+        );
+        this.scheduleStrokeFlush();
+    }
+
+    /**
+     * @brief Mark the area under the last eraser circle for repaint
+     */
+    private invalidateEraserCursor() {
+        if (!this.eraserCursor || !this.whiteboard) return;
+        const r = this.eraserRadius + 1;
+        this.whiteboard.invalidate(this.eraserCursor.x - r, this.eraserCursor.y - r, r * 2, r * 2);
     }
 
     /**
@@ -499,7 +1212,11 @@ export class WhiteboardWrapper {
      * @param y Y coordinate of eraser center
      */
     private drawEraserCircle(x: number, y: number) {
-        if (!this.context || !this.canvas) return;
+        if (!this.context || !this.whiteboard) return;
+
+        // The cursor is drawn outside the engine, so repaint where it was
+        this.invalidateEraserCursor();
+        this.eraserCursor = { x, y };
 
         // Redraw the main content
         this.draw();
@@ -552,9 +1269,7 @@ export class WhiteboardWrapper {
         e.preventDefault();
         if (!this.whiteboard || !this.canvas) return;
 
-        const rect = this.canvas.getBoundingClientRect();
-        const x = e.clientX - rect.left;
-        const y = e.clientY - rect.top;
+        const { x, y } = this.toBoard(e.clientX, e.clientY);
         const shape = e.dataTransfer?.getData('shape') as ShapeType;
 
         if (shape) {
@@ -571,7 +1286,7 @@ export class WhiteboardWrapper {
      * @returns SVG content as a string
      */
     getSVGContent(): string {
-        if (!this.whiteboard || !this.canvas) return '';
+        if (!this.whiteboard) return '';
         
         let svgContent = '';
         
@@ -584,12 +1299,119 @@ export class WhiteboardWrapper {
         return svgContent;
     }
 
+    /**
+     * @brief Start streaming the board as SVG elements
+     * @param decimals Digits kept after the decimal point (0-4)
+     */
+    beginSVGExport(decimals = 2): void {
+        this.whiteboard?.beginSVGExport(decimals);
+    }
+
+    /**
+     * @brief Next chunk of the export started by beginSVGExport()
+     * @returns A copy of the chunk's UTF-8 markup, or null once the export is complete
+     */
+    nextSVGChunk(maxBytes = 64 * 1024): Uint8Array | null {
+        if (!this.whiteboard) return null;
+        const chunk = this.whiteboard.nextSVGChunk(maxBytes);
+        // The chunk is a view into WASM memory that the next call reuses
+        return chunk.length > 0 ? chunk.slice() : null;
+    }
+
+    /**
+     * @brief Render part of the board to an image on this thread
+     * @returns The encoded image, or an empty array if the size is out of range
+     */
+    renderImage(request: RenderRequest): Uint8Array {
+        if (!this.whiteboard) return new Uint8Array(0);
+        const { x, y, scale, width, height, background, format } = request;
+        // The engine returns a view into WASM memory; copy it out
+        return this.whiteboard.renderImage(x, y, scale, width, height, background, format).slice();
+    }
+
+    /**
+     * @brief Render part of the board to an image in a worker
+     *
+     * The current scene is snapshotted and sent to the worker, so later edits
+     * do not affect the result and the visible canvas is never touched. Falls
+     * back to renderImage() where workers are unavailable or fail.
+     */
+    async renderImageInWorker(request: RenderRequest): Promise<Uint8Array> {
+        const worker = this.getRasterWorker();
+        if (!worker) return this.renderImage(request);
+
+        const message: RenderMessage = { id: this.nextRasterRequest++, scene: this.serializeScene(), request };
+        const reply = await new Promise<RenderReply>(resolve => {
+            this.rasterRequests.set(message.id, resolve);
+            worker.postMessage(message, [message.scene.buffer]);
+        });
+        if (reply.bytes) return reply.bytes;
+        console.error('Worker render failed:', reply.error);
+        return this.renderImage(request);
+    }
+
+    private getRasterWorker(): Worker | null {
+        if (this.rasterWorker || this.rasterWorkerFailed || typeof Worker === 'undefined') return this.rasterWorker;
+        try {
+            this.rasterWorker = new Worker(new URL('./workers/rasterWorker.ts', import.meta.url), { type: 'module' });
+        } catch {
+            this.rasterWorkerFailed = true;
+            return null;
+        }
+        this.rasterWorker.onmessage = (event: MessageEvent<RenderReply>) => {
+            const resolve = this.rasterRequests.get(event.data.id);
+            this.rasterRequests.delete(event.data.id);
+            resolve?.(event.data);
+        };
+        this.rasterWorker.onerror = (event) => {
+            // The worker is unusable (e.g. failed to load); answer everyone from this thread instead
+            event.preventDefault();
+            this.rasterWorker?.terminate();
+            this.rasterWorker = null;
+            this.rasterWorkerFailed = true;
+            const pending = Array.from(this.rasterRequests.entries());
+            this.rasterRequests.clear();
+            for (const [id, resolve] of pending) resolve({ id, error: event.message });
+        };
+        return this.rasterWorker;
+    }
+
+    /**
+     * @brief Encode the board in the compact binary scene format
+     * @returns A copy of the encoded scene, safe to keep and send
+     */
+    serializeScene(): Uint8Array {
+        if (!this.whiteboard) return new Uint8Array(0);
+        // The engine returns a view into WASM memory; copy it out
+        return this.whiteboard.serialize().slice();
+    }
+
+    /**
+     * @brief Replace the board with a scene from serializeScene()
+     * @returns false if the data was not a valid scene (the board is unchanged)
+     *
+     * A scene that arrives while the engine is still loading is kept and
+     * applied as soon as it exists (only the newest one), so a room's
+     * state does not wait for the rendering path; it is validated then.
+     */
+    loadScene(scene: Uint8Array): boolean {
+        if (!this.whiteboard) {
+            this.pendingScene = scene.slice();
+            return true;
+        }
+        if (!this.whiteboard.deserialize(scene)) return false;
+        this.eraserCursor = null;
+        this.draw();
+        return true;
+    }
+
     redraw(): void {
         if (this.whiteboard && this.context) {
-            // Clear the canvas
-            this.context.clearRect(0, 0, this.canvas.width, this.canvas.height);
-            // Redraw all shapes
-            this.whiteboard.redraw();
+            // Repaint everything, e.g. after the canvas was resized
+            this.whiteboard.setViewport(this.viewX, this.viewY, this.context.canvas.width,
+                                        this.context.canvas.height, this.viewScale);
+            this.whiteboard.invalidateAll();
+            this.draw();
         }
     }
 } 
\ No newline at end of file
@@ -0,0 +1,283 @@
+/**
+ * @file workerWhiteboard.ts
+ * @brief The whiteboard with its engine and canvas in a Web Worker
+ *
+ * createWorkerWhiteboard() returns an object with every public method of
+ * WhiteboardWrapper, each returning a Promise. The canvas is transferred
+ * to the engine worker (engineWorker.ts) as an OffscreenCanvas, so hit
+ * testing, erasing, exports and drawing never block the page. The page
+ * only listens for input, which it packs into records (engineProtocol.ts)
+ * and posts once per animation frame.
+ *
+ * Messages are handled in order, so a call sees all input sent before it.
+ */
+
+import { WhiteboardWrapper, Tool, ShapeType, cursorFor } from './whiteboard';
+import type { RenderRequest } from './workers/rasterProtocol';
+import { EngineRequest, EngineEvent, InputKind, InputFlag } from './workers/engineProtocol';
+
+/**
+ * @brief WhiteboardWrapper's methods, answered by the worker
+ */
+export type AsyncWhiteboard = {
+    [K in keyof WhiteboardWrapper]: WhiteboardWrapper[K] extends (...args: infer A) => infer R
+        ? (...args: A) => Promise<Awaited<R>>
+        : never;
+} & {
+    terminate(): void; // Stop the worker; the canvas stays blank
+};
+
+/**
+ * @brief Whether this browser can draw from a worker
+ */
+export function supportsWorkerWhiteboard(): boolean {
+    return typeof Worker !== 'undefined' && typeof OffscreenCanvas !== 'undefined' &&
+           typeof HTMLCanvasElement !== 'undefined' &&
+           'transferControlToOffscreen' in HTMLCanvasElement.prototype;
+}
+
+/**
+ * @brief Touch pointers are handled by the touch event listeners
+ */
+function isTouch(e: PointerEvent): boolean {
+    return e.pointerType === 'touch';
+}
+
+interface PendingCall {
+    resolve(result: unknown): void;
+    reject(error: Error): void;
+}
+
+/**
+ * @brief Page side of the worker: input capture and calls by name
+ *
+ * Methods defined here take over from the generic call, for state the page
+ * also needs (tool and shape for the cursor) or values that cannot be
+ * posted (listeners, the canvas).
+ */
+class WorkerWhiteboardHost {
+    private worker: Worker;
+    private canvas: HTMLCanvasElement | null = null;
+    private pending = new Map<number, PendingCall>();
+    private nextCall = 1;
+    private input: number[] = [];                       // Records not yet posted
+    private inputScheduled = false;
+    private inputRect: DOMRect | null = null;           // Canvas position, read once per frame
+    private pressed = false;                            // A pointer or touch is down
+    private currentTool: Tool = Tool.DRAW;
+    private currentShape: ShapeType = ShapeType.FREEHAND;
+    private strokeBatchListener: ((batch: Uint8Array) => void) | null = null;
+    private opsListener: ((ops: Uint8Array) => void) | null = null;
+
+    constructor() {
+        this.worker = new Worker(new URL('./workers/engineWorker.ts', import.meta.url), { type: 'module' });
+        this.worker.onmessage = (event: MessageEvent<EngineEvent>) => {
+            const message = event.data;
+            switch (message.type) {
+                case 'reply': {
+                    const call = this.pending.get(message.id);
+                    this.pending.delete(message.id);
+                    if (message.error !== undefined) call?.reject(new Error(message.error));
+                    else call?.resolve(message.result);
+                    break;
+                }
+                case 'strokeBatch':
+                    this.strokeBatchListener?.(message.batch);
+                    break;
+                case 'ops':
+                    this.opsListener?.(message.ops);
+                    break;
+            }
+        };
+        this.worker.onerror = (event) => {
+            // The worker failed to load or crashed; nothing will answer
+            event.preventDefault();
+            this.failPending(new Error(event.message || 'Whiteboard worker failed'));
+        };
+    }
+
+    /**
+     * @brief Call a WhiteboardWrapper method in the worker
+     * @param transfer Arguments to move rather than copy, e.g. the OffscreenCanvas
+     */
+    call(method: string, args: unknown[], transfer: Transferable[] = []): Promise<unknown> {
+        // Input queued for this frame happened before the call
+        this.flushInput();
+        const id = this.nextCall++;
+        return new Promise((resolve, reject) => {
+            this.pending.set(id, { resolve, reject });
+            this.post({ type: 'call', id, method, args }, transfer);
+        });
+    }
+
+    /**
+     * @brief Hand the canvas to the worker and start listening for input
+     *
+     * The canvas's size is fixed from here on; change it with resize().
+     */
+    async initialize(canvas: HTMLCanvasElement): Promise<void> {
+        this.canvas = canvas;
+        const offscreen = canvas.transferControlToOffscreen();
+        canvas.style.cursor = cursorFor(this.currentTool, this.currentShape);
+        this.setupEventListeners();
+        await this.call('initializeOffscreen', [offscreen], [offscreen]);
+    }
+
+    async setTool(tool: Tool): Promise<void> {
+        this.currentTool = tool;
+        if (this.canvas) this.canvas.style.cursor = cursorFor(tool, this.currentShape);
+        await this.call('setTool', [tool]);
+    }
+
+    async setShape(shape: ShapeType): Promise<void> {
+        this.currentShape = shape;
+        await this.call('setShape', [shape]);
+    }
+
+    async createShape(shape: ShapeType, x: number, y: number): Promise<void> {
+        this.currentShape = shape;
+        await this.call('createShape', [shape, x, y]);
+    }
+
+    async setStrokeBatchListener(listener: ((batch: Uint8Array) => void) | null): Promise<void> {
+        this.strokeBatchListener = listener;
+        this.postListeners();
+    }
+
+    async setOpsListener(listener: ((ops: Uint8Array) => void) | null): Promise<void> {
+        this.opsListener = listener;
+        this.postListeners();
+    }
+
+    /**
+     * @brief Render in the engine worker; it is already off the main thread
+     */
+    async renderImageInWorker(request: RenderRequest): Promise<Uint8Array> {
+        return await this.call('renderImage', [request]) as Uint8Array;
+    }
+
+    terminate(): void {
+        this.worker.terminate();
+        this.failPending(new Error('Whiteboard worker terminated'));
+    }
+
+    private postListeners() {
+        this.flushInput();
+        this.post({ type: 'listen', strokes: this.strokeBatchListener !== null, ops: this.opsListener !== null });
+    }
+
+    private post(message: EngineRequest, transfer: Transferable[] = []) {
+        this.worker.postMessage(message, transfer);
+    }
+
+    private failPending(error: Error) {
+        const pending = Array.from(this.pending.values());
+        this.pending.clear();
+        for (const call of pending) call.reject(error);
+    }
+
+    private setupEventListeners() {
+        const canvas = this.canvas!;
+        canvas.addEventListener('pointerdown', this.handlePointerDown);
+        canvas.addEventListener('pointermove', this.handlePointerMove);
+        canvas.addEventListener('pointerup', this.handlePointerUp);
+        canvas.addEventListener('pointerleave', this.handlePointerUp);
+        canvas.addEventListener('touchstart', this.handleTouchStart);
+        canvas.addEventListener('touchmove', this.handleTouchMove);
+        canvas.addEventListener('touchend', this.handleTouchEnd);
+        canvas.addEventListener('wheel', this.handleWheel, { passive: false });
+    }
+
+    /**
+     * @brief Queue one record for the next animation frame; positions become canvas pixels
+     */
+    private queue(kind: InputKind, flags: number, clientX: number, clientY: number, a: number, b = 0) {
+        if (!this.inputRect) this.inputRect = this.canvas!.getBoundingClientRect();
+        const rect = this.inputRect;
+        this.input.push(kind, flags, clientX - rect.left, clientY - rect.top, a, b);
+        if (this.inputScheduled) return;
+        this.inputScheduled = true;
+        requestAnimationFrame(() => this.flushInput());
+    }
+
+    private flushInput() {
+        this.inputScheduled = false;
+        this.inputRect = null;
+        if (this.input.length === 0) return;
+        const events = new Float64Array(this.input);
+        this.input = [];
+        this.post({ type: 'input', events }, [events.buffer]);
+    }
+
+    private handlePointerDown = (e: PointerEvent) => {
+        if (isTouch(e)) return;
+        this.pressed = true;
+        this.queue(InputKind.DOWN, e.shiftKey ? InputFlag.SELECT_BOX : 0, e.clientX, e.clientY, e.timeStamp);
+    };
+
+    private handlePointerMove = (e: PointerEvent) => {
+        if (isTouch(e)) return;
+        // Hovers only matter for the eraser circle
+        if (!this.pressed && this.currentTool !== Tool.ERASE) return;
+        const events: PointerEvent[] = this.pressed && 'getCoalescedEvents' in e ? e.getCoalescedEvents() : [];
+        if (events.length === 0) events.push(e);
+        for (const event of events) {
+            this.queue(InputKind.MOVE, 0, event.clientX, event.clientY, event.timeStamp);
+        }
+    };
+
+    private handlePointerUp = (e: PointerEvent) => {
+        if (isTouch(e) || !this.pressed) return;
+        this.pressed = false;
+        this.queue(InputKind.UP, 0, e.clientX, e.clientY, e.timeStamp);
+    };
+
+    private handleTouchStart = (e: TouchEvent) => {
+        e.preventDefault();
+        const touch = e.touches[0];
+        this.pressed = true;
+        // Two-finger touch starts selection
+        this.queue(InputKind.DOWN, e.touches.length === 2 ? InputFlag.SELECT_BOX : 0,
+                   touch.clientX, touch.clientY, e.timeStamp);
+    };
+
+    private handleTouchMove = (e: TouchEvent) => {
+        e.preventDefault();
+        if (!this.pressed) return;
+        const touch = e.touches[0];
+        this.queue(InputKind.MOVE, 0, touch.clientX, touch.clientY, e.timeStamp);
+    };
+
+    private handleTouchEnd = (e: TouchEvent) => {
+        e.preventDefault();
+        if (!this.pressed) return;
+        this.pressed = false;
+        this.queue(InputKind.UP, 0, 0, 0, e.timeStamp);
+    };
+
+    private handleWheel = (e: WheelEvent) => {
+        e.preventDefault();
+        this.queue(InputKind.WHEEL, e.ctrlKey ? InputFlag.ZOOM : 0, e.clientX, e.clientY, e.deltaX, e.deltaY);
+    };
+}
+
+/**
+ * @brief Create a whiteboard whose engine runs in a worker
+ *
+ * Use it like a WhiteboardWrapper, awaiting results: initialize(canvas)
+ * first, then any method. Check supportsWorkerWhiteboard() first and use
+ * a WhiteboardWrapper where it is false.
+ */
+export function createWorkerWhiteboard(): AsyncWhiteboard {
+    const host = new WorkerWhiteboardHost();
+    const methods = host as unknown as Record<string, unknown>;
+    return new Proxy(host, {
+        get(_, name) {
+            // 'then' must stay undefined, or awaiting the proxy would call the worker
+            if (typeof name !== 'string' || name === 'then') return undefined;
+            const own = methods[name];
+            if (typeof own === 'function') return own.bind(host);
+            return (...args: unknown[]) => host.call(name, args);
+        },
+    }) as unknown as AsyncWhiteboard;
+}
@@ -0,0 +1,44 @@
+/**
+ * @file engineProtocol.ts
+ * @brief Messages between the page and the engine worker
+ *
+ * Input is sent as packed records, one message per animation frame;
+ * everything else is a call of a WhiteboardWrapper method by name.
+ */
+
+/**
+ * @brief Kinds of input record
+ */
+export enum InputKind {
+    DOWN = 0,   // Pointer or first touch pressed
+    MOVE = 1,   // Pointer moved, pressed or not; one record per coalesced sample
+    UP = 2,     // Released, or the pointer left the canvas
+    WHEEL = 3
+}
+
+/**
+ * @brief Bits of a record's flags
+ */
+export enum InputFlag {
+    SELECT_BOX = 1, // DOWN starts a selection box: shift held, or a two-finger touch
+    ZOOM = 2        // WHEEL zooms instead of panning: ctrl held, or a trackpad pinch
+}
+
+/**
+ * @brief Numbers per input record: kind, flags, x, y, a, b
+ *
+ * x and y are canvas pixels from the canvas's top-left corner. For
+ * pointer records a is the event time in milliseconds and b is unused;
+ * for WHEEL they are deltaX and deltaY.
+ */
+export const INPUT_STRIDE = 6;
+
+export type EngineRequest =
+    | { type: 'input'; events: Float64Array }
+    | { type: 'call'; id: number; method: string; args: unknown[] }
+    | { type: 'listen'; strokes: boolean; ops: boolean }; // Which local edits to post back
+
+export type EngineEvent =
+    | { type: 'reply'; id: number; result?: unknown; error?: string }
+    | { type: 'strokeBatch'; batch: Uint8Array }
+    | { type: 'ops'; ops: Uint8Array };
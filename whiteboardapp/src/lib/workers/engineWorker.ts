@@ -0,0 +1,62 @@
+/**
+ * @file engineWorker.ts
+ * @brief Hosts the whiteboard engine and its canvas off the main thread
+ *
+ * The worker owns a WhiteboardWrapper drawing to an OffscreenCanvas. The
+ * page (workerWhiteboard.ts) sends input records once per frame and calls
+ * wrapper methods by name; hit testing, erasing, exports and drawing all
+ * run here, so none of them block the page.
+ */
+
+import type { EngineRequest, EngineEvent } from './engineProtocol';
+import { WhiteboardWrapper } from '../whiteboard';
+
+// The "dom" lib types self as a Window; only these two members are used
+const scope = self as unknown as {
+    onmessage: ((event: MessageEvent<EngineRequest>) => void) | null;
+    postMessage(message: EngineEvent, transfer: Transferable[]): void;
+};
+
+const wrapper = new WhiteboardWrapper();
+const methods = wrapper as unknown as Record<string, unknown>;
+
+/**
+ * @brief Buffers a result can give away without copying
+ *
+ * The wrapper returns copies, never views into WASM memory; the check keeps
+ * it that way, since transferring the heap would detach the engine's memory.
+ */
+function transferables(result: unknown): Transferable[] {
+    if (result instanceof Uint8Array && result.byteLength === result.buffer.byteLength) {
+        return [result.buffer];
+    }
+    return [];
+}
+
+scope.onmessage = async (event) => {
+    const message = event.data;
+    switch (message.type) {
+        case 'input':
+            wrapper.applyInput(message.events);
+            break;
+        case 'listen':
+            // Batches are already copies (see scheduleStrokeFlush()); hand them over
+            wrapper.setStrokeBatchListener(message.strokes
+                ? batch => scope.postMessage({ type: 'strokeBatch', batch }, [batch.buffer]) : null);
+            wrapper.setOpsListener(message.ops
+                ? ops => scope.postMessage({ type: 'ops', ops }, [ops.buffer]) : null);
+            break;
+        case 'call': {
+            const { id, method, args } = message;
+            try {
+                const target = methods[method];
+                if (typeof target !== 'function') throw new Error(`No whiteboard method ${method}`);
+                const result = await target.apply(wrapper, args);
+                scope.postMessage({ type: 'reply', id, result }, transferables(result));
+            } catch (error) {
+                scope.postMessage({ type: 'reply', id, error: String(error) }, []);
+            }
+            break;
+        }
+    }
+};
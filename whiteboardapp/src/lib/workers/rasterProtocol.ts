@@ -0,0 +1,42 @@
+/**
+ * @file rasterProtocol.ts
+ * @brief Messages between the page and the raster worker
+ */
+
+/**
+ * @brief Encodings of renderImage()
+ *
+ * These values must match the C++ ImageFormat enum exactly.
+ */
+export enum ImageFormat {
+    RGBA = 0, // Raw straight-alpha pixels, row by row
+    PNG = 1,
+    QOI = 2
+}
+
+/**
+ * @brief Which part of the board to render, and how
+ *
+ * The image shows the board from (x, y) at scale pixels per board unit.
+ */
+export interface RenderRequest {
+    x: number;
+    y: number;
+    scale: number;
+    width: number;        // Pixels, at most 8192
+    height: number;
+    background: string;   // CSS hex color; anything else is transparent
+    format: ImageFormat;
+}
+
+export interface RenderMessage {
+    id: number;
+    scene: Uint8Array;    // From WhiteboardWrapper.serializeScene()
+    request: RenderRequest;
+}
+
+export interface RenderReply {
+    id: number;
+    bytes?: Uint8Array;   // Empty if the size was out of range
+    error?: string;
+}
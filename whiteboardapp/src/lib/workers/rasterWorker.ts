@@ -0,0 +1,71 @@
+/**
+ * @file rasterWorker.ts
+ * @brief Renders board images off the main thread
+ *
+ * The worker keeps its own engine instance. Each request carries a
+ * serialized scene, which is loaded and rasterized by the engine's software
+ * renderer, so exports and thumbnails never touch the visible canvas.
+ */
+
+import type { RenderMessage, RenderReply } from './rasterProtocol';
+import { WASM_BASE } from '../wasmBuild';
+import { instantiateCached } from '../moduleCache';
+
+interface RasterEngine {
+    init(): void;
+    deserialize(bytes: Uint8Array): boolean;
+    renderImage(x: number, y: number, scale: number, width: number, height: number,
+                background: string, format: number): Uint8Array;
+}
+
+// The "dom" lib types self as a Window; only these two members are used
+const scope = self as unknown as {
+    onmessage: ((event: MessageEvent<RenderMessage>) => void) | null;
+    postMessage(message: RenderReply, transfer: Transferable[]): void;
+};
+
+let engine: Promise<RasterEngine> | null = null;
+
+function loadEngine(): Promise<RasterEngine> {
+    if (!engine) {
+        engine = (async () => {
+            // The scalar build is enough here; rasterizing does not use the SIMD kernels
+            const { default: createModule } = await import(/* webpackIgnore: true */ `${WASM_BASE}/whiteboard.js`);
+            const wasmUrl = `${WASM_BASE}/whiteboard.wasm`;
+            let fail: (error: unknown) => void = () => {};
+            const failed = new Promise<never>((_, reject) => { fail = reject; });
+            const module = await Promise.race([createModule({
+                locateFile: (path: string) => path.endsWith('.wasm') ? wasmUrl : path,
+                // Shares the page's compiled-module cache (see moduleCache.ts)
+                instantiateWasm: (imports: WebAssembly.Imports,
+                                  receiveInstance: (instance: WebAssembly.Instance, module: WebAssembly.Module) => void) => {
+                    instantiateCached(wasmUrl, imports)
+                        .then(({ instance, module }) => receiveInstance(instance, module))
+                        .catch(fail);
+                    return {};
+                },
+            }), failed]);
+            const whiteboard: RasterEngine = new module.Whiteboard();
+            whiteboard.init();
+            return whiteboard;
+        })();
+    }
+    return engine;
+}
+
+scope.onmessage = async (event) => {
+    const { id, scene, request } = event.data;
+    try {
+        const whiteboard = await loadEngine();
+        if (!whiteboard.deserialize(scene)) {
+            scope.postMessage({ id, error: 'Invalid scene' }, []);
+            return;
+        }
+        // The result is a view into WASM memory; copy it so it can be transferred
+        const bytes = whiteboard.renderImage(request.x, request.y, request.scale, request.width,
+                                             request.height, request.background, request.format).slice();
+        scope.postMessage({ id, bytes }, [bytes.buffer]);
+    } catch (error) {
+        scope.postMessage({ id, error: String(error) }, []);
+    }
+};
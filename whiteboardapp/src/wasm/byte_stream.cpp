@@ -0,0 +1,49 @@
+#include "../../include/wasm/byte_stream.hpp"
+
+void ByteWriter::varint(uint64_t value) {
+    while (value >= 0x80) {
+        buffer.push_back(static_cast<uint8_t>(value) | 0x80);
+        value >>= 7;
+    }
+    buffer.push_back(static_cast<uint8_t>(value));
+}
+
+void ByteWriter::text(const std::string& value) {
+    varint(value.size());
+    buffer.insert(buffer.end(), value.begin(), value.end());
+}
+
+void ByteWriter::bytes(const uint8_t* data, size_t size) {
+    buffer.insert(buffer.end(), data, data + size);
+}
+
+uint8_t ByteReader::u8() {
+    if (!valid || cursor == end) {
+        valid = false;
+        return 0;
+    }
+    return *cursor++;
+}
+
+uint64_t ByteReader::varint() {
+    uint64_t value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        uint8_t byte = u8();
+        if (!valid) return 0;
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) return value;
+    }
+    valid = false; // More than ten bytes: not a varint we wrote
+    return 0;
+}
+
+std::string ByteReader::text() {
+    uint64_t size = varint();
+    if (!valid || size > remaining()) {
+        valid = false;
+        return std::string();
+    }
+    std::string value(reinterpret_cast<const char*>(cursor), static_cast<size_t>(size));
+    cursor += size;
+    return value;
+}
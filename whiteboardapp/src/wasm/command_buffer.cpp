@@ -0,0 +1,175 @@
+#include "../../include/wasm/command_buffer.hpp"
+
+CommandBuffer::CommandBuffer() : paletteRevision(0) {
+    reset();
+}
+
+void CommandBuffer::reset() {
+    commands.clear();
+    commands.push_back(static_cast<float>(paletteRevision));
+    forgetStyle();
+}
+
+void CommandBuffer::beginPath() {
+    op(DrawOp::BEGIN_PATH);
+}
+
+void CommandBuffer::polyline(const float* xy, size_t count) {
+    if (count == 0) return;
+
+    op(DrawOp::POLYLINE);
+    commands.push_back(static_cast<float>(count));
+    commands.insert(commands.end(), xy, xy + count * 2);
+}
+
+void CommandBuffer::polyline(const float* xs, const float* ys, size_t count) {
+    if (count == 0) return;
+
+    op(DrawOp::POLYLINE);
+    commands.push_back(static_cast<float>(count));
+
+    size_t start = commands.size();
+    commands.resize(start + count * 2);
+    float* out = commands.data() + start;
+    for (size_t i = 0; i < count; i++) {
+        out[i * 2] = xs[i];
+        out[i * 2 + 1] = ys[i];
+    }
+}
+
+void CommandBuffer::bezier(const float* xs, const float* ys, size_t count) {
+    if (count < 4) return;
+
+    size_t segments = (count - 1) / 3;
+    count = segments * 3 + 1;
+    op(DrawOp::BEZIER);
+    commands.push_back(static_cast<float>(segments));
+
+    size_t start = commands.size();
+    commands.resize(start + count * 2);
+    float* out = commands.data() + start;
+    for (size_t i = 0; i < count; i++) {
+        out[i * 2] = xs[i];
+        out[i * 2 + 1] = ys[i];
+    }
+}
+
+void CommandBuffer::stroke() {
+    op(DrawOp::STROKE);
+}
+
+void CommandBuffer::rect(float x, float y, float width, float height) {
+    op(DrawOp::RECT);
+    commands.insert(commands.end(), {x, y, width, height});
+}
+
+void CommandBuffer::strokeRect(float x, float y, float width, float height) {
+    op(DrawOp::STROKE_RECT);
+    commands.insert(commands.end(), {x, y, width, height});
+}
+
+void CommandBuffer::arc(float cx, float cy, float radius, float startAngle, float endAngle) {
+    op(DrawOp::ARC);
+    commands.insert(commands.end(), {cx, cy, radius, startAngle, endAngle});
+}
+
+void CommandBuffer::save() {
+    op(DrawOp::SAVE);
+}
+
+void CommandBuffer::restore() {
+    op(DrawOp::RESTORE);
+    forgetStyle();
+}
+
+void CommandBuffer::clip() {
+    op(DrawOp::CLIP);
+}
+
+void CommandBuffer::clearRect(float x, float y, float width, float height) {
+    op(DrawOp::CLEAR_RECT);
+    commands.insert(commands.end(), {x, y, width, height});
+}
+
+void CommandBuffer::clearCanvas() {
+    op(DrawOp::CLEAR_CANVAS);
+}
+
+void CommandBuffer::viewTransform(float scale, float x, float y) {
+    op(DrawOp::VIEW_TRANSFORM);
+    commands.insert(commands.end(), {scale, x, y});
+}
+
+void CommandBuffer::tileBegin(int32_t tx, int32_t ty, float size, float zoom) {
+    op(DrawOp::TILE_BEGIN);
+    commands.insert(commands.end(), {static_cast<float>(tx), static_cast<float>(ty), size, zoom});
+    forgetStyle();
+}
+
+void CommandBuffer::tileEnd() {
+    op(DrawOp::TILE_END);
+    forgetStyle();
+}
+
+void CommandBuffer::tileBlit(int32_t tx, int32_t ty, float size) {
+    op(DrawOp::TILE_BLIT);
+    commands.insert(commands.end(), {static_cast<float>(tx), static_cast<float>(ty), size});
+}
+
+void CommandBuffer::tileDrop(int32_t tx, int32_t ty) {
+    op(DrawOp::TILE_DROP);
+    commands.insert(commands.end(), {static_cast<float>(tx), static_cast<float>(ty)});
+}
+
+void CommandBuffer::tileDropAll() {
+    op(DrawOp::TILE_DROP_ALL);
+}
+
+void CommandBuffer::strokeStyle(const std::string& color) {
+    int32_t id = static_cast<int32_t>(internColor(color));
+    if (id == currentColor) return;
+
+    currentColor = id;
+    op(DrawOp::STROKE_STYLE);
+    commands.push_back(static_cast<float>(id));
+}
+
+void CommandBuffer::lineWidth(float width) {
+    if (width == currentWidth) return;
+
+    currentWidth = width;
+    op(DrawOp::LINE_WIDTH);
+    commands.push_back(width);
+}
+
+void CommandBuffer::roundCaps() {
+    if (roundCapsSet) return;
+
+    roundCapsSet = true;
+    op(DrawOp::ROUND_CAPS);
+}
+
+void CommandBuffer::lineDash(float on, float off) {
+    op(DrawOp::LINE_DASH);
+    commands.insert(commands.end(), {on, off});
+}
+
+void CommandBuffer::forgetStyle() {
+    currentColor = -1;
+    currentWidth = -1.0f;
+    roundCapsSet = false;
+}
+
+uint32_t CommandBuffer::internColor(const std::string& color) {
+    auto it = colorIds.find(color);
+    if (it != colorIds.end()) return it->second;
+
+    uint32_t id = static_cast<uint32_t>(palette.size());
+    palette.push_back(color);
+    colorIds.emplace(color, id);
+
+    // Publish the new revision through the header of the frame being recorded
+    paletteRevision++;
+    commands[0] = static_cast<float>(paletteRevision);
+    return id;
+}
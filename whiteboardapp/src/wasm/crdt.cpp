@@ -0,0 +1,101 @@
+#include "../../include/wasm/crdt.hpp"
+#include <algorithm>
+
+bool ElementReplica::present() const {
+    // Both lists are sorted: look for an add tag missing from the tombstones
+    size_t r = 0;
+    for (const Stamp& tag : added) {
+        while (r < removed.size() && removed[r] < tag) r++;
+        if (r == removed.size() || !(removed[r] == tag)) return true;
+    }
+    return false;
+}
+
+Stamp ReplicaSet::tick() {
+    return {++clock, localSite};
+}
+
+void ReplicaSet::observe(const Stamp& stamp) {
+    clock = std::max(clock, stamp.counter);
+}
+
+ElementReplica& ReplicaSet::at(uint64_t uid) {
+    auto found = replicas.find(uid);
+    if (found != replicas.end()) return found->second;
+    ElementReplica& replica = replicas[uid];
+    replica.added.push_back(Stamp());
+    return replica;
+}
+
+ElementReplica* ReplicaSet::find(uint64_t uid) {
+    auto found = replicas.find(uid);
+    return found == replicas.end() ? nullptr : &found->second;
+}
+
+void ReplicaSet::created(uint64_t uid) {
+    ElementReplica& replica = at(uid);
+    Stamp stamp = tick();
+    replica.style = replica.offset = replica.geometry = stamp;
+    touch(uid, MEMBERSHIP);
+}
+
+void ReplicaSet::restored(uint64_t uid) {
+    ElementReplica& replica = at(uid);
+    insertTag(replica.added, tick());
+    touch(uid, MEMBERSHIP);
+}
+
+void ReplicaSet::removed(uint64_t uid) {
+    ElementReplica& replica = at(uid);
+    for (const Stamp& tag : replica.added) insertTag(replica.removed, tag);
+    touch(uid, MEMBERSHIP);
+}
+
+ElementReplica& ReplicaSet::write(uint64_t uid, Field field) {
+    ElementReplica& replica = at(uid);
+    Stamp stamp = tick();
+    if (field == STYLE) replica.style = stamp;
+    if (field == OFFSET) replica.offset = stamp;
+    if (field == GEOMETRY) replica.geometry = stamp;
+    touch(uid, field);
+    return replica;
+}
+
+bool ReplicaSet::mergeTags(ElementReplica& replica, const std::vector<Stamp>& added,
+                           const std::vector<Stamp>& removed) {
+    for (const Stamp& tag : added) {
+        observe(tag);
+        insertTag(replica.added, tag);
+    }
+    for (const Stamp& tag : removed) {
+        observe(tag);
+        insertTag(replica.removed, tag);
+    }
+    return replica.present();
+}
+
+uint8_t ReplicaSet::pendingFields(uint64_t uid) const {
+    auto found = pendingMask.find(uid);
+    return found == pendingMask.end() ? 0 : found->second;
+}
+
+void ReplicaSet::clearPending() {
+    pendingMask.clear();
+    pendingOrder.clear();
+}
+
+void ReplicaSet::clear() {
+    replicas.clear();
+    clearPending();
+}
+
+void ReplicaSet::insertTag(std::vector<Stamp>& tags, const Stamp& tag) {
+    auto position = std::lower_bound(tags.begin(), tags.end(), tag);
+    if (position == tags.end() || !(*position == tag)) tags.insert(position, tag);
+}
+
+void ReplicaSet::touch(uint64_t uid, uint8_t fields) {
+    uint8_t& mask = pendingMask[uid];
+    if (mask == 0) pendingOrder.push_back(uid);
+    mask |= fields;
+}
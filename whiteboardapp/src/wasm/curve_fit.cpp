@@ -0,0 +1,262 @@
+#include "../../include/wasm/curve_fit.hpp"
+#include <algorithm>
+#include <cmath>
+
+typedef CurveFitter::Vec Vec;
+
+static const float CORNER_COS = 0.26f;     // Turns sharper than about 75 degrees keep a corner
+static const float CORNER_REACH = 4.0f;    // Turn measuring distance, in tolerances
+static const uint32_t MAX_ITERATIONS = 4;  // Newton-Raphson passes before splitting instead
+static const uint32_t MAX_FLATTEN_STEPS = 256;
+
+static Vec add(Vec a, Vec b) { return {a.x + b.x, a.y + b.y}; }
+static Vec subtract(Vec a, Vec b) { return {a.x - b.x, a.y - b.y}; }
+static Vec scale(Vec a, float s) { return {a.x * s, a.y * s}; }
+static float dot(Vec a, Vec b) { return a.x * b.x + a.y * b.y; }
+static float length(Vec a) { return std::sqrt(dot(a, a)); }
+static float squaredDistance(Vec a, Vec b) { return dot(subtract(a, b), subtract(a, b)); }
+
+static Vec normalize(Vec a) {
+    float l = length(a);
+    return l > 0 ? scale(a, 1 / l) : a;
+}
+
+static Vec bezierPoint(const Vec* b, float t) {
+    float s = 1 - t;
+    float b0 = s * s * s;
+    float b1 = 3 * s * s * t;
+    float b2 = 3 * s * t * t;
+    float b3 = t * t * t;
+    return {b[0].x * b0 + b[1].x * b1 + b[2].x * b2 + b[3].x * b3,
+            b[0].y * b0 + b[1].y * b1 + b[2].y * b2 + b[3].y * b3};
+}
+
+static Vec bezierDerivative(const Vec* b, float t) {
+    float s = 1 - t;
+    Vec d0 = scale(subtract(b[1], b[0]), 3 * s * s);
+    Vec d1 = scale(subtract(b[2], b[1]), 6 * s * t);
+    Vec d2 = scale(subtract(b[3], b[2]), 3 * t * t);
+    return add(add(d0, d1), d2);
+}
+
+static Vec bezierSecondDerivative(const Vec* b, float t) {
+    Vec first = add(subtract(b[2], scale(b[1], 2)), b[0]);
+    Vec second = add(subtract(b[3], scale(b[2], 2)), b[1]);
+    return add(scale(first, 6 * (1 - t)), scale(second, 6 * t));
+}
+
+static void emit(const Vec* bezier, std::vector<float>& outXs, std::vector<float>& outYs) {
+    for (int i = 1; i < 4; i++) {
+        outXs.push_back(bezier[i].x);
+        outYs.push_back(bezier[i].y);
+    }
+}
+
+void CurveFitter::fit(const float* xs, const float* ys, size_t count, float tolerance,
+                      std::vector<float>& outXs, std::vector<float>& outYs) {
+    outXs.clear();
+    outYs.clear();
+    if (count == 0) return;
+
+    // Repeated points have no direction and would break the tangents
+    points.clear();
+    points.push_back({xs[0], ys[0]});
+    for (size_t i = 1; i < count; i++) {
+        if (xs[i] != points.back().x || ys[i] != points.back().y) points.push_back({xs[i], ys[i]});
+    }
+    outXs.push_back(points[0].x);
+    outYs.push_back(points[0].y);
+    if (points.size() < 2) return;
+
+    // Turns are measured against points a few tolerances away, so jitter
+    // between close samples does not read as corners; of a run of sharp
+    // points, the sharpest is the corner
+    float toleranceSq = tolerance * tolerance;
+    float reachSq = toleranceSq * CORNER_REACH * CORNER_REACH;
+    uint32_t last = static_cast<uint32_t>(points.size() - 1);
+    uint32_t start = 0;
+    uint32_t sharpest = 0;
+    float sharpestCos = CORNER_COS;
+    uint32_t before = 0;
+    uint32_t after = 1;
+    for (uint32_t i = 1; i < last; i++) {
+        while (before + 1 < i && squaredDistance(points[before + 1], points[i]) >= reachSq) before++;
+        if (after <= i) after = i + 1;
+        while (after < last && squaredDistance(points[after], points[i]) < reachSq) after++;
+
+        Vec in = normalize(subtract(points[i], points[before]));
+        Vec out = normalize(subtract(points[after], points[i]));
+        float turn = dot(in, out);
+        if (turn < sharpestCos) {
+            sharpest = i;
+            sharpestCos = turn;
+        } else if (sharpest > start && turn >= CORNER_COS) {
+            fitSection(start, sharpest, toleranceSq, outXs, outYs);
+            start = sharpest;
+            sharpestCos = CORNER_COS;
+        }
+    }
+    if (sharpest > start) {
+        fitSection(start, sharpest, toleranceSq, outXs, outYs);
+        start = sharpest;
+    }
+    fitSection(start, last, toleranceSq, outXs, outYs);
+}
+
+void CurveFitter::fitSection(uint32_t first, uint32_t last, float toleranceSq,
+                             std::vector<float>& outXs, std::vector<float>& outYs) {
+    float reachSq = toleranceSq * CORNER_REACH * CORNER_REACH;
+    stack.clear();
+    stack.push_back({first, last, tangent(first, last, reachSq), tangent(last, first, reachSq)});
+
+    Vec bezier[4];
+    while (!stack.empty()) {
+        Range range = stack.back();
+        stack.pop_back();
+
+        if (range.last - range.first == 1) {
+            // Two points: a straight segment with thirds as handles
+            Vec a = points[range.first];
+            Vec b = points[range.last];
+            float third = length(subtract(b, a)) / 3;
+            bezier[0] = a;
+            bezier[1] = add(a, scale(range.startTangent, third));
+            bezier[2] = add(b, scale(range.endTangent, third));
+            bezier[3] = b;
+            emit(bezier, outXs, outYs);
+            continue;
+        }
+
+        chordLengths(range.first, range.last);
+        solve(range.first, range.last, range.startTangent, range.endTangent, bezier);
+        uint32_t split;
+        float error = maxError(range.first, range.last, bezier, split);
+
+        // Close misses are usually a parameterization problem, not a shape one
+        if (error >= toleranceSq && error < toleranceSq * 4) {
+            for (uint32_t i = 0; i < MAX_ITERATIONS && error >= toleranceSq; i++) {
+                reparameterize(range.first, range.last, bezier);
+                solve(range.first, range.last, range.startTangent, range.endTangent, bezier);
+                error = maxError(range.first, range.last, bezier, split);
+            }
+        }
+        if (error < toleranceSq) {
+            emit(bezier, outXs, outYs);
+            continue;
+        }
+
+        // Split at the worst point; both halves share its tangent
+        Vec center = normalize(subtract(tangent(split, range.first, reachSq), tangent(split, range.last, reachSq)));
+        if (center.x == 0 && center.y == 0) center = tangent(split, range.first, reachSq);
+        Vec reversed = {-center.x, -center.y};
+        stack.push_back({split, range.last, reversed, range.endTangent});
+        stack.push_back({range.first, split, range.startTangent, center});
+    }
+}
+
+Vec CurveFitter::tangent(uint32_t from, uint32_t towards, float reachSq) const {
+    // The first point far enough away that sample jitter barely turns it
+    int step = towards > from ? 1 : -1;
+    uint32_t i = from + step;
+    while (i != towards && squaredDistance(points[i], points[from]) < reachSq) i += step;
+    return normalize(subtract(points[i], points[from]));
+}
+
+void CurveFitter::chordLengths(uint32_t first, uint32_t last) {
+    params.resize(last - first + 1);
+    params[0] = 0;
+    for (uint32_t i = first + 1; i <= last; i++) {
+        params[i - first] = params[i - first - 1] + length(subtract(points[i], points[i - 1]));
+    }
+    float total = params[last - first];
+    for (float& u : params) u /= total;
+}
+
+void CurveFitter::solve(uint32_t first, uint32_t last, Vec startTangent, Vec endTangent, Vec* bezier) const {
+    Vec a = points[first];
+    Vec b = points[last];
+
+    // Least squares for the handle lengths along the fixed tangents
+    double c00 = 0, c01 = 0, c11 = 0, x0 = 0, x1 = 0;
+    for (uint32_t i = first; i <= last; i++) {
+        float u = params[i - first];
+        float s = 1 - u;
+        Vec a0 = scale(startTangent, 3 * u * s * s);
+        Vec a1 = scale(endTangent, 3 * u * u * s);
+        float onA = s * s * s + 3 * u * s * s;
+        float onB = 3 * u * u * s + u * u * u;
+        Vec rest = subtract(points[i], add(scale(a, onA), scale(b, onB)));
+        c00 += dot(a0, a0);
+        c01 += dot(a0, a1);
+        c11 += dot(a1, a1);
+        x0 += dot(a0, rest);
+        x1 += dot(a1, rest);
+    }
+    double determinant = c00 * c11 - c01 * c01;
+    float chord = length(subtract(b, a));
+    float alphaA = 0, alphaB = 0;
+    if (determinant != 0) {
+        alphaA = static_cast<float>((x0 * c11 - x1 * c01) / determinant);
+        alphaB = static_cast<float>((c00 * x1 - c01 * x0) / determinant);
+    }
+    // Degenerate or backwards handles: fall back to thirds of the chord
+    float epsilon = 1e-6f * chord;
+    if (!(alphaA > epsilon) || !(alphaB > epsilon)) alphaA = alphaB = chord / 3;
+
+    bezier[0] = a;
+    bezier[1] = add(a, scale(startTangent, alphaA));
+    bezier[2] = add(b, scale(endTangent, alphaB));
+    bezier[3] = b;
+}
+
+float CurveFitter::maxError(uint32_t first, uint32_t last, const Vec* bezier, uint32_t& split) const {
+    float worst = 0;
+    split = (first + last) / 2;
+    for (uint32_t i = first + 1; i < last; i++) {
+        Vec d = subtract(bezierPoint(bezier, params[i - first]), points[i]);
+        float distanceSq = dot(d, d);
+        if (distanceSq >= worst) {
+            worst = distanceSq;
+            split = i;
+        }
+    }
+    return worst;
+}
+
+void CurveFitter::reparameterize(uint32_t first, uint32_t last, const Vec* bezier) {
+    // One Newton-Raphson step towards the closest curve point of each input point
+    for (uint32_t i = first; i <= last; i++) {
+        float& u = params[i - first];
+        Vec d = subtract(bezierPoint(bezier, u), points[i]);
+        Vec tangent = bezierDerivative(bezier, u);
+        Vec second = bezierSecondDerivative(bezier, u);
+        float denominator = dot(tangent, tangent) + dot(d, second);
+        if (std::abs(denominator) < 1e-12f) continue;
+        u = std::max(0.0f, std::min(1.0f, u - dot(d, tangent) / denominator));
+    }
+}
+
+void flattenCubics(const float* xs, const float* ys, size_t count, float tolerance,
+                   std::vector<float>& outXs, std::vector<float>& outYs) {
+    outXs.clear();
+    outYs.clear();
+    if (count == 0) return;
+    outXs.push_back(xs[0]);
+    outYs.push_back(ys[0]);
+    tolerance = std::max(tolerance, 0.01f);
+
+    for (size_t i = 0; i + 3 < count; i += 3) {
+        Vec bezier[4] = {{xs[i], ys[i]}, {xs[i + 1], ys[i + 1]}, {xs[i + 2], ys[i + 2]}, {xs[i + 3], ys[i + 3]}};
+        // Uniform steps stay within 3/4 * m / n^2 of a cubic, m its largest second difference
+        Vec d0 = add(subtract(bezier[0], scale(bezier[1], 2)), bezier[2]);
+        Vec d1 = add(subtract(bezier[1], scale(bezier[2], 2)), bezier[3]);
+        float m = std::max(length(d0), length(d1));
+        float steps = std::ceil(std::sqrt(0.75f * m / tolerance));
+        uint32_t n = static_cast<uint32_t>(std::max(1.0f, std::min(steps, static_cast<float>(MAX_FLATTEN_STEPS))));
+        for (uint32_t k = 1; k <= n; k++) {
+            Vec p = bezierPoint(bezier, static_cast<float>(k) / static_cast<float>(n));
+            outXs.push_back(p.x);
+            outYs.push_back(p.y);
+        }
+    }
+}
@@ -0,0 +1,52 @@
+#include "../../include/wasm/dirty_region.hpp"
+#include <algorithm>
+
+void DirtyRegion::add(const Box& box) {
+    if (full || box.isEmpty()) return;
+
+    // Absorb overlapping rects while the union stays tight; a merge can
+    // create new overlaps, so keep going until nothing changes
+    Box pending = box;
+    bool mergedAny = true;
+    while (mergedAny) {
+        mergedAny = false;
+        for (size_t i = 0; i < rects.size(); i++) {
+            if (!rects[i].intersects(pending)) continue;
+
+            Box candidate = merged(rects[i], pending);
+            if (area(candidate) > area(rects[i]) + area(pending)) continue;
+
+            pending = candidate;
+            rects[i] = rects.back();
+            rects.pop_back();
+            mergedAny = true;
+            break;
+        }
+    }
+    rects.push_back(pending);
+
+    if (rects.size() > MAX_RECTS) {
+        Box all = rects[0];
+        for (const auto& rect : rects) all = merged(all, rect);
+        rects.assign(1, all);
+    }
+}
+
+void DirtyRegion::markAll() {
+    full = true;
+    rects.clear();
+}
+
+void DirtyRegion::reset() {
+    full = false;
+    rects.clear();
+}
+
+float DirtyRegion::area(const Box& box) {
+    return (box.maxX - box.minX) * (box.maxY - box.minY);
+}
+
+Box DirtyRegion::merged(const Box& a, const Box& b) {
+    return {std::min(a.minX, b.minX), std::min(a.minY, b.minY),
+            std::max(a.maxX, b.maxX), std::max(a.maxY, b.maxY)};
+}
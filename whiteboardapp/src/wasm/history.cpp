@@ -0,0 +1,90 @@
+#include "../../include/wasm/history.hpp"
+#include <utility>
+
+size_t HistoryEntry::bytes() const {
+    size_t total = sizeof(HistoryEntry) + (ids.size() + added.size()) * sizeof(uint32_t);
+    for (const auto& element : elements) total += element.bytes();
+    for (const auto& element : after) total += element.bytes();
+    return total;
+}
+
+void History::setLimit(size_t bytes) {
+    limit = bytes;
+    trim();
+}
+
+void History::clear() {
+    undoStack.clear();
+    redoStack.clear();
+    undoSizes.clear();
+    undoBytes = 0;
+    redoBytes = 0;
+    open = false;
+}
+
+void History::record(HistoryEntry entry) {
+    redoStack.clear();
+    redoBytes = 0;
+
+    undoSizes.push_back(entry.bytes());
+    undoBytes += undoSizes.back();
+    undoStack.push_back(std::move(entry));
+    open = true;
+    trim();
+}
+
+HistoryEntry* History::openEntry(HistoryEntry::Kind kind) {
+    if (!open || undoStack.empty() || undoStack.back().kind != kind) return nullptr;
+    return &undoStack.back();
+}
+
+void History::amended() {
+    if (undoStack.empty()) return;
+    undoBytes -= undoSizes.back();
+    undoSizes.back() = undoStack.back().bytes();
+    undoBytes += undoSizes.back();
+    trim();
+}
+
+HistoryEntry History::takeUndo() {
+    HistoryEntry entry = std::move(undoStack.back());
+    undoStack.pop_back();
+    undoBytes -= undoSizes.back();
+    undoSizes.pop_back();
+    open = false;
+    return entry;
+}
+
+HistoryEntry History::takeRedo() {
+    HistoryEntry entry = std::move(redoStack.back());
+    redoStack.pop_back();
+    redoBytes -= entry.bytes();
+    return entry;
+}
+
+void History::pushUndo(HistoryEntry entry) {
+    undoSizes.push_back(entry.bytes());
+    undoBytes += undoSizes.back();
+    undoStack.push_back(std::move(entry));
+    open = false;
+    trim();
+}
+
+void History::pushRedo(HistoryEntry entry) {
+    redoBytes += entry.bytes();
+    redoStack.push_back(std::move(entry));
+    trim();
+}
+
+void History::trim() {
+    // Undone steps go first: they are the least likely to be wanted again
+    while (size() > limit && !redoStack.empty()) {
+        redoBytes -= redoStack.front().bytes();
+        redoStack.erase(redoStack.begin());
+    }
+    while (size() > limit && undoStack.size() > 1) {
+        undoBytes -= undoSizes.front();
+        undoSizes.pop_front();
+        undoStack.pop_front();
+    }
+}
@@ -0,0 +1,328 @@
+#include "../../include/wasm/image_encode.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+static void putBigEndian32(std::vector<uint8_t>& out, uint32_t value) {
+    out.push_back(static_cast<uint8_t>(value >> 24));
+    out.push_back(static_cast<uint8_t>(value >> 16));
+    out.push_back(static_cast<uint8_t>(value >> 8));
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+// ---------------------------------------------------------------- deflate
+
+/**
+ * @brief LSB-first bit packer, as deflate orders bits
+ */
+class BitWriter {
+public:
+    explicit BitWriter(std::vector<uint8_t>& out) : out(out) {}
+
+    void bits(uint32_t value, uint32_t count) {
+        accumulator |= static_cast<uint64_t>(value) << filled;
+        filled += count;
+        while (filled >= 8) {
+            out.push_back(static_cast<uint8_t>(accumulator));
+            accumulator >>= 8;
+            filled -= 8;
+        }
+    }
+
+    /// Huffman codes are defined MSB-first
+    void code(uint32_t value, uint32_t length) {
+        uint32_t reversed = 0;
+        for (uint32_t i = 0; i < length; i++) reversed |= ((value >> i) & 1) << (length - 1 - i);
+        bits(reversed, length);
+    }
+
+    void flush() {
+        if (filled > 0) out.push_back(static_cast<uint8_t>(accumulator));
+        accumulator = 0;
+        filled = 0;
+    }
+
+private:
+    std::vector<uint8_t>& out;
+    uint64_t accumulator = 0;
+    uint32_t filled = 0;
+};
+
+// Fixed Huffman literal/length code (RFC 1951, 3.2.6)
+static void writeLiteral(BitWriter& writer, uint32_t symbol) {
+    if (symbol < 144) {
+        writer.code(0x30 + symbol, 8);
+    } else if (symbol < 256) {
+        writer.code(0x190 + symbol - 144, 9);
+    } else if (symbol < 280) {
+        writer.code(symbol - 256, 7);
+    } else {
+        writer.code(0xc0 + symbol - 280, 8);
+    }
+}
+
+static const uint16_t LENGTH_BASE[29] = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+                                         35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+static const uint8_t LENGTH_EXTRA[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+                                         3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+static const uint16_t DISTANCE_BASE[30] = {1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129,
+                                           193, 257, 385, 513, 769, 1025, 1537, 2049, 3073,
+                                           4097, 6145, 8193, 12289, 16385, 24577};
+static const uint8_t DISTANCE_EXTRA[30] = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6,
+                                           6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+static void writeMatch(BitWriter& writer, uint32_t length, uint32_t distance) {
+    uint32_t l = 28;
+    while (LENGTH_BASE[l] > length) l--;
+    writeLiteral(writer, 257 + l);
+    writer.bits(length - LENGTH_BASE[l], LENGTH_EXTRA[l]);
+
+    uint32_t d = 29;
+    while (DISTANCE_BASE[d] > distance) d--;
+    writer.code(d, 5);
+    writer.bits(distance - DISTANCE_BASE[d], DISTANCE_EXTRA[d]);
+}
+
+static uint32_t adler32(const uint8_t* data, size_t size) {
+    uint32_t a = 1;
+    uint32_t b = 0;
+    while (size > 0) {
+        // 5552 bytes is the most that cannot overflow before the modulo
+        size_t run = std::min<size_t>(size, 5552);
+        size -= run;
+        for (size_t i = 0; i < run; i++) {
+            a += *data++;
+            b += a;
+        }
+        a %= 65521;
+        b %= 65521;
+    }
+    return b << 16 | a;
+}
+
+/**
+ * @brief One fixed-Huffman deflate block of data[begin, end)
+ *
+ * Matches never reach before begin, so blocks can be compressed
+ * independently. A block that is not final is padded to a byte boundary
+ * with an empty stored block, so the next one can simply be appended.
+ */
+static void deflateBlock(const uint8_t* data, size_t begin, size_t end, bool final, std::vector<uint8_t>& out) {
+    const uint32_t HASH_BITS = 15;
+    const size_t WINDOW = 32768;
+    const uint32_t MIN_MATCH = 4; // Shorter matches rarely beat literals with fixed codes
+    const uint32_t MAX_MATCH = 258;
+
+    BitWriter writer(out);
+    writer.bits(final ? 1 : 0, 1);
+    writer.bits(1, 2);   // Fixed Huffman codes
+
+    std::vector<int32_t> head(size_t(1) << HASH_BITS, -1);
+    auto hash = [&](size_t at) {
+        uint32_t word;
+        std::memcpy(&word, data + at, 4);
+        return (word * 2654435761u) >> (32 - HASH_BITS);
+    };
+
+    // Positions are stored relative to begin
+    data += begin;
+    size_t size = end - begin;
+    size_t i = 0;
+    while (i < size) {
+        if (i + MIN_MATCH <= size) {
+            uint32_t h = hash(i);
+            int32_t candidate = head[h];
+            head[h] = static_cast<int32_t>(i);
+            if (candidate >= 0 && i - candidate <= WINDOW &&
+                std::memcmp(data + candidate, data + i, MIN_MATCH) == 0) {
+                size_t limit = std::min<size_t>(MAX_MATCH, size - i);
+                size_t length = MIN_MATCH;
+                while (length < limit && data[candidate + length] == data[i + length]) length++;
+                writeMatch(writer, static_cast<uint32_t>(length), static_cast<uint32_t>(i - candidate));
+
+                // Index a few positions inside the match so the next one can find them
+                size_t end = i + length;
+                for (size_t j = i + 1; j < end && j + MIN_MATCH <= size && j < i + 8; j++) {
+                    head[hash(j)] = static_cast<int32_t>(j);
+                }
+                i = end;
+                continue;
+            }
+        }
+        writeLiteral(writer, data[i]);
+        i++;
+    }
+    writeLiteral(writer, 256); // End of block
+    if (!final) writer.bits(0, 3); // Empty stored block: this header, then LEN and NLEN on a byte boundary
+    writer.flush();
+    if (!final) out.insert(out.end(), {0x00, 0x00, 0xff, 0xff});
+}
+
+/**
+ * @brief zlib stream of the data, deflated in parallel segments when a pool is given
+ */
+static void zlibCompress(const uint8_t* data, size_t size, std::vector<uint8_t>& out, WorkPool* pool) {
+    // Big enough that losing matches across segment starts costs little
+    const size_t MIN_SEGMENT = 256 * 1024;
+
+    out.push_back(0x78); // Deflate, 32K window
+    out.push_back(0x01); // Fastest compression; header checksum
+
+    size_t segments = 1;
+    if (pool) segments = std::max<size_t>(1, std::min<size_t>(pool->concurrency() * 2, size / MIN_SEGMENT));
+    if (segments == 1) {
+        deflateBlock(data, 0, size, true, out);
+    } else {
+        std::vector<std::vector<uint8_t>> parts(segments);
+        pool->parallelFor(static_cast<uint32_t>(segments), 1, [&](uint32_t first, uint32_t last) {
+            for (uint32_t s = first; s < last; s++) {
+                deflateBlock(data, size * s / segments, size * (s + 1) / segments, s + 1 == segments, parts[s]);
+            }
+        });
+        for (const std::vector<uint8_t>& part : parts) out.insert(out.end(), part.begin(), part.end());
+    }
+    putBigEndian32(out, adler32(data, size));
+}
+
+// ---------------------------------------------------------------- PNG
+
+struct CrcTable {
+    uint32_t entries[256];
+
+    CrcTable() {
+        for (uint32_t n = 0; n < 256; n++) {
+            uint32_t c = n;
+            for (int k = 0; k < 8; k++) c = (c & 1) ? 0xedb88320u ^ (c >> 1) : c >> 1;
+            entries[n] = c;
+        }
+    }
+};
+
+static uint32_t crc32(const uint8_t* data, size_t size, uint32_t crc = 0) {
+    // Built on first use; function statics are initialized thread-safely
+    static const CrcTable table;
+    crc = ~crc;
+    for (size_t i = 0; i < size; i++) crc = table.entries[(crc ^ data[i]) & 0xff] ^ (crc >> 8);
+    return ~crc;
+}
+
+static void writeChunk(std::vector<uint8_t>& out, const char* type, const uint8_t* data, size_t size) {
+    putBigEndian32(out, static_cast<uint32_t>(size));
+    size_t start = out.size();
+    out.insert(out.end(), type, type + 4);
+    out.insert(out.end(), data, data + size);
+    putBigEndian32(out, crc32(out.data() + start, size + 4));
+}
+
+/**
+ * @brief Filter rows [first, last) into their slots of filtered
+ */
+static void filterRows(const uint8_t* rgba, size_t stride, uint32_t first, uint32_t last, uint8_t* filtered) {
+    // Each row gets the filter whose output has the smaller sum of magnitudes
+    std::vector<uint8_t> sub(stride);
+    std::vector<uint8_t> up(stride);
+    for (uint32_t y = first; y < last; y++) {
+        const uint8_t* row = rgba + y * stride;
+        const uint8_t* previous = y > 0 ? row - stride : nullptr;
+        uint64_t subCost = 0;
+        uint64_t upCost = 0;
+        for (size_t i = 0; i < stride; i++) {
+            sub[i] = static_cast<uint8_t>(row[i] - (i >= 4 ? row[i - 4] : 0));
+            up[i] = static_cast<uint8_t>(row[i] - (previous ? previous[i] : 0));
+            subCost += static_cast<uint64_t>(std::abs(static_cast<int8_t>(sub[i])));
+            upCost += static_cast<uint64_t>(std::abs(static_cast<int8_t>(up[i])));
+        }
+        bool useUp = previous && upCost < subCost;
+        uint8_t* slot = filtered + y * (stride + 1);
+        slot[0] = useUp ? 2 : 1;
+        std::memcpy(slot + 1, useUp ? up.data() : sub.data(), stride);
+    }
+}
+
+void encodePNG(const uint8_t* rgba, uint32_t width, uint32_t height, std::vector<uint8_t>& out, WorkPool* pool) {
+    static const uint8_t SIGNATURE[8] = {137, 80, 78, 71, 13, 10, 26, 10};
+    out.insert(out.end(), SIGNATURE, SIGNATURE + 8);
+
+    std::vector<uint8_t> header;
+    putBigEndian32(header, width);
+    putBigEndian32(header, height);
+    header.insert(header.end(), {8, 6, 0, 0, 0}); // 8-bit RGBA, deflate, adaptive filters, no interlace
+    writeChunk(out, "IHDR", header.data(), header.size());
+
+    size_t stride = static_cast<size_t>(width) * 4;
+    std::vector<uint8_t> filtered((stride + 1) * height);
+    auto filter = [&](uint32_t first, uint32_t last) { filterRows(rgba, stride, first, last, filtered.data()); };
+    if (pool) {
+        pool->parallelFor(height, 64, filter);
+    } else {
+        filter(0, height);
+    }
+
+    std::vector<uint8_t> compressed;
+    zlibCompress(filtered.data(), filtered.size(), compressed, pool);
+    writeChunk(out, "IDAT", compressed.data(), compressed.size());
+    writeChunk(out, "IEND", nullptr, 0);
+}
+
+// ---------------------------------------------------------------- QOI
+
+void encodeQOI(const uint8_t* rgba, uint32_t width, uint32_t height, std::vector<uint8_t>& out) {
+    const uint8_t OP_RGB = 0xfe;
+    const uint8_t OP_RGBA = 0xff;
+    const uint8_t OP_INDEX = 0x00;
+    const uint8_t OP_DIFF = 0x40;
+    const uint8_t OP_LUMA = 0x80;
+    const uint8_t OP_RUN = 0xc0;
+
+    out.insert(out.end(), {'q', 'o', 'i', 'f'});
+    putBigEndian32(out, width);
+    putBigEndian32(out, height);
+    out.push_back(4); // RGBA
+    out.push_back(0); // sRGB with linear alpha
+
+    uint8_t seen[64][4] = {};
+    uint8_t last[4] = {0, 0, 0, 255};
+    uint32_t run = 0;
+    size_t pixels = static_cast<size_t>(width) * height;
+
+    for (size_t p = 0; p < pixels; p++) {
+        const uint8_t* pixel = rgba + p * 4;
+        if (std::memcmp(pixel, last, 4) == 0) {
+            if (++run == 62 || p + 1 == pixels) {
+                out.push_back(static_cast<uint8_t>(OP_RUN | (run - 1)));
+                run = 0;
+            }
+            continue;
+        }
+        if (run > 0) {
+            out.push_back(static_cast<uint8_t>(OP_RUN | (run - 1)));
+            run = 0;
+        }
+
+        uint32_t slot = (pixel[0] * 3 + pixel[1] * 5 + pixel[2] * 7 + pixel[3] * 11) % 64;
+        if (std::memcmp(seen[slot], pixel, 4) == 0) {
+            out.push_back(static_cast<uint8_t>(OP_INDEX | slot));
+        } else {
+            std::memcpy(seen[slot], pixel, 4);
+            if (pixel[3] != last[3]) {
+                out.insert(out.end(), {OP_RGBA, pixel[0], pixel[1], pixel[2], pixel[3]});
+            } else {
+                int8_t dr = static_cast<int8_t>(pixel[0] - last[0]);
+                int8_t dg = static_cast<int8_t>(pixel[1] - last[1]);
+                int8_t db = static_cast<int8_t>(pixel[2] - last[2]);
+                int8_t drg = static_cast<int8_t>(dr - dg);
+                int8_t dbg = static_cast<int8_t>(db - dg);
+                if (dr >= -2 && dr <= 1 && dg >= -2 && dg <= 1 && db >= -2 && db <= 1) {
+                    out.push_back(static_cast<uint8_t>(OP_DIFF | (dr + 2) << 4 | (dg + 2) << 2 | (db + 2)));
+                } else if (dg >= -32 && dg <= 31 && drg >= -8 && drg <= 7 && dbg >= -8 && dbg <= 7) {
+                    out.push_back(static_cast<uint8_t>(OP_LUMA | (dg + 32)));
+                    out.push_back(static_cast<uint8_t>((drg + 8) << 4 | (dbg + 8)));
+                } else {
+                    out.insert(out.end(), {OP_RGB, pixel[0], pixel[1], pixel[2]});
+                }
+            }
+        }
+        std::memcpy(last, pixel, 4);
+    }
+    out.insert(out.end(), {0, 0, 0, 0, 0, 0, 0, 1});
+}
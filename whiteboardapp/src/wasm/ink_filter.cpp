@@ -0,0 +1,78 @@
+#include "../../include/wasm/ink_filter.hpp"
+#include <algorithm>
+#include <cmath>
+
+static const float PI = 3.14159265f;
+static const float SPEED_CUTOFF = 1.0f;        // Hz; the one-euro derivative filter
+static const float VELOCITY_CUTOFF = 15.0f;    // Hz; prediction needs a quicker velocity than the cutoff does
+static const float ACCELERATION_CUTOFF = 5.0f; // Hz; acceleration is the noisiest estimate
+static const float ACCELERATION_WEIGHT = 0.5f; // Trust in acceleration when extrapolating
+static const float MIN_INTERVAL = 1.0f;        // ms; coalesced samples can share a timestamp
+
+// Exponential smoothing factor of a first-order low-pass over an interval
+static float smoothingFactor(float cutoff, float interval) {
+    float tau = 1000.0f / (2 * PI * cutoff);
+    return 1.0f / (1.0f + tau / interval);
+}
+
+void InkFilter::configure(float newMinCutoff, float newBeta) {
+    minCutoff = std::max(newMinCutoff, 0.0f);
+    beta = std::max(newBeta, 0.0f);
+}
+
+void InkFilter::reset(float startX, float startY) {
+    lastTime = 0;
+    samples = 0;
+    x = startX;
+    y = startY;
+    vx = vy = 0;
+    ax = ay = 0;
+    speed = 0;
+}
+
+void InkFilter::filter(float rawX, float rawY, float time, float& outX, float& outY) {
+    float interval = std::max(time - lastTime, MIN_INTERVAL);
+    lastTime = std::max(time, lastTime);
+
+    float previousX = x;
+    float previousY = y;
+    if (smoothing()) {
+        // One-euro: estimate the speed with a fixed low cutoff, then smooth the
+        // position with a cutoff that grows with it
+        float rawSpeed = std::hypot(rawX - x, rawY - y) / interval * 1000.0f;
+        speed += smoothingFactor(SPEED_CUTOFF, interval) * (rawSpeed - speed);
+        float alpha = smoothingFactor(minCutoff + beta * speed, interval);
+        x += alpha * (rawX - x);
+        y += alpha * (rawY - y);
+    } else {
+        x = rawX;
+        y = rawY;
+    }
+    outX = x;
+    outY = y;
+
+    // Motion of the filtered path, for predict()
+    float velocityAlpha = smoothingFactor(VELOCITY_CUTOFF, interval);
+    float newVx = vx + velocityAlpha * ((x - previousX) / interval - vx);
+    float newVy = vy + velocityAlpha * ((y - previousY) / interval - vy);
+    if (samples > 0) {
+        float accelerationAlpha = smoothingFactor(ACCELERATION_CUTOFF, interval);
+        ax += accelerationAlpha * ((newVx - vx) / interval - ax);
+        ay += accelerationAlpha * ((newVy - vy) / interval - ay);
+    }
+    vx = newVx;
+    vy = newVy;
+    samples++;
+}
+
+bool InkFilter::predict(float horizon, float* xs, float* ys, uint32_t count) const {
+    // One sample gives a velocity from the start point only; wait for a trend
+    if (samples < 3 || horizon <= 0 || count == 0) return false;
+    for (uint32_t i = 0; i < count; i++) {
+        float t = horizon * static_cast<float>(i + 1) / static_cast<float>(count);
+        float accelerationTerm = 0.5f * ACCELERATION_WEIGHT * t * t;
+        xs[i] = x + vx * t + ax * accelerationTerm;
+        ys[i] = y + vy * t + ay * accelerationTerm;
+    }
+    return true;
+}
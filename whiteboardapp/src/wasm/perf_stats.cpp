@@ -0,0 +1,12 @@
+#include "../../include/wasm/perf_stats.hpp"
+
+void PerfRecorder::record(PerfSection section, double start, double end) {
+    double duration = end - start;
+    lastDuration[static_cast<uint32_t>(section)] = duration;
+
+    double* sample = ring.data() + (total % CAPACITY) * SAMPLE_VALUES;
+    sample[0] = static_cast<double>(section);
+    sample[1] = start;
+    sample[2] = duration;
+    total++;
+}
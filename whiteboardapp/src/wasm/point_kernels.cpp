@@ -0,0 +1,183 @@
+#include "../../include/wasm/point_kernels.hpp"
+#include <cmath>
+
+#ifdef __wasm_simd128__
+#include <wasm_simd128.h>
+#endif
+
+void translatePoints(float* xs, float* ys, size_t count, float dx, float dy) {
+    size_t i = 0;
+
+#ifdef __wasm_simd128__
+    v128_t offsetX = wasm_f32x4_splat(dx);
+    v128_t offsetY = wasm_f32x4_splat(dy);
+    for (; i + 4 <= count; i += 4) {
+        wasm_v128_store(xs + i, wasm_f32x4_add(wasm_v128_load(xs + i), offsetX));
+        wasm_v128_store(ys + i, wasm_f32x4_add(wasm_v128_load(ys + i), offsetY));
+    }
+#endif
+
+    for (; i < count; i++) {
+        xs[i] += dx;
+        ys[i] += dy;
+    }
+}
+
+Box pointBounds(const float* xs, const float* ys, size_t count) {
+    Box box;
+    size_t i = 0;
+
+#ifdef __wasm_simd128__
+    if (count >= 4) {
+        v128_t minX = wasm_v128_load(xs);
+        v128_t maxX = minX;
+        v128_t minY = wasm_v128_load(ys);
+        v128_t maxY = minY;
+
+        for (i = 4; i + 4 <= count; i += 4) {
+            v128_t x = wasm_v128_load(xs + i);
+            v128_t y = wasm_v128_load(ys + i);
+            minX = wasm_f32x4_min(minX, x);
+            maxX = wasm_f32x4_max(maxX, x);
+            minY = wasm_f32x4_min(minY, y);
+            maxY = wasm_f32x4_max(maxY, y);
+        }
+
+        // Horizontal reduction of the four lanes
+        float lanesMinX[4], lanesMaxX[4], lanesMinY[4], lanesMaxY[4];
+        wasm_v128_store(lanesMinX, minX);
+        wasm_v128_store(lanesMaxX, maxX);
+        wasm_v128_store(lanesMinY, minY);
+        wasm_v128_store(lanesMaxY, maxY);
+        for (int lane = 0; lane < 4; lane++) {
+            box.extend(lanesMinX[lane], lanesMinY[lane]);
+            box.extend(lanesMaxX[lane], lanesMaxY[lane]);
+        }
+    }
+#endif
+
+    for (; i < count; i++) {
+        box.extend(xs[i], ys[i]);
+    }
+    return box;
+}
+
+bool splitPolylineByCircle(const float* xs, const float* ys, size_t count,
+                           float cx, float cy, float radius,
+                           std::vector<float>& outXs, std::vector<float>& outYs,
+                           std::vector<uint32_t>& pieceEnds) {
+    outXs.clear();
+    outYs.clear();
+    pieceEnds.clear();
+    if (count == 0) return false;
+
+    float radiusSquared = radius * radius;
+    auto inside = [&](float x, float y) {
+        float dx = x - cx;
+        float dy = y - cy;
+        return dx * dx + dy * dy < radiusSquared;
+    };
+    if (count == 1) return inside(xs[0], ys[0]);
+
+    bool hit = false;
+    bool open = false; // The current point is outside and ends the open piece
+    uint32_t pieceStart = 0;
+    auto push = [&](float x, float y) {
+        outXs.push_back(x);
+        outYs.push_back(y);
+    };
+    auto closePiece = [&]() {
+        uint32_t end = static_cast<uint32_t>(outXs.size());
+        if (end - pieceStart >= 2) {
+            pieceEnds.push_back(end);
+        } else {
+            outXs.resize(pieceStart);
+            outYs.resize(pieceStart);
+        }
+        pieceStart = static_cast<uint32_t>(outXs.size());
+        open = false;
+    };
+
+    if (!inside(xs[0], ys[0])) {
+        push(xs[0], ys[0]);
+        open = true;
+    }
+
+    for (size_t i = 0; i + 1 < count; i++) {
+        // Solve |p + t * d - c|^2 = r^2 for the part of the segment inside the circle
+        float px = xs[i];
+        float py = ys[i];
+        float dx = xs[i + 1] - px;
+        float dy = ys[i + 1] - py;
+        float fx = px - cx;
+        float fy = py - cy;
+        float a = dx * dx + dy * dy;
+        float b = fx * dx + fy * dy;
+        float c = fx * fx + fy * fy - radiusSquared;
+
+        float t0 = 1;
+        float t1 = 0;
+        if (a > 0) {
+            float discriminant = b * b - a * c;
+            if (discriminant > 0) {
+                float root = std::sqrt(discriminant);
+                t0 = (-b - root) / a;
+                t1 = (-b + root) / a;
+            }
+        } else if (c < 0) {
+            t0 = 0; // Repeated point inside the circle
+            t1 = 1;
+        }
+
+        if (t0 >= 1 || t1 <= 0) {
+            // Segment stays outside; its start is outside too, so a piece is open
+            if (!open) {
+                push(px, py);
+                open = true;
+            }
+            push(xs[i + 1], ys[i + 1]);
+            continue;
+        }
+
+        hit = true;
+        if (open) {
+            if (t0 > 0) push(px + t0 * dx, py + t0 * dy);
+            closePiece();
+        }
+        if (t1 < 1) {
+            push(px + t1 * dx, py + t1 * dy);
+            push(xs[i + 1], ys[i + 1]);
+            open = true;
+        }
+    }
+    if (open) closePiece();
+    return hit;
+}
+
+bool anyPointInBox(const float* xs, const float* ys, size_t count, const Box& box) {
+    size_t i = 0;
+
+#ifdef __wasm_simd128__
+    v128_t minX = wasm_f32x4_splat(box.minX);
+    v128_t maxX = wasm_f32x4_splat(box.maxX);
+    v128_t minY = wasm_f32x4_splat(box.minY);
+    v128_t maxY = wasm_f32x4_splat(box.maxY);
+
+    for (; i + 4 <= count; i += 4) {
+        v128_t x = wasm_v128_load(xs + i);
+        v128_t y = wasm_v128_load(ys + i);
+        v128_t inside = wasm_v128_and(
+            wasm_v128_and(wasm_f32x4_ge(x, minX), wasm_f32x4_le(x, maxX)),
+            wasm_v128_and(wasm_f32x4_ge(y, minY), wasm_f32x4_le(y, maxY)));
+        if (wasm_v128_any_true(inside)) return true;
+    }
+#endif
+
+    for (; i < count; i++) {
+        if (xs[i] >= box.minX && xs[i] <= box.maxX &&
+            ys[i] >= box.minY && ys[i] <= box.maxY) {
+            return true;
+        }
+    }
+    return false;
+}
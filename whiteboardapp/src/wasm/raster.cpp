@@ -0,0 +1,208 @@
+#include "../../include/wasm/raster.hpp"
+#include <algorithm>
+#include <cmath>
+
+static int hexDigit(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+bool parseHexColor(const std::string& text, uint32_t& rgba) {
+    size_t length = text.size();
+    if (length < 4 || text[0] != '#') return false;
+    if (length != 4 && length != 7 && length != 9) return false;
+
+    int digits[8];
+    for (size_t i = 1; i < length; i++) {
+        digits[i - 1] = hexDigit(text[i]);
+        if (digits[i - 1] < 0) return false;
+    }
+
+    uint32_t channels[4] = {0, 0, 0, 255};
+    if (length == 4) {
+        for (int c = 0; c < 3; c++) channels[c] = static_cast<uint32_t>(digits[c] * 17);
+    } else {
+        for (size_t c = 0; c < (length - 1) / 2; c++) {
+            channels[c] = static_cast<uint32_t>(digits[2 * c] * 16 + digits[2 * c + 1]);
+        }
+    }
+    rgba = channels[0] | channels[1] << 8 | channels[2] << 16 | channels[3] << 24;
+    return true;
+}
+
+void Rasterizer::reset(uint32_t width, uint32_t height, uint32_t background) {
+    imageWidth = width;
+    imageHeight = height;
+    size_t pixels = static_cast<size_t>(width) * height;
+    rgba.resize(pixels * 4);
+    for (size_t i = 0; i < pixels; i++) {
+        rgba[i * 4] = static_cast<uint8_t>(background);
+        rgba[i * 4 + 1] = static_cast<uint8_t>(background >> 8);
+        rgba[i * 4 + 2] = static_cast<uint8_t>(background >> 16);
+        rgba[i * 4 + 3] = static_cast<uint8_t>(background >> 24);
+    }
+    mask.assign(pixels, 0);
+    dirtyEmpty = true;
+}
+
+void Rasterizer::setTransform(float newScale, float newOriginX, float newOriginY, uint32_t newFirstRow) {
+    scale = newScale;
+    originX = newOriginX;
+    originY = newOriginY;
+    firstRow = static_cast<float>(newFirstRow);
+}
+
+Rasterizer::PixelBox Rasterizer::clip(float minX, float minY, float maxX, float maxY) const {
+    auto toPixel = [](float v, uint32_t size) {
+        return static_cast<int32_t>(std::max(-1.0f, std::min(static_cast<float>(size), std::floor(v))));
+    };
+    PixelBox box = {toPixel(minX, imageWidth), toPixel(minY, imageHeight),
+                    toPixel(maxX, imageWidth), toPixel(maxY, imageHeight)};
+    box.x0 = std::max(box.x0, 0);
+    box.y0 = std::max(box.y0, 0);
+    box.x1 = std::min(box.x1, static_cast<int32_t>(imageWidth) - 1);
+    box.y1 = std::min(box.y1, static_cast<int32_t>(imageHeight) - 1);
+    return box;
+}
+
+void Rasterizer::cover(int32_t x, int32_t y, float coverage) {
+    if (coverage <= 0) return;
+    uint8_t value = static_cast<uint8_t>(std::min(coverage, 1.0f) * 255.0f + 0.5f);
+    uint8_t& cell = mask[static_cast<size_t>(y) * imageWidth + x];
+    if (value <= cell) return;
+    cell = value;
+
+    if (dirtyEmpty) {
+        dirty = {x, y, x, y};
+        dirtyEmpty = false;
+        return;
+    }
+    dirty.x0 = std::min(dirty.x0, x);
+    dirty.y0 = std::min(dirty.y0, y);
+    dirty.x1 = std::max(dirty.x1, x);
+    dirty.y1 = std::max(dirty.y1, y);
+}
+
+// Strokes thinner than a pixel fade out instead of aliasing
+static float peakCoverage(float halfWidth) {
+    return std::min(1.0f, 2 * halfWidth);
+}
+
+void Rasterizer::capsule(float ax, float ay, float bx, float by, float halfWidth) {
+    float reach = halfWidth + 1;
+    PixelBox box = clip(std::min(ax, bx) - reach, std::min(ay, by) - reach,
+                        std::max(ax, bx) + reach, std::max(ay, by) + reach);
+
+    float dx = bx - ax;
+    float dy = by - ay;
+    float lengthSquared = dx * dx + dy * dy;
+    float peak = peakCoverage(halfWidth);
+
+    for (int32_t y = box.y0; y <= box.y1; y++) {
+        float py = y + 0.5f - ay;
+        for (int32_t x = box.x0; x <= box.x1; x++) {
+            float px = x + 0.5f - ax;
+            // Distance from the pixel center to the segment
+            float t = lengthSquared > 0 ? std::max(0.0f, std::min(1.0f, (px * dx + py * dy) / lengthSquared)) : 0;
+            float ex = px - t * dx;
+            float ey = py - t * dy;
+            float distance = std::sqrt(ex * ex + ey * ey);
+            cover(x, y, std::min(peak, halfWidth + 0.5f - distance));
+        }
+    }
+}
+
+void Rasterizer::strokePolyline(const float* xs, const float* ys, uint32_t count, float width, uint32_t color) {
+    // Like the canvas, a lone point draws nothing; a zero-length segment draws a dot
+    if (count < 2) return;
+    float halfWidth = width * scale / 2;
+    for (uint32_t i = 0; i + 1 < count; i++) {
+        capsule(pixelX(xs[i]), pixelY(ys[i]), pixelX(xs[i + 1]), pixelY(ys[i + 1]), halfWidth);
+    }
+    composite(color);
+}
+
+void Rasterizer::strokeRect(float x0, float y0, float x1, float y1, float width, uint32_t color) {
+    float minX = pixelX(std::min(x0, x1));
+    float minY = pixelY(std::min(y0, y1));
+    float maxX = pixelX(std::max(x0, x1));
+    float maxY = pixelY(std::max(y0, y1));
+    float halfWidth = width * scale / 2;
+    float peak = peakCoverage(halfWidth);
+
+    // Mitered outline: inside the outer box and outside the inner one
+    auto inside = [](float px, float py, float left, float top, float right, float bottom) {
+        float distance = std::min(std::min(px - left, right - px), std::min(py - top, bottom - py));
+        return std::max(0.0f, std::min(1.0f, distance + 0.5f));
+    };
+
+    PixelBox box = clip(minX - halfWidth - 1, minY - halfWidth - 1, maxX + halfWidth + 1, maxY + halfWidth + 1);
+    for (int32_t y = box.y0; y <= box.y1; y++) {
+        float py = y + 0.5f;
+        for (int32_t x = box.x0; x <= box.x1; x++) {
+            float px = x + 0.5f;
+            float outer = inside(px, py, minX - halfWidth, minY - halfWidth, maxX + halfWidth, maxY + halfWidth);
+            float inner = inside(px, py, minX + halfWidth, minY + halfWidth, maxX - halfWidth, maxY - halfWidth);
+            if (inner >= 1) {
+                // Skip the hole in one step
+                int32_t across = static_cast<int32_t>(std::floor(maxX - halfWidth - 1));
+                x = std::max(x, std::min(across, box.x1));
+                continue;
+            }
+            cover(x, y, std::min(peak, outer - inner));
+        }
+    }
+    composite(color);
+}
+
+void Rasterizer::strokeCircle(float cx, float cy, float radius, float width, uint32_t color) {
+    float centerX = pixelX(cx);
+    float centerY = pixelY(cy);
+    float r = radius * scale;
+    float halfWidth = width * scale / 2;
+    float peak = peakCoverage(halfWidth);
+    float reach = r + halfWidth + 1;
+
+    PixelBox box = clip(centerX - reach, centerY - reach, centerX + reach, centerY + reach);
+    for (int32_t y = box.y0; y <= box.y1; y++) {
+        float py = y + 0.5f - centerY;
+        for (int32_t x = box.x0; x <= box.x1; x++) {
+            float px = x + 0.5f - centerX;
+            float distance = std::abs(std::sqrt(px * px + py * py) - r);
+            cover(x, y, std::min(peak, halfWidth + 0.5f - distance));
+        }
+    }
+    composite(color);
+}
+
+void Rasterizer::composite(uint32_t color) {
+    if (dirtyEmpty) return;
+
+    float sourceRed = static_cast<float>(color & 0xff);
+    float sourceGreen = static_cast<float>((color >> 8) & 0xff);
+    float sourceBlue = static_cast<float>((color >> 16) & 0xff);
+    float sourceAlpha = static_cast<float>(color >> 24) / 255.0f;
+
+    for (int32_t y = dirty.y0; y <= dirty.y1; y++) {
+        for (int32_t x = dirty.x0; x <= dirty.x1; x++) {
+            size_t index = static_cast<size_t>(y) * imageWidth + x;
+            uint8_t coverage = mask[index];
+            if (coverage == 0) continue;
+            mask[index] = 0;
+
+            // Source-over on straight alpha
+            uint8_t* pixel = &rgba[index * 4];
+            float alpha = sourceAlpha * coverage / 255.0f;
+            float below = pixel[3] / 255.0f * (1 - alpha);
+            float out = alpha + below;
+            if (out <= 0) continue;
+            pixel[0] = static_cast<uint8_t>((sourceRed * alpha + pixel[0] * below) / out + 0.5f);
+            pixel[1] = static_cast<uint8_t>((sourceGreen * alpha + pixel[1] * below) / out + 0.5f);
+            pixel[2] = static_cast<uint8_t>((sourceBlue * alpha + pixel[2] * below) / out + 0.5f);
+            pixel[3] = static_cast<uint8_t>(out * 255.0f + 0.5f);
+        }
+    }
+    dirtyEmpty = true;
+}
@@ -0,0 +1,61 @@
+#include "../../include/wasm/simplify.hpp"
+
+// Squared distance from p to segment a-b (not the infinite line, so closed
+// loops whose endpoints coincide still measure sensibly)
+static float segmentDistanceSq(float px, float py, float ax, float ay, float bx, float by) {
+    float dx = bx - ax;
+    float dy = by - ay;
+    float lengthSq = dx * dx + dy * dy;
+    float t = 0;
+    if (lengthSq > 0) {
+        t = ((px - ax) * dx + (py - ay) * dy) / lengthSq;
+        t = t < 0 ? 0 : (t > 1 ? 1 : t);
+    }
+    float ex = px - (ax + t * dx);
+    float ey = py - (ay + t * dy);
+    return ex * ex + ey * ey;
+}
+
+size_t PolylineSimplifier::simplify(float* xs, float* ys, size_t count, float tolerance) {
+    if (count <= 2 || tolerance <= 0) return count;
+
+    float toleranceSq = tolerance * tolerance;
+    keep.assign(count, 0);
+    keep[0] = 1;
+    keep[count - 1] = 1;
+
+    stack.clear();
+    stack.push_back({0, static_cast<uint32_t>(count - 1)});
+
+    while (!stack.empty()) {
+        Range range = stack.back();
+        stack.pop_back();
+        if (range.last - range.first < 2) continue;
+
+        float worst = -1;
+        uint32_t worstIndex = range.first;
+        for (uint32_t i = range.first + 1; i < range.last; i++) {
+            float d = segmentDistanceSq(xs[i], ys[i], xs[range.first], ys[range.first],
+                                        xs[range.last], ys[range.last]);
+            if (d > worst) {
+                worst = d;
+                worstIndex = i;
+            }
+        }
+
+        if (worst > toleranceSq) {
+            keep[worstIndex] = 1;
+            stack.push_back({range.first, worstIndex});
+            stack.push_back({worstIndex, range.last});
+        }
+    }
+
+    size_t kept = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (!keep[i]) continue;
+        xs[kept] = xs[i];
+        ys[kept] = ys[i];
+        kept++;
+    }
+    return kept;
+}
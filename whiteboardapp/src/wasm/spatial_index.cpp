@@ -0,0 +1,154 @@
+#include "../../include/wasm/spatial_index.hpp"
+#include <algorithm>
+#include <cmath>
+
+SpatialGrid::SpatialGrid(float cellSize)
+    : cellSize(cellSize), inverseCellSize(1.0f / cellSize), queryStamp(0) {}
+
+void SpatialGrid::clear() {
+    cells.clear();
+    oversized.clear();
+    entries.clear();
+    visitStamps.clear();
+    queryStamp = 0;
+}
+
+void SpatialGrid::insert(uint32_t id, const Box& box) {
+    if (id >= entries.size()) {
+        entries.resize(id + 1);
+        visitStamps.resize(id + 1, 0);
+    }
+
+    Entry& entry = entries[id];
+    if (entry.live) unlink(id, entry);
+
+    entry.box = box;
+    entry.cells = rangeFor(box);
+    entry.live = true;
+    link(id, entry);
+}
+
+void SpatialGrid::update(uint32_t id, const Box& box) {
+    if (!contains(id)) {
+        insert(id, box);
+        return;
+    }
+
+    Entry& entry = entries[id];
+    entry.box = box;
+
+    // Most updates (small moves, a stroke growing inside its cells) keep the range
+    CellRange range = rangeFor(box);
+    if (range == entry.cells) return;
+
+    unlink(id, entry);
+    entry.cells = range;
+    link(id, entry);
+}
+
+void SpatialGrid::remove(uint32_t id) {
+    if (!contains(id)) return;
+
+    Entry& entry = entries[id];
+    unlink(id, entry);
+    entry.live = false;
+}
+
+bool SpatialGrid::contains(uint32_t id) const {
+    return id < entries.size() && entries[id].live;
+}
+
+void SpatialGrid::query(const Box& area, std::vector<uint32_t>& out) const {
+    out.clear();
+    if (area.isEmpty()) return;
+
+    // New stamp per query; on wrap-around reset so stale stamps cannot alias
+    if (++queryStamp == 0) {
+        std::fill(visitStamps.begin(), visitStamps.end(), 0);
+        queryStamp = 1;
+    }
+
+    auto consider = [&](uint32_t id) {
+        if (markVisited(id) && entries[id].box.intersects(area)) {
+            out.push_back(id);
+        }
+    };
+
+    CellRange range = rangeFor(area);
+    if (range.cellCount() > static_cast<int64_t>(cells.size())) {
+        // Query covers more cells than are occupied: walk the occupied ones instead
+        for (const auto& cell : cells) {
+            for (uint32_t id : cell.second) consider(id);
+        }
+    } else {
+        for (int32_t cy = range.y0; cy <= range.y1; cy++) {
+            for (int32_t cx = range.x0; cx <= range.x1; cx++) {
+                auto it = cells.find(cellKey(cx, cy));
+                if (it == cells.end()) continue;
+                for (uint32_t id : it->second) consider(id);
+            }
+        }
+    }
+
+    for (uint32_t id : oversized) consider(id);
+
+    std::sort(out.begin(), out.end());
+}
+
+SpatialGrid::CellRange SpatialGrid::rangeFor(const Box& box) const {
+    // Clamp before converting so huge coordinates cannot overflow int32
+    auto toCell = [this](float v) {
+        float c = std::floor(v * inverseCellSize);
+        return static_cast<int32_t>(std::max(-1.0e9f, std::min(1.0e9f, c)));
+    };
+    return {toCell(box.minX), toCell(box.minY), toCell(box.maxX), toCell(box.maxY)};
+}
+
+void SpatialGrid::link(uint32_t id, Entry& entry) {
+    entry.oversized = entry.cells.cellCount() > MAX_CELLS_PER_ELEMENT;
+    if (entry.oversized) {
+        oversized.push_back(id);
+        return;
+    }
+
+    for (int32_t cy = entry.cells.y0; cy <= entry.cells.y1; cy++) {
+        for (int32_t cx = entry.cells.x0; cx <= entry.cells.x1; cx++) {
+            cells[cellKey(cx, cy)].push_back(id);
+        }
+    }
+}
+
+void SpatialGrid::unlink(uint32_t id, Entry& entry) {
+    auto eraseId = [id](std::vector<uint32_t>& ids) {
+        auto it = std::find(ids.begin(), ids.end(), id);
+        if (it != ids.end()) {
+            *it = ids.back();
+            ids.pop_back();
+        }
+    };
+
+    if (entry.oversized) {
+        eraseId(oversized);
+        return;
+    }
+
+    for (int32_t cy = entry.cells.y0; cy <= entry.cells.y1; cy++) {
+        for (int32_t cx = entry.cells.x0; cx <= entry.cells.x1; cx++) {
+            auto it = cells.find(cellKey(cx, cy));
+            if (it == cells.end()) continue;
+            eraseId(it->second);
+            if (it->second.empty()) cells.erase(it);
+        }
+    }
+}
+
+uint64_t SpatialGrid::cellKey(int32_t cx, int32_t cy) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(cx)) << 32) |
+           static_cast<uint32_t>(cy);
+}
+
+bool SpatialGrid::markVisited(uint32_t id) const {
+    if (visitStamps[id] == queryStamp) return false;
+    visitStamps[id] = queryStamp;
+    return true;
+}
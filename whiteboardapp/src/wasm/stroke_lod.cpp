@@ -0,0 +1,52 @@
+#include "../../include/wasm/stroke_lod.hpp"
+#include "../../include/wasm/point_kernels.hpp"
+#include <algorithm>
+#include <cmath>
+
+uint32_t StrokeLod::levelFor(float scale) {
+    if (!(scale < 1)) return 0;
+    // Level k covers scales in (2^-(k+1), 2^-k]
+    float level = std::floor(-std::log2(scale));
+    return static_cast<uint32_t>(std::min(static_cast<float>(LEVELS), level));
+}
+
+uint32_t StrokeLod::build(const float* xs, const float* ys, uint32_t count) {
+    uint32_t handle;
+    if (!freed.empty()) {
+        handle = freed.back();
+        freed.pop_back();
+    } else {
+        handle = static_cast<uint32_t>(pyramids.size());
+        pyramids.emplace_back();
+    }
+
+    scratchX.assign(xs, xs + count);
+    scratchY.assign(ys, ys + count);
+    size_t kept = count;
+    for (uint32_t level = 1; level <= LEVELS; level++) {
+        // Two points cannot be simplified further; later levels just repeat them
+        if (kept > 2) kept = simplifier.simplify(scratchX.data(), scratchY.data(), kept, tolerance(level));
+
+        uint32_t stroke = store.create();
+        for (size_t i = 0; i < kept; i++) store.append(stroke, scratchX[i], scratchY[i]);
+        pyramids[handle][level - 1] = stroke;
+    }
+    return handle;
+}
+
+void StrokeLod::release(uint32_t handle) {
+    for (uint32_t stroke : pyramids[handle]) store.release(stroke);
+    freed.push_back(handle);
+}
+
+void StrokeLod::translate(uint32_t handle, float dx, float dy) {
+    for (uint32_t stroke : pyramids[handle]) {
+        translatePoints(store.xs(stroke), store.ys(stroke), store.size(stroke), dx, dy);
+    }
+}
+
+void StrokeLod::clear() {
+    store.clear();
+    pyramids.clear();
+    freed.clear();
+}
@@ -0,0 +1,140 @@
+#include "../../include/wasm/stroke_store.hpp"
+#include <algorithm>
+
+// ColorTable implementation
+uint16_t ColorTable::intern(const std::string& color) {
+    auto it = ids.find(color);
+    if (it != ids.end()) return it->second;
+
+    // Colors come from peers and loaded scenes, so the table can fill up
+    if (colors.size() >= CAPACITY) return FULL_FALLBACK;
+
+    uint16_t id = static_cast<uint16_t>(colors.size());
+    colors.push_back(color);
+    ids.emplace(color, id);
+    return id;
+}
+
+void ColorTable::clear() {
+    colors.clear();
+    ids.clear();
+}
+
+// StrokeStore implementation
+uint32_t StrokeStore::create() {
+    uint32_t stroke;
+    if (!freed.empty()) {
+        stroke = freed.back();
+        freed.pop_back();
+    } else {
+        stroke = static_cast<uint32_t>(spans.size());
+        spans.emplace_back();
+    }
+
+    // An empty span at the end of the pool grows in place on first append
+    Span& span = spans[stroke];
+    span.offset = static_cast<uint32_t>(pointsX.size());
+    span.length = 0;
+    span.capacity = 0;
+    span.used = true;
+    return stroke;
+}
+
+void StrokeStore::release(uint32_t stroke) {
+    Span& span = spans[stroke];
+    if (!span.used) return;
+
+    live -= span.length;
+    reserved -= span.capacity;
+    span = Span();
+    freed.push_back(stroke);
+
+    compactIfWasteful();
+}
+
+void StrokeStore::clear() {
+    pointsX.clear();
+    pointsY.clear();
+    spans.clear();
+    freed.clear();
+    live = 0;
+    reserved = 0;
+}
+
+void StrokeStore::append(uint32_t stroke, float x, float y) {
+    Span& span = spans[stroke];
+
+    if (span.length == span.capacity) {
+        uint32_t grow = std::max(MIN_CAPACITY, span.capacity);
+        if (span.offset + span.capacity == pointsX.size()) {
+            // Tail span: extend the pools, no copy needed
+            pointsX.resize(pointsX.size() + grow);
+            pointsY.resize(pointsY.size() + grow);
+            span.capacity += grow;
+            reserved += grow;
+        } else {
+            relocate(span, span.capacity + grow);
+        }
+    }
+
+    pointsX[span.offset + span.length] = x;
+    pointsY[span.offset + span.length] = y;
+    span.length++;
+    live++;
+}
+
+void StrokeStore::truncate(uint32_t stroke, uint32_t length) {
+    Span& span = spans[stroke];
+    if (length >= span.length) return;
+
+    live -= span.length - length;
+    span.length = length;
+}
+
+void StrokeStore::relocate(Span& span, uint32_t capacity) {
+    uint32_t offset = static_cast<uint32_t>(pointsX.size());
+    pointsX.resize(offset + capacity);
+    pointsY.resize(offset + capacity);
+
+    std::copy_n(pointsX.begin() + span.offset, span.length, pointsX.begin() + offset);
+    std::copy_n(pointsY.begin() + span.offset, span.length, pointsY.begin() + offset);
+
+    reserved += capacity - span.capacity;
+    span.offset = offset;
+    span.capacity = capacity;
+}
+
+void StrokeStore::compactIfWasteful() {
+    size_t holes = pointsX.size() - reserved;
+    if (holes < MIN_GARBAGE_TO_COMPACT || holes * 2 < reserved) return;
+
+    // Repack live spans in their current pool order to keep locality
+    std::vector<uint32_t> order;
+    order.reserve(spans.size() - freed.size());
+    for (uint32_t i = 0; i < spans.size(); i++) {
+        if (spans[i].used) order.push_back(i);
+    }
+    std::sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b) {
+        return spans[a].offset < spans[b].offset;
+    });
+
+    std::vector<float> packedX;
+    std::vector<float> packedY;
+    packedX.reserve(live);
+    packedY.reserve(live);
+
+    for (uint32_t stroke : order) {
+        Span& span = spans[stroke];
+        uint32_t offset = static_cast<uint32_t>(packedX.size());
+        packedX.insert(packedX.end(), pointsX.begin() + span.offset,
+                       pointsX.begin() + span.offset + span.length);
+        packedY.insert(packedY.end(), pointsY.begin() + span.offset,
+                       pointsY.begin() + span.offset + span.length);
+        span.offset = offset;
+        span.capacity = span.length;
+    }
+
+    pointsX.swap(packedX);
+    pointsY.swap(packedY);
+    reserved = live;
+}
@@ -0,0 +1,140 @@
+#include "../../include/wasm/svg_writer.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+void SvgWriter::setDecimals(uint32_t value) {
+    decimals = std::min(value, MAX_DECIMALS);
+    unit = 1;
+    for (uint32_t i = 0; i < decimals; i++) unit *= 10;
+}
+
+void SvgWriter::text(const char* value) {
+    buffer.insert(buffer.end(), value, value + std::strlen(value));
+}
+
+void SvgWriter::number(float value) {
+    fixed(quantize(value));
+}
+
+void SvgWriter::attribute(const char* name, const std::string& value) {
+    buffer.push_back(' ');
+    text(name);
+    text("=\"");
+    for (char c : value) {
+        switch (c) {
+            case '"': text("&quot;"); break;
+            case '&': text("&amp;"); break;
+            case '<': text("&lt;"); break;
+            default: buffer.push_back(static_cast<uint8_t>(c)); break;
+        }
+    }
+    buffer.push_back('"');
+}
+
+void SvgWriter::attribute(const char* name, float value) {
+    buffer.push_back(' ');
+    text(name);
+    text("=\"");
+    number(value);
+    buffer.push_back('"');
+}
+
+void SvgWriter::pathData(const float* xs, const float* ys, uint32_t count) {
+    text(" d=\"");
+    if (count > 0) {
+        int64_t lastX = quantize(xs[0]);
+        int64_t lastY = quantize(ys[0]);
+        buffer.push_back('M');
+        fixed(lastX);
+        buffer.push_back(' ');
+        fixed(lastY);
+
+        bool relative = false;
+        for (uint32_t i = 1; i < count; i++) {
+            int64_t x = quantize(xs[i]);
+            int64_t y = quantize(ys[i]);
+            if (x == lastX && y == lastY) continue;
+
+            // After "l", further pairs are implicit; a minus sign separates on its own
+            int64_t dx = x - lastX;
+            int64_t dy = y - lastY;
+            if (!relative) {
+                buffer.push_back('l');
+                relative = true;
+            } else if (dx >= 0) {
+                buffer.push_back(' ');
+            }
+            fixed(dx);
+            if (dy >= 0) buffer.push_back(' ');
+            fixed(dy);
+            lastX = x;
+            lastY = y;
+        }
+    }
+    buffer.push_back('"');
+}
+
+void SvgWriter::curveData(const float* xs, const float* ys, uint32_t count) {
+    text(" d=\"");
+    if (count > 0) {
+        int64_t lastX = quantize(xs[0]);
+        int64_t lastY = quantize(ys[0]);
+        buffer.push_back('M');
+        fixed(lastX);
+        buffer.push_back(' ');
+        fixed(lastY);
+
+        if (count >= 4) buffer.push_back('c');
+        for (uint32_t i = 1; i + 2 < count; i += 3) {
+            int64_t x = quantize(xs[i + 2]);
+            int64_t y = quantize(ys[i + 2]);
+            delta(quantize(xs[i]) - lastX, quantize(ys[i]) - lastY, i == 1);
+            delta(quantize(xs[i + 1]) - lastX, quantize(ys[i + 1]) - lastY, false);
+            delta(x - lastX, y - lastY, false);
+            lastX = x;
+            lastY = y;
+        }
+    }
+    buffer.push_back('"');
+}
+
+void SvgWriter::delta(int64_t dx, int64_t dy, bool first) {
+    if (!first && dx >= 0) buffer.push_back(' ');
+    fixed(dx);
+    if (dy >= 0) buffer.push_back(' ');
+    fixed(dy);
+}
+
+int64_t SvgWriter::quantize(float value) const {
+    if (!std::isfinite(value)) return 0;
+    // Keep far-off coordinates representable; the board never gets near this
+    double scaled = std::max(-1.0e15, std::min(1.0e15, static_cast<double>(value) * unit));
+    return static_cast<int64_t>(std::llround(scaled));
+}
+
+void SvgWriter::fixed(int64_t scaled) {
+    if (scaled < 0) {
+        buffer.push_back('-');
+        scaled = -scaled;
+    }
+    int64_t whole = scaled / unit;
+    int64_t fraction = scaled % unit;
+
+    char digits[24];
+    int length = 0;
+    do {
+        digits[length++] = static_cast<char>('0' + whole % 10);
+        whole /= 10;
+    } while (whole > 0);
+    while (length > 0) buffer.push_back(static_cast<uint8_t>(digits[--length]));
+
+    if (fraction == 0) return;
+    buffer.push_back('.');
+    int64_t place = unit / 10;
+    while (fraction > 0) {
+        buffer.push_back(static_cast<uint8_t>('0' + fraction / place));
+        fraction %= place;
+        place /= 10;
+    }
+}
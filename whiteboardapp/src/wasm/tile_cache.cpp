@@ -0,0 +1,73 @@
+#include "../../include/wasm/tile_cache.hpp"
+#include <algorithm>
+#include <cmath>
+
+TileCache::TileCache(float tilePixels) : tilePixels(tilePixels), tileSize(tilePixels) {}
+
+void TileCache::setZoom(float zoom) {
+    if (zoom == tileZoom) return;
+    tileZoom = zoom;
+    tileSize = tilePixels / zoom;
+    states.clear();
+}
+
+TileCache::State TileCache::state(int32_t tx, int32_t ty) const {
+    auto it = states.find(key(tx, ty));
+    return it == states.end() ? State::STALE : it->second;
+}
+
+void TileCache::setState(int32_t tx, int32_t ty, State state) {
+    if (state == State::STALE) {
+        states.erase(key(tx, ty));
+    } else {
+        states[key(tx, ty)] = state;
+    }
+}
+
+void TileCache::invalidate(const Box& area) {
+    if (area.isEmpty() || states.empty()) return;
+
+    Range range = rangeFor(area);
+    int64_t count = int64_t(range.x1 - range.x0 + 1) * int64_t(range.y1 - range.y0 + 1);
+
+    if (count > static_cast<int64_t>(states.size())) {
+        // Area covers more tiles than are cached: test the cached ones instead
+        for (auto it = states.begin(); it != states.end();) {
+            int32_t tx = static_cast<int32_t>(it->first >> 32);
+            int32_t ty = static_cast<int32_t>(it->first & 0xffffffffu);
+            if (tx >= range.x0 && tx <= range.x1 && ty >= range.y0 && ty <= range.y1) {
+                it = states.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        return;
+    }
+
+    for (int32_t ty = range.y0; ty <= range.y1; ty++) {
+        for (int32_t tx = range.x0; tx <= range.x1; tx++) {
+            states.erase(key(tx, ty));
+        }
+    }
+}
+
+void TileCache::clear() {
+    states.clear();
+}
+
+TileCache::Range TileCache::rangeFor(const Box& area) const {
+    auto toTile = [this](float v) {
+        float t = std::floor(v / tileSize);
+        return static_cast<int32_t>(std::max(-1.0e9f, std::min(1.0e9f, t)));
+    };
+    return {toTile(area.minX), toTile(area.minY), toTile(area.maxX), toTile(area.maxY)};
+}
+
+Box TileCache::tileBox(int32_t tx, int32_t ty) const {
+    return {tx * tileSize, ty * tileSize, (tx + 1) * tileSize, (ty + 1) * tileSize};
+}
+
+uint64_t TileCache::key(int32_t tx, int32_t ty) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(tx)) << 32) |
+           static_cast<uint32_t>(ty);
+}
@@ -1,329 +1,2432 @@
 #include "../../include/wasm/whiteboard.hpp"
 
-// Line implementation
-void Line::draw(emscripten::val context) {
-    if (points.empty()) return;
+// Whiteboard implementation
+
+Box Whiteboard::inkBounds(Box box, float thickness) {
+    float pad = thickness / 2 + 2;
+    box.minX -= pad;
+    box.minY -= pad;
+    box.maxX += pad;
+    box.maxY += pad;
+    return box;
+}
+
+Box Whiteboard::elementInk(uint32_t id) const {
+    return visitElement(id, [](const auto& element) { return inkBounds(elementBounds(element), element.thickness); });
+}
+
+bool Whiteboard::isLive(uint32_t id) const {
+    if (beingDrawn(id)) return true;
+    return visitElement(id, [](const auto& element) { return element.selected; });
+}
+
+void Whiteboard::finishStroke() {
+    clearPrediction();
+    if (hasRawPoint) {
+        // Smoothing lags the pen; end the stroke where it actually lifted
+        hasRawPoint = false;
+        if (ink.smoothing()) continueDrawing(rawPoint.x, rawPoint.y);
+    }
+    bool pending = hasPendingPoint;
+    hasPendingPoint = false;
+    if (currentId == NO_ELEMENT || !index.contains(currentId)) return;
+    if (refs[currentId].kind != ElementKind::LINE) return;
+
+    Line& line = lines[refs[currentId].index];
+    uint32_t last = strokes.size(line.stroke) - 1;
+    if (pending && (pendingPoint.x != strokes.xs(line.stroke)[last] ||
+                    pendingPoint.y != strokes.ys(line.stroke)[last])) {
+        continueDrawingPoint(line, pendingPoint.x, pendingPoint.y);
+    }
+    float tolerance = simplifyTolerance;
+    if (streamId == line.id) {
+        // Peers simplify the quantized points they received; snapping ours
+        // to the same grid makes both sides keep exactly the same points
+        flushStreamPoints();
+        int64_t quantizedTolerance = quantize(simplifyTolerance, SCENE_QUANTIZATION);
+        outgoing.u8(static_cast<uint8_t>(StreamOp::END));
+        outgoing.varint(line.uid);
+        outgoing.varint(quantizedTolerance);
+        streamId = NO_ELEMENT;
+
+        const float step = 1.0f / SCENE_QUANTIZATION;
+        float* xs = strokes.xs(line.stroke);
+        float* ys = strokes.ys(line.stroke);
+        for (uint32_t i = 0; i < strokes.size(line.stroke); i++) {
+            xs[i] = static_cast<float>(quantize(xs[i], SCENE_QUANTIZATION)) * step;
+            ys[i] = static_cast<float>(quantize(ys[i], SCENE_QUANTIZATION)) * step;
+        }
+        recomputeBounds(line);
+        index.update(line.id, line.bounds);
+        tolerance = static_cast<float>(quantizedTolerance) * step;
+    }
+    simplifyLine(line, tolerance);
+}
 
-    context.call<void>("beginPath");
-    context.set("strokeStyle", color);
-    context.set("lineWidth", thickness);
-    context.set("lineCap", std::string("round"));
-    context.set("lineJoin", std::string("round"));
+void Whiteboard::simplifyLine(Line& line, float tolerance) {
+    dropLod(line);
+    if (tolerance <= 0) return;
 
-    context.call<void>("moveTo", points[0].x, points[0].y);
-    for (size_t i = 1; i < points.size(); i++) {
-        context.call<void>("lineTo", points[i].x, points[i].y);
+    uint32_t count = strokes.size(line.stroke);
+    size_t kept = simplifier.simplify(strokes.xs(line.stroke), strokes.ys(line.stroke),
+                                      count, tolerance);
+    if (kept == count) return;
+
+    // The unsimplified stroke is on screen; repaint its area
+    damageElement(line.id);
+    strokes.truncate(line.stroke, static_cast<uint32_t>(kept));
+    recomputeBounds(line);
+    index.update(line.id, line.bounds);
+}
+
+void Whiteboard::commitCurrent() {
+    if (currentId == NO_ELEMENT) return;
+    uint32_t id = currentId;
+    currentId = NO_ELEMENT;
+    commitElement(id);
+    if (!applyingRemote && index.contains(id)) replicas.created(uidOf(id));
+
+    if (recordHistory && index.contains(id)) {
+        HistoryEntry entry;
+        entry.kind = HistoryEntry::Kind::ADD;
+        entry.ids.push_back(id);
+        history.record(std::move(entry));
+        history.closeStep();
     }
-    context.call<void>("stroke");
+}
+
+void Whiteboard::commitElement(uint32_t id) {
+    if (!index.contains(id)) return;
+    Box ink = elementInk(id);
+    tiles.invalidate(ink);
+    damage.add(ink);
+}
 
-    // Draw selection outline if selected
-    if (selected) {
-        Rect bounds = getBounds();
-        context.set("strokeStyle", "#0095ff");
-        context.set("lineWidth", 2);
-        context.call<void>("strokeRect", bounds.x - 5, bounds.y - 5, 
-                          bounds.width + 10, bounds.height + 10);
+void Whiteboard::touchElement(uint32_t id) {
+    damageElement(id);
+    if (!isLive(id)) tiles.invalidate(elementInk(id));
+}
+
+void Whiteboard::translateElement(uint32_t id, float dx, float dy) {
+    translateGeometry(id, dx, dy);
+    commitTranslation(id, dx, dy);
+}
+
+void Whiteboard::translateGeometry(uint32_t id, float dx, float dy) {
+    const ElementRef& ref = refs[id];
+    if (ref.kind == ElementKind::LINE) {
+        Line& line = lines[ref.index];
+        translatePoints(strokes.xs(line.stroke), strokes.ys(line.stroke),
+                        strokes.size(line.stroke), dx, dy);
+        if (line.lod != StrokeLod::NONE) lods.translate(line.lod, dx, dy);
+        if (line.curve != NO_CURVE) {
+            translatePoints(curves.xs(line.curve), curves.ys(line.curve), curves.size(line.curve), dx, dy);
+        }
+    } else {
+        Shape& shape = shapes[ref.index];
+        shape.start.x += dx;
+        shape.start.y += dy;
+        shape.end.x += dx;
+        shape.end.y += dy;
     }
 }
 
-bool Line::containsPoint(float x, float y) {
-    for (size_t i = 1; i < points.size(); i++) {
-        float x1 = points[i-1].x, y1 = points[i-1].y;
-        float x2 = points[i].x, y2 = points[i].y;
-        
-        float distance = std::abs((y2-y1)*x - (x2-x1)*y + x2*y1 - y2*x1) /
-                        std::sqrt((y2-y1)*(y2-y1) + (x2-x1)*(x2-x1));
-        
-        if (distance < 5.0f) return true;
+void Whiteboard::commitTranslation(uint32_t id, float dx, float dy) {
+    const ElementRef& ref = refs[id];
+    if (ref.kind == ElementKind::LINE) {
+        Line& line = lines[ref.index];
+        line.bounds.translate(dx, dy);
+        index.update(id, line.bounds);
+    } else {
+        index.update(id, shapeBounds(shapes[ref.index]));
+    }
+
+    if (!applyingRemote && id != currentId) {
+        ElementReplica& replica = replicas.write(uidOf(id), ReplicaSet::OFFSET);
+        replica.ox += dx;
+        replica.oy += dy;
     }
-    return false;
 }
 
-void Line::move(float dx, float dy) {
-    for (auto& point : points) {
-        point.x += dx;
-        point.y += dy;
+ElementSnapshot Whiteboard::snapshotElement(uint32_t id) const {
+    ElementSnapshot snapshot;
+    snapshot.id = id;
+    const ElementRef& ref = refs[id];
+    snapshot.isLine = ref.kind == ElementKind::LINE;
+    if (snapshot.isLine) {
+        const Line& line = lines[ref.index];
+        uint32_t count = strokes.size(line.stroke);
+        snapshot.uid = line.uid;
+        snapshot.shapeType = static_cast<uint8_t>(ShapeType::FREEHAND);
+        snapshot.color = line.color;
+        snapshot.thickness = line.thickness;
+        snapshot.x0 = snapshot.y0 = snapshot.x1 = snapshot.y1 = 0;
+        snapshot.xs.assign(strokes.xs(line.stroke), strokes.xs(line.stroke) + count);
+        snapshot.ys.assign(strokes.ys(line.stroke), strokes.ys(line.stroke) + count);
+    } else {
+        const Shape& shape = shapes[ref.index];
+        snapshot.uid = shape.uid;
+        snapshot.shapeType = static_cast<uint8_t>(shape.type);
+        snapshot.color = shape.color;
+        snapshot.thickness = shape.thickness;
+        snapshot.x0 = shape.start.x;
+        snapshot.y0 = shape.start.y;
+        snapshot.x1 = shape.end.x;
+        snapshot.y1 = shape.end.y;
     }
+    return snapshot;
 }
 
-Rect Line::getBounds() {
-    if (points.empty()) return {0, 0, 0, 0};
-    
-    float minX = points[0].x, maxX = points[0].x;
-    float minY = points[0].y, maxY = points[0].y;
-    
-    for (const auto& point : points) {
-        minX = std::min(minX, point.x);
-        maxX = std::max(maxX, point.x);
-        minY = std::min(minY, point.y);
-        maxY = std::max(maxY, point.y);
+uint32_t Whiteboard::restoreElement(const ElementSnapshot& snapshot) {
+    // A removed element still waiting for compaction would share the id
+    flushRemovals();
+    uint32_t id = snapshot.id;
+    maxInkPad = std::max(maxInkPad, snapshot.thickness / 2 + 2);
+
+    // A peer's re-add may have brought the uid back under another id
+    uint32_t live = findUid(snapshot.uid);
+    if (live != NO_ELEMENT) id = live;
+
+    if (index.contains(id)) {
+        touchElement(id);
+        bool restyled;
+        if (snapshot.isLine) {
+            Line& line = lines[refs[id].index];
+            restyled = line.color != snapshot.color || line.thickness != snapshot.thickness;
+            line.color = snapshot.color;
+            line.thickness = snapshot.thickness;
+            strokes.truncate(line.stroke, 0);
+            line.bounds = Box();
+            for (size_t i = 0; i < snapshot.xs.size(); i++) addPoint(line, snapshot.xs[i], snapshot.ys[i]);
+            index.update(id, line.bounds);
+        } else {
+            Shape& shape = shapes[refs[id].index];
+            restyled = shape.color != snapshot.color || shape.thickness != snapshot.thickness;
+            shape.color = snapshot.color;
+            shape.thickness = snapshot.thickness;
+            shape.start = {snapshot.x0, snapshot.y0};
+            shape.end = {snapshot.x1, snapshot.y1};
+            index.update(id, shapeBounds(shape));
+        }
+        touchElement(id);
+        if (!applyingRemote) {
+            replicas.write(snapshot.uid, ReplicaSet::GEOMETRY);
+            if (restyled) replicas.write(snapshot.uid, ReplicaSet::STYLE);
+        }
+        return id;
+    }
+
+    uidToId[snapshot.uid] = id;
+    if (!applyingRemote) {
+        replicas.restored(snapshot.uid);
+        replicas.write(snapshot.uid, ReplicaSet::GEOMETRY);
+    }
+    if (snapshot.isLine) {
+        Line line;
+        line.id = id;
+        line.uid = snapshot.uid;
+        line.stroke = strokes.create();
+        line.color = snapshot.color;
+        line.thickness = snapshot.thickness;
+        for (size_t i = 0; i < snapshot.xs.size(); i++) addPoint(line, snapshot.xs[i], snapshot.ys[i]);
+        index.insert(id, line.bounds);
+        insertInOrder(lines, std::move(line));
+    } else {
+        Shape shape;
+        shape.id = id;
+        shape.uid = snapshot.uid;
+        shape.type = static_cast<ShapeType>(snapshot.shapeType);
+        shape.color = snapshot.color;
+        shape.thickness = snapshot.thickness;
+        shape.start = {snapshot.x0, snapshot.y0};
+        shape.end = {snapshot.x1, snapshot.y1};
+        index.insert(id, shapeBounds(shape));
+        insertInOrder(shapes, std::move(shape));
     }
-    
-    return {minX, minY, maxX - minX, maxY - minY};
+    touchElement(id);
+    return id;
 }
 
-// Rectangle implementation
-void Rectangle::draw(emscripten::val context) {
-    context.set("strokeStyle", color);
-    context.set("lineWidth", thickness);
-    context.call<void>("strokeRect", bounds.x, bounds.y, bounds.width, bounds.height);
+void Whiteboard::restoreElements(const std::vector<ElementSnapshot>& elements, std::vector<uint32_t>& ids) {
+    ids.clear();
+    for (const auto& element : elements) ids.push_back(restoreElement(element));
+    std::sort(ids.begin(), ids.end());
+}
 
-    if (selected) {
-        context.set("strokeStyle", "#0095ff");
-        context.set("lineWidth", 2);
-        context.call<void>("strokeRect", bounds.x - 5, bounds.y - 5, 
-                          bounds.width + 10, bounds.height + 10);
+void Whiteboard::removeElements(const std::vector<uint32_t>& ids) {
+    bool linesRemoved = false;
+    bool shapesRemoved = false;
+    for (uint32_t id : ids) {
+        if (!index.contains(id)) continue;
+        touchElement(id);
+        auto selected = std::lower_bound(selectedIds.begin(), selectedIds.end(), id);
+        if (selected != selectedIds.end() && *selected == id) selectedIds.erase(selected);
+        if (!applyingRemote) replicas.removed(uidOf(id));
+        index.remove(id);
+        if (refs[id].kind == ElementKind::LINE) {
+            linesRemoved = true;
+        } else {
+            shapesRemoved = true;
+        }
+    }
+    if (linesRemoved) {
+        compact(lines, [this](const Line& line) { return !index.contains(line.id); });
+    }
+    if (shapesRemoved) {
+        compact(shapes, [this](const Shape& shape) { return !index.contains(shape.id); });
     }
 }
 
-bool Rectangle::containsPoint(float x, float y) {
-    return x >= bounds.x && x <= bounds.x + bounds.width &&
-           y >= bounds.y && y <= bounds.y + bounds.height;
+void Whiteboard::recordErased(HistoryEntry*& step, ElementSnapshot original) {
+    if (!recordHistory) return;
+    openEraseStep(step);
+    auto position = std::lower_bound(step->ids.begin(), step->ids.end(), original.id);
+    if (position != step->ids.end() && *position == original.id) return;
+    step->ids.insert(position, original.id);
+    step->elements.push_back(std::move(original));
 }
 
-void Rectangle::move(float dx, float dy) {
-    bounds.x += dx;
-    bounds.y += dy;
+void Whiteboard::openEraseStep(HistoryEntry*& step) {
+    if (step) return;
+    step = history.openEntry(HistoryEntry::Kind::ERASE);
+    if (step) return;
+    HistoryEntry entry;
+    entry.kind = HistoryEntry::Kind::ERASE;
+    history.record(std::move(entry));
+    step = history.openEntry(HistoryEntry::Kind::ERASE);
 }
 
-// Circle implementation
-void Circle::draw(emscripten::val context) {
-    context.call<void>("beginPath");
-    context.set("strokeStyle", color);
-    context.set("lineWidth", thickness);
-    context.call<void>("arc", center.x, center.y, radius, 0, 2 * M_PI);
-    context.call<void>("stroke");
+bool Whiteboard::erasedAlready(uint32_t id) {
+    if (!recordHistory) return true;
+    HistoryEntry* step = history.openEntry(HistoryEntry::Kind::ERASE);
+    return step && (std::binary_search(step->ids.begin(), step->ids.end(), id) ||
+                    std::binary_search(step->added.begin(), step->added.end(), id));
+}
 
-    if (selected) {
-        context.set("strokeStyle", "#0095ff");
-        context.set("lineWidth", 2);
-        Rect bounds = getBounds();
-        context.call<void>("strokeRect", bounds.x - 5, bounds.y - 5, 
-                          bounds.width + 10, bounds.height + 10);
+Box Whiteboard::viewBox() const {
+    return {viewX, viewY, viewX + viewWidth / viewScale, viewY + viewHeight / viewScale};
+}
+
+void Whiteboard::queryVisible(std::vector<uint32_t>& out) const {
+    Box area;
+    if (hasViewSize()) {
+        // Pad so strokes whose ink (not bounds) reaches the view are kept
+        area = viewBox();
+        area.minX -= maxInkPad;
+        area.minY -= maxInkPad;
+        area.maxX += maxInkPad;
+        area.maxY += maxInkPad;
+    } else {
+        area = {std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(),
+                std::numeric_limits<float>::max(), std::numeric_limits<float>::max()};
     }
+    index.query(area, out);
 }
 
-bool Circle::containsPoint(float x, float y) {
-    float dx = x - center.x;
-    float dy = y - center.y;
-    return (dx * dx + dy * dy) <= (radius * radius);
+Box Whiteboard::selectionBox() const {
+    return {std::min(selectionStart.x, selectionEnd.x), std::min(selectionStart.y, selectionEnd.y),
+            std::max(selectionStart.x, selectionEnd.x), std::max(selectionStart.y, selectionEnd.y)};
 }
 
-void Circle::move(float dx, float dy) {
-    center.x += dx;
-    center.y += dy;
+void Whiteboard::damageSelectionBox() {
+    Box box = selectionBox();
+    const float pad = 2;
+    damage.add({box.minX - pad, box.minY - pad, box.maxX + pad, box.minY + pad});
+    damage.add({box.minX - pad, box.maxY - pad, box.maxX + pad, box.maxY + pad});
+    damage.add({box.minX - pad, box.minY - pad, box.minX + pad, box.maxY + pad});
+    damage.add({box.maxX - pad, box.minY - pad, box.maxX + pad, box.maxY + pad});
 }
 
-Rect Circle::getBounds() {
-    return {center.x - radius, center.y - radius, radius * 2, radius * 2};
+uint32_t Whiteboard::linePoints(Line& line, const float*& xs, const float*& ys) {
+    uint32_t count = strokes.size(line.stroke);
+    if (lodLevel == 0 || count < StrokeLod::MIN_POINTS || beingDrawn(line.id)) {
+        xs = strokes.xs(line.stroke);
+        ys = strokes.ys(line.stroke);
+        return count;
+    }
+    if (line.lod == StrokeLod::NONE) line.lod = lods.build(strokes.xs(line.stroke), strokes.ys(line.stroke), count);
+    xs = lods.xs(line.lod, lodLevel);
+    ys = lods.ys(line.lod, lodLevel);
+    return lods.size(line.lod, lodLevel);
 }
 
-// Whiteboard implementation
-Whiteboard::Whiteboard() 
-    : currentColor("#000000"), currentThickness(2.0f), 
-      currentShape(ShapeType::FREEHAND), isSelecting(false) {
-    init();
+uint32_t Whiteboard::lineCurve(Line& line, const float*& xs, const float*& ys) {
+    if (line.curve == NO_CURVE) {
+        uint32_t count = strokes.size(line.stroke);
+        if (curveTolerance <= 0 || count < MIN_CURVE_POINTS || beingDrawn(line.id)) return 0;
+        fitter.fit(strokes.xs(line.stroke), strokes.ys(line.stroke), count, curveTolerance, curveXs, curveYs);
+        // A noisy stroke can need more curve points than it has; the empty
+        // curve remembers not to fit it again
+        line.curve = curves.create();
+        if (curveXs.size() < count) {
+            for (size_t i = 0; i < curveXs.size(); i++) curves.append(line.curve, curveXs[i], curveYs[i]);
+        }
+    }
+    if (curves.size(line.curve) < 4) return 0;
+    xs = curves.xs(line.curve);
+    ys = curves.ys(line.curve);
+    return curves.size(line.curve);
 }
 
-void Whiteboard::init() {
-    elements.clear();
-    selectedElements.clear();
-    currentElement = nullptr;
-    isSelecting = false;
+void Whiteboard::dropLod(Line& line) {
+    if (line.lod != StrokeLod::NONE) {
+        lods.release(line.lod);
+        line.lod = StrokeLod::NONE;
+    }
+    if (line.curve != NO_CURVE) {
+        curves.release(line.curve);
+        line.curve = NO_CURVE;
+        line.curveLoaded = false;
+    }
 }
 
-void Whiteboard::startDrawing(float x, float y) {
-    if (isSelecting) {
-        startSelection(x, y);
-        return;
+void Whiteboard::encodeLine(Line& line) {
+    const float* xs;
+    const float* ys;
+    // Zoomed out, the pyramid has fewer points than the curve needs
+    uint32_t curveCount = lodLevel == 0 ? lineCurve(line, xs, ys) : 0;
+    uint32_t count = curveCount > 0 ? curveCount : linePoints(line, xs, ys);
+    if (count == 0) return;
+
+    commands.beginPath();
+    commands.strokeStyle(colors.name(line.color));
+    commands.lineWidth(line.thickness);
+    commands.roundCaps();
+    if (curveCount > 0) {
+        commands.bezier(xs, ys, count);
+    } else {
+        commands.polyline(xs, ys, count);
     }
+    commands.stroke();
 
-    switch (currentShape) {
-        case ShapeType::FREEHAND: {
-            auto line = std::make_shared<Line>();
-            line->points.push_back({x, y});
-            line->color = currentColor;
-            line->thickness = currentThickness;
-            currentElement = line;
-            break;
+    if (line.selected) {
+        commands.strokeStyle("#0095ff");
+        commands.lineWidth(line.thickness + 2);
+        commands.stroke();
+    }
+}
+
+void Whiteboard::encodeShape(const Shape& shape) {
+    commands.beginPath();
+    commands.strokeStyle(colors.name(shape.color));
+    commands.lineWidth(shape.thickness);
+
+    float width = shape.end.x - shape.start.x;
+    float height = shape.end.y - shape.start.y;
+
+    if (shape.type == ShapeType::RECTANGLE) {
+        commands.rect(shape.start.x, shape.start.y, width, height);
+        commands.stroke();
+    } else if (shape.type == ShapeType::CIRCLE) {
+        float centerX = shape.start.x + width / 2;
+        float centerY = shape.start.y + height / 2;
+        float radius = std::min(std::abs(width), std::abs(height)) / 2;
+
+        commands.beginPath();
+        commands.arc(centerX, centerY, radius, 0, 2 * M_PI);
+        commands.stroke();
+    }
+
+    if (shape.selected) {
+        commands.strokeStyle("#0095ff");
+        commands.lineWidth(shape.thickness + 2);
+        commands.stroke();
+    }
+}
+
+void Whiteboard::writeDeltas(ByteWriter& out, const float* xs, const float* ys, uint32_t count) {
+    int64_t px = 0;
+    int64_t py = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        int64_t qx = quantize(xs[i], SCENE_QUANTIZATION);
+        int64_t qy = quantize(ys[i], SCENE_QUANTIZATION);
+        out.svarint(qx - px);
+        out.svarint(qy - py);
+        px = qx;
+        py = qy;
+    }
+}
+
+void Whiteboard::writeScene(ByteWriter& out) {
+    flushRemovals();
+    out.clear();
+    out.bytes(SCENE_MAGIC, sizeof(SCENE_MAGIC));
+    out.u8(SCENE_VERSION);
+    out.varint(SCENE_QUANTIZATION);
+
+    // Renumber the colors in use so retired colors are not shipped
+    std::vector<uint32_t> palette(colors.size(), UINT32_MAX);
+    std::vector<uint16_t> used;
+    auto use = [&](uint16_t color) {
+        if (palette[color] == UINT32_MAX) {
+            palette[color] = static_cast<uint32_t>(used.size());
+            used.push_back(color);
         }
-        case ShapeType::RECTANGLE: {
-            auto rect = std::make_shared<Rectangle>();
-            rect->bounds = {x, y, 0, 0};
-            rect->color = currentColor;
-            rect->thickness = currentThickness;
-            currentElement = rect;
-            break;
+    };
+    for (const auto& line : lines) use(line.color);
+    for (const auto& shape : shapes) use(shape.color);
+
+    out.varint(used.size());
+    for (uint16_t color : used) out.text(colors.name(color));
+
+    // Lines with a fitted curve store its control points instead of the
+    // polyline, unless that is no shorter. Curves loaded from a scene are
+    // kept whatever their size: their polyline is only a flattening
+    out.varint(lines.size());
+    for (auto& line : lines) {
+        uint32_t count = strokes.size(line.stroke);
+        const float* xs = strokes.xs(line.stroke);
+        const float* ys = strokes.ys(line.stroke);
+        const float* fitXs = nullptr;
+        const float* fitYs = nullptr;
+        uint32_t curveCount = lineCurve(line, fitXs, fitYs);
+        bool curve = curveCount > 0 && (curveCount < count || line.curveLoaded);
+
+        out.u8(static_cast<uint8_t>(curve ? LineForm::CURVE : LineForm::POLYLINE));
+        out.varint(line.uid);
+        out.varint(palette[line.color]);
+        out.varint(quantize(line.thickness, SCENE_QUANTIZATION));
+        if (curve) {
+            out.varint(curveCount);
+            writeDeltas(out, fitXs, fitYs, curveCount);
+        } else {
+            out.varint(count);
+            writeDeltas(out, xs, ys, count);
         }
-        case ShapeType::CIRCLE: {
-            auto circle = std::make_shared<Circle>();
-            circle->center = {x, y};
-            circle->radius = 0;
-            circle->color = currentColor;
-            circle->thickness = currentThickness;
-            currentElement = circle;
-            break;
+    }
+
+    out.varint(shapes.size());
+    for (const auto& shape : shapes) {
+        int64_t sx = quantize(shape.start.x, SCENE_QUANTIZATION);
+        int64_t sy = quantize(shape.start.y, SCENE_QUANTIZATION);
+        out.u8(static_cast<uint8_t>(shape.type));
+        out.varint(shape.uid);
+        out.varint(palette[shape.color]);
+        out.varint(quantize(shape.thickness, SCENE_QUANTIZATION));
+        out.svarint(sx);
+        out.svarint(sy);
+        out.svarint(quantize(shape.end.x, SCENE_QUANTIZATION) - sx);
+        out.svarint(quantize(shape.end.y, SCENE_QUANTIZATION) - sy);
+    }
+}
+
+bool Whiteboard::readScene(const uint8_t* data, size_t size) {
+    ByteReader in(data, size);
+    for (uint8_t expected : SCENE_MAGIC) {
+        if (in.u8() != expected) return false;
+    }
+    // Version 1 scenes carry no uids; their elements get local ones
+    uint8_t version = in.u8();
+    if (version < 1 || version > SCENE_VERSION) return false;
+    bool hasUids = version >= 2;
+    bool hasForms = version >= 3;
+    uint64_t quantization = in.varint();
+    if (!in.ok() || quantization == 0) return false;
+    float step = 1.0f / static_cast<float>(quantization);
+
+    // Decode everything before touching the board so bad input changes nothing
+    uint64_t paletteSize = in.varint();
+    if (!in.ok() || paletteSize > in.remaining() || paletteSize > UINT16_MAX) return false;
+    std::vector<std::string> palette(static_cast<size_t>(paletteSize));
+    for (auto& color : palette) color = in.text();
+    if (!in.ok()) return false;
+
+    struct LineRecord {
+        uint64_t uid;
+        uint32_t color;
+        float thickness;
+        uint32_t first;
+        uint32_t count;
+        bool curve;   ///< The points are 3n + 1 Bézier points
+    };
+    std::vector<LineRecord> lineRecords;
+    std::vector<float> xs;
+    std::vector<float> ys;
+
+    uint64_t lineCount = in.varint();
+    if (!in.ok() || lineCount > in.remaining()) return false;
+    lineRecords.reserve(static_cast<size_t>(lineCount));
+    for (uint64_t l = 0; l < lineCount; l++) {
+        LineRecord record;
+        uint8_t form = hasForms ? in.u8() : static_cast<uint8_t>(LineForm::POLYLINE);
+        record.curve = form == static_cast<uint8_t>(LineForm::CURVE);
+        record.uid = hasUids ? in.varint() : 0;
+        record.color = static_cast<uint32_t>(in.varint());
+        record.thickness = static_cast<float>(in.varint()) * step;
+        uint64_t count = in.varint();
+        // Every point takes at least two bytes
+        if (!in.ok() || record.color >= palette.size() || count == 0 ||
+            count > in.remaining() / 2 || form > static_cast<uint8_t>(LineForm::CURVE) ||
+            (record.curve && (count < 4 || (count - 1) % 3 != 0))) {
+            return false;
         }
-        default:
-            break;
+        record.first = static_cast<uint32_t>(xs.size());
+        record.count = static_cast<uint32_t>(count);
+
+        int64_t qx = 0;
+        int64_t qy = 0;
+        for (uint64_t i = 0; i < count; i++) {
+            qx += in.svarint();
+            qy += in.svarint();
+            xs.push_back(static_cast<float>(qx) * step);
+            ys.push_back(static_cast<float>(qy) * step);
+        }
+        lineRecords.push_back(record);
     }
 
-    if (currentElement) {
-        elements.push_back(currentElement);
+    uint64_t shapeCount = in.varint();
+    if (!in.ok() || shapeCount > in.remaining()) return false;
+    std::vector<Shape> loadedShapes(static_cast<size_t>(shapeCount));
+    std::vector<uint32_t> shapeColors(loadedShapes.size());
+    for (size_t i = 0; i < loadedShapes.size(); i++) {
+        Shape& shape = loadedShapes[i];
+        uint8_t type = in.u8();
+        shape.uid = hasUids ? in.varint() : 0;
+        shapeColors[i] = static_cast<uint32_t>(in.varint());
+        shape.thickness = static_cast<float>(in.varint()) * step;
+        int64_t sx = in.svarint();
+        int64_t sy = in.svarint();
+        int64_t ex = sx + in.svarint();
+        int64_t ey = sy + in.svarint();
+        if (!in.ok() || shapeColors[i] >= palette.size() ||
+            type == static_cast<uint8_t>(ShapeType::FREEHAND) ||
+            type > static_cast<uint8_t>(ShapeType::TRIANGLE)) {
+            return false;
+        }
+        shape.type = static_cast<ShapeType>(type);
+        shape.start = {static_cast<float>(sx) * step, static_cast<float>(sy) * step};
+        shape.end = {static_cast<float>(ex) * step, static_cast<float>(ey) * step};
     }
+    if (!in.ok() || !in.atEnd()) return false;
+
+    resetBoard();
+
+    std::vector<uint16_t> colorIds(palette.size());
+    for (size_t i = 0; i < palette.size(); i++) colorIds[i] = colors.intern(palette[i]);
+
+    lines.reserve(lineRecords.size());
+    for (const auto& record : lineRecords) {
+        Line line;
+        line.id = nextId(ElementKind::LINE, lines.size());
+        line.uid = hasUids ? record.uid : newUid(line.id);
+        uidToId[line.uid] = line.id;
+        line.stroke = strokes.create();
+        line.color = colorIds[record.color];
+        line.thickness = record.thickness;
+        const float* pointXs = xs.data() + record.first;
+        const float* pointYs = ys.data() + record.first;
+        uint32_t pointCount = record.count;
+        if (record.curve) {
+            flattenCubics(pointXs, pointYs, record.count, FLATTEN_TOLERANCE, curveXs, curveYs);
+            pointXs = curveXs.data();
+            pointYs = curveYs.data();
+            pointCount = static_cast<uint32_t>(curveXs.size());
+        }
+        for (uint32_t i = 0; i < pointCount; i++) addPoint(line, pointXs[i], pointYs[i]);
+        if (record.curve) {
+            line.curve = curves.create();
+            line.curveLoaded = true;
+            for (uint32_t i = 0; i < record.count; i++) {
+                curves.append(line.curve, xs[record.first + i], ys[record.first + i]);
+            }
+        }
+        index.insert(line.id, line.bounds);
+        maxInkPad = std::max(maxInkPad, line.thickness / 2 + 2);
+        lines.push_back(std::move(line));
+    }
+
+    shapes.reserve(loadedShapes.size());
+    for (size_t i = 0; i < loadedShapes.size(); i++) {
+        Shape shape = loadedShapes[i];
+        shape.id = nextId(ElementKind::SHAPE, shapes.size());
+        if (!hasUids) shape.uid = newUid(shape.id);
+        uidToId[shape.uid] = shape.id;
+        shape.color = colorIds[shapeColors[i]];
+        index.insert(shape.id, shapeBounds(shape));
+        maxInkPad = std::max(maxInkPad, shape.thickness / 2 + 2);
+        shapes.push_back(shape);
+    }
+    return true;
 }
 
-void Whiteboard::continueDrawing(float x, float y) {
-    if (isSelecting) {
-        updateSelection(x, y);
+void Whiteboard::streamBegin(const Line& line) {
+    flushStreamPoints();
+    streamId = line.id;
+    streamSent = 1;
+    streamQx = quantize(strokes.xs(line.stroke)[0], SCENE_QUANTIZATION);
+    streamQy = quantize(strokes.ys(line.stroke)[0], SCENE_QUANTIZATION);
+
+    outgoing.u8(static_cast<uint8_t>(StreamOp::BEGIN));
+    outgoing.varint(line.uid);
+    outgoing.text(colors.name(line.color));
+    outgoing.varint(quantize(line.thickness, SCENE_QUANTIZATION));
+    outgoing.svarint(streamQx);
+    outgoing.svarint(streamQy);
+}
+
+void Whiteboard::streamShape(const Shape& shape) {
+    flushStreamPoints();
+    int64_t sx = quantize(shape.start.x, SCENE_QUANTIZATION);
+    int64_t sy = quantize(shape.start.y, SCENE_QUANTIZATION);
+    outgoing.u8(static_cast<uint8_t>(StreamOp::SHAPE));
+    outgoing.varint(shape.uid);
+    outgoing.u8(static_cast<uint8_t>(shape.type));
+    outgoing.text(colors.name(shape.color));
+    outgoing.varint(quantize(shape.thickness, SCENE_QUANTIZATION));
+    outgoing.svarint(sx);
+    outgoing.svarint(sy);
+    outgoing.svarint(quantize(shape.end.x, SCENE_QUANTIZATION) - sx);
+    outgoing.svarint(quantize(shape.end.y, SCENE_QUANTIZATION) - sy);
+}
+
+void Whiteboard::flushStreamPoints() {
+    if (streamId == NO_ELEMENT) return;
+    if (!index.contains(streamId)) {
+        streamId = NO_ELEMENT; // Erased while drawing; peers see it stop
         return;
     }
 
-    if (!currentElement) return;
+    const Line& line = lines[refs[streamId].index];
+    uint32_t count = strokes.size(line.stroke);
+    if (count <= streamSent) return;
 
-    switch (currentShape) {
-        case ShapeType::FREEHAND: {
-            auto line = std::static_pointer_cast<Line>(currentElement);
-            line->points.push_back({x, y});
-            break;
+    outgoing.u8(static_cast<uint8_t>(StreamOp::POINTS));
+    outgoing.varint(line.uid);
+    outgoing.varint(count - streamSent);
+    for (uint32_t i = streamSent; i < count; i++) {
+        int64_t qx = quantize(strokes.xs(line.stroke)[i], SCENE_QUANTIZATION);
+        int64_t qy = quantize(strokes.ys(line.stroke)[i], SCENE_QUANTIZATION);
+        outgoing.svarint(qx - streamQx);
+        outgoing.svarint(qy - streamQy);
+        streamQx = qx;
+        streamQy = qy;
+    }
+    streamSent = count;
+}
+
+uint32_t Whiteboard::remoteSenderIndex(const std::string& sender) {
+    auto found = remoteSenders.find(sender);
+    if (found != remoteSenders.end()) return found->second;
+    uint32_t senderIndex = static_cast<uint32_t>(remoteSenders.size());
+    remoteSenders.emplace(sender, senderIndex);
+    return senderIndex;
+}
+
+bool Whiteboard::readStrokeBatch(uint32_t sender, const uint8_t* data, size_t size) {
+    ByteReader in(data, size);
+    if (in.u8() != STREAM_VERSION) return false;
+
+    const float step = 1.0f / SCENE_QUANTIZATION;
+
+    while (in.ok() && !in.atEnd()) {
+        StreamOp op = static_cast<StreamOp>(in.u8());
+
+        if (op == StreamOp::BEGIN) {
+            uint64_t uid = in.varint();
+            std::string color = in.text();
+            float thickness = static_cast<float>(in.varint()) * step;
+            int64_t qx = in.svarint();
+            int64_t qy = in.svarint();
+            if (!in.ok()) return false;
+            if (uidToId.count(uid)) continue; // Duplicate delivery
+            startRemoteStroke(uid, sender, color, thickness, static_cast<float>(qx) * step,
+                              static_cast<float>(qy) * step, qx, qy);
+        } else if (op == StreamOp::POINTS) {
+            uint64_t uid = in.varint();
+            uint64_t count = in.varint();
+            if (!in.ok() || count > in.remaining() / 2) return false;
+
+            auto it = remoteStrokes.find(uid);
+            bool known = it != remoteStrokes.end() && index.contains(it->second.id);
+            int64_t qx = known ? it->second.qx : 0;
+            int64_t qy = known ? it->second.qy : 0;
+            for (uint64_t i = 0; i < count; i++) {
+                qx += in.svarint();
+                qy += in.svarint();
+                if (known) {
+                    continueDrawingPoint(lines[refs[it->second.id].index],
+                                         static_cast<float>(qx) * step,
+                                         static_cast<float>(qy) * step);
+                }
+            }
+            if (known) {
+                it->second.qx = qx;
+                it->second.qy = qy;
+            }
+        } else if (op == StreamOp::END) {
+            uint64_t uid = in.varint();
+            float tolerance = static_cast<float>(in.varint()) * step;
+            if (!in.ok()) return false;
+            finishRemoteStroke(uid, tolerance);
+        } else if (op == StreamOp::SHAPE) {
+            uint64_t uid = in.varint();
+            uint8_t type = in.u8();
+            std::string color = in.text();
+            float thickness = static_cast<float>(in.varint()) * step;
+            int64_t sx = in.svarint();
+            int64_t sy = in.svarint();
+            int64_t ex = sx + in.svarint();
+            int64_t ey = sy + in.svarint();
+            if (!in.ok() || type == static_cast<uint8_t>(ShapeType::FREEHAND) ||
+                type > static_cast<uint8_t>(ShapeType::TRIANGLE)) {
+                return false;
+            }
+            if (uidToId.count(uid)) continue;
+
+            Shape shape;
+            shape.id = nextId(ElementKind::SHAPE, shapes.size());
+            shape.uid = uid;
+            uidToId[uid] = shape.id;
+            shape.type = static_cast<ShapeType>(type);
+            shape.color = colors.intern(color);
+            shape.thickness = thickness;
+            shape.start = {static_cast<float>(sx) * step, static_cast<float>(sy) * step};
+            shape.end = {static_cast<float>(ex) * step, static_cast<float>(ey) * step};
+            index.insert(shape.id, shapeBounds(shape));
+            maxInkPad = std::max(maxInkPad, thickness / 2 + 2);
+            pushShape(shape);
+            commitElement(shape.id);
+        } else {
+            return false;
         }
-        case ShapeType::RECTANGLE: {
-            auto rect = std::static_pointer_cast<Rectangle>(currentElement);
-            float dx = x - rect->bounds.x;
-            float dy = y - rect->bounds.y;
-            rect->bounds.width = dx;
-            rect->bounds.height = dy;
-            break;
+    }
+    return in.ok();
+}
+
+void Whiteboard::startRemoteStroke(uint64_t uid, uint32_t sender, const std::string& color, float thickness,
+                                   float x, float y, int64_t qx, int64_t qy) {
+    Line line;
+    line.id = nextId(ElementKind::LINE, lines.size());
+    line.uid = uid;
+    uidToId[uid] = line.id;
+    line.stroke = strokes.create();
+    line.color = colors.intern(color);
+    line.thickness = thickness;
+    addPoint(line, x, y);
+    index.insert(line.id, line.bounds);
+    damage.add(inkBounds(line.bounds, line.thickness));
+    maxInkPad = std::max(maxInkPad, thickness / 2 + 2);
+
+    remoteStrokes[uid] = {line.id, sender, qx, qy};
+    remoteLive.push_back(line.id);
+    lines.push_back(std::move(line));
+}
+
+void Whiteboard::pushShape(const Shape& shape) {
+    // Adding to a vector may move the shape being drawn locally
+    bool tracking = currentShapePtr != nullptr && currentId != NO_ELEMENT &&
+                    refs[currentId].kind == ElementKind::SHAPE;
+    shapes.push_back(shape);
+    currentShapePtr = tracking ? &shapes[refs[currentId].index] : nullptr;
+}
+
+void Whiteboard::endRemoteStroke(uint32_t id) {
+    auto it = std::lower_bound(remoteLive.begin(), remoteLive.end(), id);
+    if (it != remoteLive.end() && *it == id) remoteLive.erase(it);
+    commitElement(id);
+}
+
+void Whiteboard::writeStamp(ByteWriter& out, const Stamp& stamp) {
+    out.varint(stamp.counter);
+    out.varint(stamp.site);
+}
+
+Stamp Whiteboard::readStamp(ByteReader& in) {
+    Stamp stamp;
+    stamp.counter = in.varint();
+    stamp.site = static_cast<uint32_t>(in.varint());
+    return stamp;
+}
+
+void Whiteboard::writeTags(ByteWriter& out, const std::vector<Stamp>& tags) {
+    out.varint(tags.size());
+    for (const Stamp& tag : tags) writeStamp(out, tag);
+}
+
+bool Whiteboard::readTags(ByteReader& in, std::vector<Stamp>& tags) {
+    tags.clear();
+    uint64_t count = in.varint();
+    // Every stamp takes at least two bytes
+    if (!in.ok() || count > in.remaining() / 2) return false;
+    for (uint64_t i = 0; i < count; i++) tags.push_back(readStamp(in));
+    return in.ok();
+}
+
+void Whiteboard::writeStyle(ByteWriter& out, uint32_t id) {
+    visitElement(id, [&](const auto& element) {
+        out.text(colors.name(element.color));
+        out.varint(quantize(element.thickness, SCENE_QUANTIZATION));
+    });
+}
+
+void Whiteboard::writeOffset(ByteWriter& out, const ElementReplica& replica) {
+    out.svarint(quantize(replica.ox, SCENE_QUANTIZATION));
+    out.svarint(quantize(replica.oy, SCENE_QUANTIZATION));
+}
+
+void Whiteboard::writeGeometry(ByteWriter& out, uint32_t id, const ElementReplica& replica) {
+    const ElementRef& ref = refs[id];
+    if (ref.kind == ElementKind::LINE) {
+        const Line& line = lines[ref.index];
+        uint32_t count = strokes.size(line.stroke);
+        out.u8(static_cast<uint8_t>(ShapeType::FREEHAND));
+        out.varint(count);
+        int64_t px = 0;
+        int64_t py = 0;
+        for (uint32_t i = 0; i < count; i++) {
+            int64_t qx = quantize(strokes.xs(line.stroke)[i] - replica.ox, SCENE_QUANTIZATION);
+            int64_t qy = quantize(strokes.ys(line.stroke)[i] - replica.oy, SCENE_QUANTIZATION);
+            out.svarint(qx - px);
+            out.svarint(qy - py);
+            px = qx;
+            py = qy;
         }
-        case ShapeType::CIRCLE: {
-            auto circle = std::static_pointer_cast<Circle>(currentElement);
-            float dx = x - circle->center.x;
-            float dy = y - circle->center.y;
-            circle->radius = std::sqrt(dx * dx + dy * dy);
-            break;
+        return;
+    }
+    const Shape& shape = shapes[ref.index];
+    int64_t sx = quantize(shape.start.x - replica.ox, SCENE_QUANTIZATION);
+    int64_t sy = quantize(shape.start.y - replica.oy, SCENE_QUANTIZATION);
+    out.u8(static_cast<uint8_t>(shape.type));
+    out.svarint(sx);
+    out.svarint(sy);
+    out.svarint(quantize(shape.end.x - replica.ox, SCENE_QUANTIZATION) - sx);
+    out.svarint(quantize(shape.end.y - replica.oy, SCENE_QUANTIZATION) - sy);
+}
+
+bool Whiteboard::readGeometry(ByteReader& in, GeometryRecord& geometry) {
+    const float step = 1.0f / SCENE_QUANTIZATION;
+    geometry.xs.clear();
+    geometry.ys.clear();
+    geometry.type = in.u8();
+    if (geometry.type > static_cast<uint8_t>(ShapeType::TRIANGLE)) return false;
+
+    uint64_t count = 2; // Shape corners
+    if (geometry.type == static_cast<uint8_t>(ShapeType::FREEHAND)) {
+        count = in.varint();
+        if (!in.ok() || count == 0 || count > in.remaining() / 2) return false;
+    }
+    int64_t qx = 0;
+    int64_t qy = 0;
+    for (uint64_t i = 0; i < count; i++) {
+        qx += in.svarint();
+        qy += in.svarint();
+        geometry.xs.push_back(static_cast<float>(qx) * step);
+        geometry.ys.push_back(static_cast<float>(qy) * step);
+    }
+    return in.ok();
+}
+
+void Whiteboard::writeElement(ByteWriter& out, uint64_t uid, const ElementReplica& replica, uint32_t id) {
+    bool body = id != NO_ELEMENT && replica.present();
+    out.u8(static_cast<uint8_t>(ReplicaOp::ELEMENT));
+    out.varint(uid);
+    writeTags(out, replica.added);
+    writeTags(out, replica.removed);
+    out.u8(body ? 1 : 0);
+    if (body) {
+        writeStamp(out, replica.style);
+        writeStyle(out, id);
+        writeStamp(out, replica.offset);
+        writeOffset(out, replica);
+        writeStamp(out, replica.geometry);
+        writeGeometry(out, id, replica);
+    }
+}
+
+void Whiteboard::writeOps(ByteWriter& out, uint64_t uid, uint8_t fields) {
+    ElementReplica* replica = replicas.find(uid);
+    if (!replica) return;
+    uint32_t id = findUid(uid);
+
+    if (fields & ReplicaSet::MEMBERSHIP) {
+        writeElement(out, uid, *replica, id);
+        return;
+    }
+
+    if (id == NO_ELEMENT) return;
+    if (fields & ReplicaSet::STYLE) {
+        out.u8(static_cast<uint8_t>(ReplicaOp::STYLE));
+        out.varint(uid);
+        writeStamp(out, replica->style);
+        writeStyle(out, id);
+    }
+    if (fields & ReplicaSet::OFFSET) {
+        out.u8(static_cast<uint8_t>(ReplicaOp::OFFSET));
+        out.varint(uid);
+        writeStamp(out, replica->offset);
+        writeOffset(out, *replica);
+    }
+    if (fields & ReplicaSet::GEOMETRY) {
+        out.u8(static_cast<uint8_t>(ReplicaOp::GEOMETRY));
+        out.varint(uid);
+        writeStamp(out, replica->geometry);
+        writeGeometry(out, id, *replica);
+    }
+}
+
+void Whiteboard::applyStyle(uint32_t id, const std::string& color, float thickness) {
+    touchElement(id);
+    const ElementRef& ref = refs[id];
+    if (ref.kind == ElementKind::LINE) {
+        lines[ref.index].color = colors.intern(color);
+        lines[ref.index].thickness = thickness;
+    } else {
+        shapes[ref.index].color = colors.intern(color);
+        shapes[ref.index].thickness = thickness;
+    }
+    maxInkPad = std::max(maxInkPad, thickness / 2 + 2);
+    touchElement(id);
+}
+
+void Whiteboard::applyOffset(uint32_t id, ElementReplica& replica, float ox, float oy) {
+    touchElement(id);
+    translateElement(id, ox - replica.ox, oy - replica.oy);
+    touchElement(id);
+    replica.ox = ox;
+    replica.oy = oy;
+}
+
+void Whiteboard::applyGeometry(uint32_t id, const ElementReplica& replica, const GeometryRecord& geometry) {
+    bool isLine = geometry.type == static_cast<uint8_t>(ShapeType::FREEHAND);
+    if (isLine != (refs[id].kind == ElementKind::LINE)) return;
+
+    touchElement(id);
+    if (isLine) {
+        Line& line = lines[refs[id].index];
+        strokes.truncate(line.stroke, 0);
+        line.bounds = Box();
+        for (size_t i = 0; i < geometry.xs.size(); i++) {
+            addPoint(line, geometry.xs[i] + replica.ox, geometry.ys[i] + replica.oy);
         }
-        default:
-            break;
+        index.update(id, line.bounds);
+
+        // The final geometry supersedes a stroke still streaming in
+        auto streamed = remoteStrokes.find(line.uid);
+        if (streamed != remoteStrokes.end()) {
+            remoteStrokes.erase(streamed);
+            endRemoteStroke(id);
+        }
+    } else {
+        Shape& shape = shapes[refs[id].index];
+        shape.type = static_cast<ShapeType>(geometry.type);
+        shape.start = {geometry.xs[0] + replica.ox, geometry.ys[0] + replica.oy};
+        shape.end = {geometry.xs[1] + replica.ox, geometry.ys[1] + replica.oy};
+        index.update(id, shapeBounds(shape));
     }
+    touchElement(id);
 }
 
-void Whiteboard::endDrawing() {
-    if (isSelecting) {
-        endSelection();
+void Whiteboard::createReplicated(uint64_t uid, const std::string& color, float thickness,
+                                  const ElementReplica& replica, const GeometryRecord& geometry) {
+    maxInkPad = std::max(maxInkPad, thickness / 2 + 2);
+    if (geometry.type == static_cast<uint8_t>(ShapeType::FREEHAND)) {
+        Line line;
+        line.id = nextId(ElementKind::LINE, lines.size());
+        line.uid = uid;
+        uidToId[uid] = line.id;
+        line.stroke = strokes.create();
+        line.color = colors.intern(color);
+        line.thickness = thickness;
+        for (size_t i = 0; i < geometry.xs.size(); i++) {
+            addPoint(line, geometry.xs[i] + replica.ox, geometry.ys[i] + replica.oy);
+        }
+        index.insert(line.id, line.bounds);
+        uint32_t id = line.id;
+        lines.push_back(std::move(line));
+        commitElement(id);
         return;
     }
 
-    currentElement = nullptr;
+    Shape shape;
+    shape.id = nextId(ElementKind::SHAPE, shapes.size());
+    shape.uid = uid;
+    uidToId[uid] = shape.id;
+    shape.type = static_cast<ShapeType>(geometry.type);
+    shape.color = colors.intern(color);
+    shape.thickness = thickness;
+    shape.start = {geometry.xs[0] + replica.ox, geometry.ys[0] + replica.oy};
+    shape.end = {geometry.xs[1] + replica.ox, geometry.ys[1] + replica.oy};
+    index.insert(shape.id, shapeBounds(shape));
+    pushShape(shape);
+    commitElement(shape.id);
+}
+
+bool Whiteboard::readOp(ByteReader& in) {
+    const float step = 1.0f / SCENE_QUANTIZATION;
+    ReplicaOp op = static_cast<ReplicaOp>(in.u8());
+    uint64_t uid = in.varint();
+
+    if (op == ReplicaOp::ELEMENT) {
+        if (!readTags(in, remoteAdded) || !readTags(in, remoteRemoved)) return false;
+        bool body = in.u8() != 0;
+        Stamp styleStamp, offsetStamp, geometryStamp;
+        std::string color;
+        float thickness = 0, ox = 0, oy = 0;
+        if (body) {
+            styleStamp = readStamp(in);
+            color = in.text();
+            thickness = static_cast<float>(in.varint()) * step;
+            offsetStamp = readStamp(in);
+            ox = static_cast<float>(in.svarint()) * step;
+            oy = static_cast<float>(in.svarint()) * step;
+            geometryStamp = readStamp(in);
+            if (!readGeometry(in, remoteGeometry)) return false;
+        }
+        if (!in.ok()) return false;
+
+        ElementReplica& replica = replicas.at(uid);
+        bool present = replicas.mergeTags(replica, remoteAdded, remoteRemoved);
+        uint32_t id = findUid(uid);
+        if (!present) {
+            if (id != NO_ELEMENT) removeElement(uid);
+            return true;
+        }
+        if (!body) return true;
+        replicas.observe(styleStamp);
+        replicas.observe(offsetStamp);
+        replicas.observe(geometryStamp);
+
+        if (id == NO_ELEMENT) {
+            // Registers of an element we had removed are stale: adopt the peer's
+            replica.style = styleStamp;
+            replica.offset = offsetStamp;
+            replica.geometry = geometryStamp;
+            replica.ox = ox;
+            replica.oy = oy;
+            createReplicated(uid, color, thickness, replica, remoteGeometry);
+            return true;
+        }
+        if (replica.style < styleStamp) {
+            replica.style = styleStamp;
+            applyStyle(id, color, thickness);
+        }
+        if (replica.offset < offsetStamp) {
+            replica.offset = offsetStamp;
+            applyOffset(id, replica, ox, oy);
+        }
+        if (replica.geometry < geometryStamp) {
+            replica.geometry = geometryStamp;
+            applyGeometry(id, replica, remoteGeometry);
+        }
+        return true;
+    }
+
+    Stamp stamp = readStamp(in);
+    std::string color;
+    float thickness = 0, ox = 0, oy = 0;
+    if (op == ReplicaOp::STYLE) {
+        color = in.text();
+        thickness = static_cast<float>(in.varint()) * step;
+    } else if (op == ReplicaOp::OFFSET) {
+        ox = static_cast<float>(in.svarint()) * step;
+        oy = static_cast<float>(in.svarint()) * step;
+    } else if (op == ReplicaOp::GEOMETRY) {
+        if (!readGeometry(in, remoteGeometry)) return false;
+    } else {
+        return false;
+    }
+    if (!in.ok()) return false;
+    replicas.observe(stamp);
+
+    // Register writes to elements removed here lose to the removal
+    uint32_t id = findUid(uid);
+    if (id == NO_ELEMENT) return true;
+    ElementReplica& replica = replicas.at(uid);
+
+    if (op == ReplicaOp::STYLE && replica.style < stamp) {
+        replica.style = stamp;
+        applyStyle(id, color, thickness);
+    } else if (op == ReplicaOp::OFFSET && replica.offset < stamp) {
+        replica.offset = stamp;
+        applyOffset(id, replica, ox, oy);
+    } else if (op == ReplicaOp::GEOMETRY && replica.geometry < stamp) {
+        replica.geometry = stamp;
+        applyGeometry(id, replica, remoteGeometry);
+    }
+    return true;
+}
+
+bool Whiteboard::readOps(const uint8_t* data, size_t size) {
+    ByteReader in(data, size);
+    if (in.u8() != OPS_VERSION) return false;
+
+    applyingRemote = true;
+    recordHistory = false;
+    bool valid = true;
+    while (valid && in.ok() && !in.atEnd()) valid = readOp(in);
+    recordHistory = true;
+    applyingRemote = false;
+    return valid && in.ok();
 }
 
-void Whiteboard::draw(emscripten::val context) {
-    for (const auto& element : elements) {
-        element->draw(context);
+void Whiteboard::encodeTiles(const Box* areas, size_t areaCount) {
+    // Each tile is blitted once even when several areas share it
+    tileKeys.clear();
+    for (size_t a = 0; a < areaCount; a++) {
+        TileCache::Range range = tiles.rangeFor(areas[a]);
+        for (int32_t ty = range.y0; ty <= range.y1; ty++) {
+            for (int32_t tx = range.x0; tx <= range.x1; tx++) {
+                tileKeys.push_back((static_cast<uint64_t>(static_cast<uint32_t>(tx)) << 32) |
+                                   static_cast<uint32_t>(ty));
+            }
+        }
+    }
+    std::sort(tileKeys.begin(), tileKeys.end());
+    tileKeys.erase(std::unique(tileKeys.begin(), tileKeys.end()), tileKeys.end());
+
+    for (uint64_t key : tileKeys) {
+        int32_t tx = static_cast<int32_t>(key >> 32);
+        int32_t ty = static_cast<int32_t>(key & 0xffffffffu);
+
+        TileCache::State state = tiles.state(tx, ty);
+        if (state == TileCache::State::STALE) state = rasterizeTile(tx, ty);
+        if (state == TileCache::State::READY) commands.tileBlit(tx, ty, tiles.size());
     }
 }
 
-void Whiteboard::setShapeType(ShapeType type) {
-    currentShape = type;
-    clearSelection();
+TileCache::State Whiteboard::rasterizeTile(int32_t tx, int32_t ty) {
+    // Pad the query so strokes whose ink (not bounds) reaches the tile are included
+    Box area = tiles.tileBox(tx, ty);
+    area.minX -= maxInkPad;
+    area.minY -= maxInkPad;
+    area.maxX += maxInkPad;
+    area.maxY += maxInkPad;
+
+    index.query(area, tileHits);
+    tileHits.erase(std::remove_if(tileHits.begin(), tileHits.end(),
+                                  [this](uint32_t id) { return isLive(id); }),
+                   tileHits.end());
+
+    if (tileHits.empty()) {
+        commands.tileDrop(tx, ty);
+        tiles.setState(tx, ty, TileCache::State::EMPTY);
+        return TileCache::State::EMPTY;
+    }
+
+    commands.tileBegin(tx, ty, tiles.size(), tiles.zoom());
+    forEachOfType<Line>(tileHits, [this](Line& line) { encodeLine(line); });
+    forEachOfType<Shape>(tileHits, [this](const Shape& shape) { encodeShape(shape); });
+    commands.tileEnd();
+
+    tiles.setState(tx, ty, TileCache::State::READY);
+    return TileCache::State::READY;
 }
 
-void Whiteboard::setColor(const std::string& color) {
-    currentColor = color;
+void Whiteboard::encodeLiveElements(const Box* areas, size_t areaCount) {
+    dirtyHits.assign(selectedIds.begin(), selectedIds.end());
+    dirtyHits.insert(dirtyHits.end(), remoteLive.begin(), remoteLive.end());
+    if (currentId != NO_ELEMENT) dirtyHits.push_back(currentId);
+    std::sort(dirtyHits.begin(), dirtyHits.end());
+    dirtyHits.erase(std::unique(dirtyHits.begin(), dirtyHits.end()), dirtyHits.end());
+
+    auto visible = [&](uint32_t id) {
+        if (!index.contains(id)) return false;
+        Box ink = elementInk(id);
+        for (size_t a = 0; a < areaCount; a++) {
+            if (ink.intersects(areas[a])) return true;
+        }
+        return false;
+    };
+
+    forEachOfType<Line>(dirtyHits, [&](Line& line) {
+        if (visible(line.id)) encodeLine(line);
+    });
+    forEachOfType<Shape>(dirtyHits, [&](const Shape& shape) {
+        if (visible(shape.id)) encodeShape(shape);
+    });
 }
 
-void Whiteboard::setThickness(float thickness) {
-    currentThickness = thickness;
+void Whiteboard::encodeSelectionBox() {
+    if (!isSelecting) return;
+
+    Box box = selectionBox();
+    commands.beginPath();
+    commands.strokeStyle("#0095ff");
+    commands.lineWidth(1);
+    commands.lineDash(5, 5);
+    commands.strokeRect(box.minX, box.minY, box.maxX - box.minX, box.maxY - box.minY);
+    commands.lineDash(0, 0);
+}
+
+void Whiteboard::addPoint(Line& line, float x, float y) {
+    dropLod(line);
+    strokes.append(line.stroke, x, y);
+    line.bounds.extend(x, y);
+}
+
+void Whiteboard::continueDrawingPoint(Line& line, float x, float y) {
+    uint32_t last = strokes.size(line.stroke) - 1;
+    Box segment;
+    segment.extend(strokes.xs(line.stroke)[last], strokes.ys(line.stroke)[last]);
+    segment.extend(x, y);
+    damage.add(inkBounds(segment, line.thickness));
+
+    addPoint(line, x, y);
+    index.update(line.id, line.bounds);
+}
+
+Line* Whiteboard::drawingLine() {
+    if (currentId == NO_ELEMENT || !index.contains(currentId)) return nullptr;
+    if (refs[currentId].kind != ElementKind::LINE) return nullptr;
+    return &lines[refs[currentId].index];
+}
+
+void Whiteboard::clearPrediction() {
+    if (predictionXs.empty()) return;
+    damage.add(predictionInk);
+    predictionXs.clear();
+    predictionYs.clear();
+}
+
+void Whiteboard::updatePrediction(const Line& line) {
+    clearPrediction();
+    if (predictionHorizon <= 0) return;
+
+    float xs[PREDICTION_POINTS];
+    float ys[PREDICTION_POINTS];
+    if (!ink.predict(predictionHorizon, xs, ys, PREDICTION_POINTS)) return;
+
+    uint32_t last = strokes.size(line.stroke) - 1;
+    predictionXs.push_back(strokes.xs(line.stroke)[last]);
+    predictionYs.push_back(strokes.ys(line.stroke)[last]);
+    if (hasPendingPoint) {
+        predictionXs.push_back(pendingPoint.x);
+        predictionYs.push_back(pendingPoint.y);
+    }
+    predictionXs.insert(predictionXs.end(), xs, xs + PREDICTION_POINTS);
+    predictionYs.insert(predictionYs.end(), ys, ys + PREDICTION_POINTS);
+
+    Box tail = pointBounds(predictionXs.data(), predictionYs.data(), predictionXs.size());
+    predictionInk = inkBounds(tail, line.thickness);
+    damage.add(predictionInk);
+}
+
+void Whiteboard::encodePrediction() {
+    const Line* line = drawingLine();
+    if (!line || predictionXs.empty()) return;
+    commands.beginPath();
+    commands.strokeStyle(colors.name(line->color));
+    commands.lineWidth(line->thickness);
+    commands.roundCaps();
+    commands.polyline(predictionXs.data(), predictionYs.data(), predictionXs.size());
+    commands.stroke();
+}
+
+void Whiteboard::recomputeBounds(Line& line) {
+    line.bounds = pointBounds(strokes.xs(line.stroke), strokes.ys(line.stroke),
+                              strokes.size(line.stroke));
+}
+
+void Whiteboard::releaseStorage(const Line& line) {
+    strokes.release(line.stroke);
+    if (line.lod != StrokeLod::NONE) lods.release(line.lod);
+    if (line.curve != NO_CURVE) curves.release(line.curve);
+}
+
+uint32_t Whiteboard::nextId(ElementKind kind, size_t position) {
+    refs.push_back({kind, static_cast<uint32_t>(position)});
+    return static_cast<uint32_t>(refs.size() - 1);
+}
+
+uint64_t Whiteboard::newUid(uint32_t id) {
+    uint64_t uid = (static_cast<uint64_t>(siteId) << 32) | nextCounter++;
+    uidToId[uid] = id;
+    return uid;
+}
+
+uint64_t Whiteboard::uidOf(uint32_t id) const {
+    return visitElement(id, [](const auto& element) { return element.uid; });
+}
+
+uint32_t Whiteboard::findUid(uint64_t uid) const {
+    auto found = uidToId.find(uid);
+    if (found == uidToId.end() || !index.contains(found->second)) return NO_ELEMENT;
+    return found->second;
+}
+
+void Whiteboard::resetBoard() {
+    clear();
+    history.clear();
+    replicas.clear();
+    isSelecting = false;
+    isDrawingShape = false;
+    currentShapePtr = nullptr;
+}
+
+void Whiteboard::flushRemovals() {
+    if (removedPending == 0) return;
+    removedPending = 0;
+    compact(lines, [this](const Line& line) { return !index.contains(line.id); });
+    compact(shapes, [this](const Shape& shape) { return !index.contains(shape.id); });
+}
+
+uint32_t Whiteboard::rasterColor(uint16_t color) const {
+    uint32_t rgba = 0xff000000u;
+    parseHexColor(colors.name(color), rgba);
+    return rgba;
+}
+
+void Whiteboard::rasterizeElements(Rasterizer& raster, const std::vector<uint32_t>& ids) const {
+    forEachOfType<Line>(ids, [&](const Line& line) {
+        raster.strokePolyline(strokes.xs(line.stroke), strokes.ys(line.stroke), strokes.size(line.stroke),
+                              line.thickness, rasterColor(line.color));
+    });
+    forEachOfType<Shape>(ids, [&](const Shape& shape) {
+        if (shape.type == ShapeType::RECTANGLE) {
+            raster.strokeRect(shape.start.x, shape.start.y, shape.end.x, shape.end.y,
+                              shape.thickness, rasterColor(shape.color));
+        } else if (shape.type == ShapeType::CIRCLE) {
+            float spanX = shape.end.x - shape.start.x;
+            float spanY = shape.end.y - shape.start.y;
+            raster.strokeCircle(shape.start.x + spanX / 2, shape.start.y + spanY / 2,
+                                std::min(std::abs(spanX), std::abs(spanY)) / 2,
+                                shape.thickness, rasterColor(shape.color));
+        }
+    });
+}
+
+void Whiteboard::writeSvgLine(Line& line) {
+    uint32_t count = strokes.size(line.stroke);
+    if (count == 0) return;
+    svgOut.text("<path");
+    const float* xs;
+    const float* ys;
+    uint32_t curveCount = lineCurve(line, xs, ys);
+    if (curveCount > 0) {
+        svgOut.curveData(xs, ys, curveCount);
+    } else {
+        svgOut.pathData(strokes.xs(line.stroke), strokes.ys(line.stroke), count);
+    }
+    svgOut.attribute("stroke", colors.name(line.color));
+    svgOut.attribute("stroke-width", line.thickness);
+    svgOut.text(" fill=\"none\" stroke-linecap=\"round\" stroke-linejoin=\"round\"/>");
+}
+
+void Whiteboard::writeSvgShape(const Shape& shape) {
+    float width = shape.end.x - shape.start.x;
+    float height = shape.end.y - shape.start.y;
+
+    if (shape.type == ShapeType::RECTANGLE) {
+        // SVG rejects negative sizes; rectangles dragged up or left have them
+        svgOut.text("<rect");
+        svgOut.attribute("x", std::min(shape.start.x, shape.end.x));
+        svgOut.attribute("y", std::min(shape.start.y, shape.end.y));
+        svgOut.attribute("width", std::abs(width));
+        svgOut.attribute("height", std::abs(height));
+    } else if (shape.type == ShapeType::CIRCLE) {
+        svgOut.text("<circle");
+        svgOut.attribute("cx", shape.start.x + width / 2);
+        svgOut.attribute("cy", shape.start.y + height / 2);
+        svgOut.attribute("r", std::min(std::abs(width), std::abs(height)) / 2);
+    } else {
+        return;
+    }
+    svgOut.attribute("stroke", colors.name(shape.color));
+    svgOut.attribute("stroke-width", shape.thickness);
+    svgOut.text(" fill=\"none\"/>");
+}
+
+void Whiteboard::init() {
+    history.clear();
+    nextCounter = 1;
+    damage.markAll();
+    tiles.clear();
+    dropTiles = true;
+    currentId = NO_ELEMENT;
+    streamId = NO_ELEMENT;
+    predictionXs.clear();
+    predictionYs.clear();
+    hasRawPoint = false;
+    outgoing.clear();
+    remoteStrokes.clear();
+    remoteLive.clear();
+    uidToId.clear();
+    removedPending = 0;
+    maxInkPad = 0;
+    lines.clear();
+    shapes.clear();
+    strokes.clear();
+    lods.clear();
+    curves.clear();
+    colors.clear();
+    index.clear();
+    refs.clear();
+    selectedIds.clear();
+    replicas.clear();
+    isSelecting = false;
+    isDrawingShape = false;
+    currentShapePtr = nullptr;
+}
+
+void Whiteboard::startDrawing(float x, float y) {
+    finishStroke();
+    commitCurrent();
+    maxInkPad = std::max(maxInkPad, currentThickness / 2 + 2);
+
+    if (currentShape == ShapeType::FREEHAND) {
+        Line newLine;
+        newLine.id = nextId(ElementKind::LINE, lines.size());
+        newLine.uid = newUid(newLine.id);
+        newLine.stroke = strokes.create();
+        newLine.color = colors.intern(currentColor);
+        newLine.thickness = currentThickness;
+        addPoint(newLine, x, y);
+        index.insert(newLine.id, newLine.bounds);
+        damage.add(inkBounds(newLine.bounds, newLine.thickness));
+        currentId = newLine.id;
+        ink.reset(x, y);
+        if (streaming) streamBegin(newLine);
+        lines.push_back(std::move(newLine));
+    } else {
+        Shape newShape;
+        newShape.type = currentShape;
+        newShape.color = colors.intern(currentColor);
+        newShape.thickness = currentThickness;
+        newShape.selected = false;
+
+        // Set initial size and position based on shape type
+        float width = 0;
+        float height = 0;
+
+        switch (currentShape) {
+            case ShapeType::RECTANGLE:
+                width = 100;  // Default width
+                height = 100; // Default height
+                break;
+            case ShapeType::CIRCLE:
+                width = 80;   // Default diameter
+                height = 80;  // Default diameter
+                break;
+            default:
+                width = 100;
+                height = 100;
+                break;
+        }
+
+        // Center the shape at the click point
+        newShape.start = {x - width/2, y - height/2};
+        newShape.end = {x + width/2, y + height/2};
+        newShape.id = nextId(ElementKind::SHAPE, shapes.size());
+        newShape.uid = newUid(newShape.id);
+        index.insert(newShape.id, shapeBounds(newShape));
+        damage.add(inkBounds(shapeBounds(newShape), newShape.thickness));
+        currentId = newShape.id;
+        if (streaming) streamShape(newShape);
+        shapes.push_back(newShape);
+        currentShapePtr = &shapes.back();
+    }
+}
+
+void Whiteboard::continueDrawing(float x, float y) {
+    if (currentShape == ShapeType::FREEHAND && currentId != NO_ELEMENT &&
+        index.contains(currentId) && refs[currentId].kind == ElementKind::LINE) {
+        Line& line = lines[refs[currentId].index];
+        uint32_t last = strokes.size(line.stroke) - 1;
+
+        // Reject samples too close to the last kept point, but remember
+        // the latest so the stroke still ends where the pointer did
+        float ddx = x - strokes.xs(line.stroke)[last];
+        float ddy = y - strokes.ys(line.stroke)[last];
+        if (ddx * ddx + ddy * ddy < minPointDistance * minPointDistance) {
+            pendingPoint = {x, y};
+            hasPendingPoint = true;
+            return;
+        }
+        hasPendingPoint = false;
+
+        continueDrawingPoint(line, x, y);
+    }
+    // Ignore continue events for shapes during creation
+}
+
+void Whiteboard::continueDrawingSamples(const float* samples, size_t count) {
+    if (currentShape != ShapeType::FREEHAND || !drawingLine()) return;
+    for (size_t i = 0; i < count; i++) {
+        const float* sample = samples + i * 3;
+        float x, y;
+        ink.filter(sample[0], sample[1], sample[2], x, y);
+        continueDrawing(x, y);
+        rawPoint = {sample[0], sample[1]};
+        hasRawPoint = true;
+    }
+    if (const Line* line = drawingLine()) updatePrediction(*line);
+}
+
+void Whiteboard::setInkPrediction(float horizon) {
+    predictionHorizon = std::max(horizon, 0.0f);
+    if (predictionHorizon == 0) clearPrediction();
+}
+
+void Whiteboard::endDrawing() {
+    finishStroke();
+    commitCurrent();
+    isDrawingShape = false;
+    currentShapePtr = nullptr;
 }
 
 void Whiteboard::startSelection(float x, float y) {
+    if (isSelecting) damageSelectionBox();
+    isSelecting = true;
     selectionStart = {x, y};
-    clearSelection();
+    selectionEnd = {x, y};
 }
 
 void Whiteboard::updateSelection(float x, float y) {
-    float left = std::min(x, selectionStart.x);
-    float top = std::min(y, selectionStart.y);
-    float right = std::max(x, selectionStart.x);
-    float bottom = std::max(y, selectionStart.y);
+    ScopedTimer timer(perf, PerfSection::HIT_TEST);
+    if (isSelecting) {
+        damageSelectionBox();
+        selectionEnd = {x, y};
+        damageSelectionBox();
+
+        Box area = selectionBox();
+        previousSelection.swap(selectedIds);
+        selectedIds.clear();
+
+        // Only elements whose bounds touch the box can be selected
+        index.query(area, queryHits);
+        if (pool.concurrency() > 1 && queryHits.size() >= PARALLEL_MIN_HITS) {
+            // Test in parallel, collect in order so selectedIds stays sorted
+            hitFlags.assign(queryHits.size(), 0);
+            pool.parallelFor(static_cast<uint32_t>(queryHits.size()), 256, [&](uint32_t begin, uint32_t end) {
+                for (uint32_t i = begin; i < end; i++) hitFlags[i] = selectionHits(queryHits[i], area);
+            });
+            for (size_t i = 0; i < queryHits.size(); i++) {
+                if (hitFlags[i]) selectedIds.push_back(queryHits[i]);
+            }
+        } else {
+            for (uint32_t id : queryHits) {
+                if (selectionHits(id, area)) selectedIds.push_back(id);
+            }
+        }
+
+        // Both lists are sorted; only elements whose state flips need repainting
+        size_t before = 0, after = 0;
+        while (before < previousSelection.size() || after < selectedIds.size()) {
+            if (after == selectedIds.size() ||
+                (before < previousSelection.size() && previousSelection[before] < selectedIds[after])) {
+                setSelected(previousSelection[before++], false);
+            } else if (before == previousSelection.size() || selectedIds[after] < previousSelection[before]) {
+                setSelected(selectedIds[after++], true);
+            } else {
+                before++;
+                after++;
+            }
+        }
+    }
+}
 
-    for (auto& element : elements) {
-        Rect bounds = element->getBounds();
-        bool intersects = !(bounds.x > right || 
-                          bounds.x + bounds.width < left ||
-                          bounds.y > bottom || 
-                          bounds.y + bounds.height < top);
-        element->selected = intersects;
-        if (intersects) {
-            selectedElements.push_back(element);
+uint32_t Whiteboard::selectedPointCount() const {
+    uint32_t total = 0;
+    for (uint32_t id : selectedIds) {
+        if (index.contains(id) && refs[id].kind == ElementKind::LINE) {
+            total += strokes.size(lines[refs[id].index].stroke);
         }
     }
+    return total;
+}
+
+bool Whiteboard::selectionHits(uint32_t id, const Box& area) const {
+    return visitElement(id, [&](const auto& element) { return selectionHits(element, area); });
+}
+
+bool Whiteboard::selectionHits(const Line& line, const Box& area) const {
+    return anyPointInBox(strokes.xs(line.stroke), strokes.ys(line.stroke),
+                         strokes.size(line.stroke), area);
+}
+
+bool Whiteboard::selectionHits(const Shape& shape, const Box& area) const {
+    Box bounds = shapeBounds(shape);
+    return bounds.minX >= area.minX && bounds.maxX <= area.maxX &&
+           bounds.minY >= area.minY && bounds.maxY <= area.maxY;
 }
 
 void Whiteboard::endSelection() {
+    if (isSelecting) damageSelectionBox();
+    isSelecting = false;
+}
+
+void Whiteboard::setSelected(uint32_t id, bool selected) {
+    if (!index.contains(id)) return; // erased while selected
+    visitElement(id, [&](auto& element) { element.selected = selected; });
+    // The element moves between the tiled and the live layer
+    tiles.invalidate(elementInk(id));
+    damageElement(id);
+}
+
+void Whiteboard::deselectAll() {
+    for (uint32_t id : selectedIds) {
+        setSelected(id, false);
+    }
+    selectedIds.clear();
+}
+
+void Whiteboard::clearSelection() {
+    deselectAll();
+    if (isSelecting) damageSelectionBox();
     isSelecting = false;
 }
 
 void Whiteboard::moveSelected(float dx, float dy) {
-    for (auto& element : selectedElements) {
-        element->move(dx, dy);
+    if (selectedIds.empty()) return;
+    if (pool.concurrency() > 1 && selectedPointCount() >= PARALLEL_MIN_POINTS) {
+        // Points move in parallel; the index and damage are shared, so they follow on this thread
+        for (uint32_t id : selectedIds) {
+            if (index.contains(id)) damageElement(id);
+        }
+        pool.parallelFor(static_cast<uint32_t>(selectedIds.size()), 16, [&](uint32_t begin, uint32_t end) {
+            for (uint32_t i = begin; i < end; i++) {
+                if (index.contains(selectedIds[i])) translateGeometry(selectedIds[i], dx, dy);
+            }
+        });
+        for (uint32_t id : selectedIds) {
+            if (!index.contains(id)) continue;
+            commitTranslation(id, dx, dy);
+            damageElement(id);
+        }
+    } else {
+        for (uint32_t id : selectedIds) {
+            if (!index.contains(id)) continue;
+            damageElement(id);
+            translateElement(id, dx, dy);
+            damageElement(id);
+        }
+    }
+
+    if (!recordHistory) return;
+    // A drag is many small moves of the same selection: one step
+    HistoryEntry* step = history.openEntry(HistoryEntry::Kind::MOVE);
+    if (step && step->ids == selectedIds) {
+        step->dx += dx;
+        step->dy += dy;
+        return;
     }
+    HistoryEntry entry;
+    entry.kind = HistoryEntry::Kind::MOVE;
+    entry.ids = selectedIds;
+    entry.dx = dx;
+    entry.dy = dy;
+    history.record(std::move(entry));
 }
 
 void Whiteboard::deleteSelected() {
-    elements.erase(
-        std::remove_if(elements.begin(), elements.end(),
-            [](const auto& element) { return element->selected; }),
-        elements.end()
-    );
-    selectedElements.clear();
+    if (recordHistory && !selectedIds.empty()) {
+        HistoryEntry entry;
+        entry.kind = HistoryEntry::Kind::DELETE;
+        for (uint32_t id : selectedIds) {
+            if (!index.contains(id)) continue;
+            entry.ids.push_back(id);
+            entry.elements.push_back(snapshotElement(id));
+        }
+        history.record(std::move(entry));
+        history.closeStep();
+    }
+
+    for (uint32_t id : selectedIds) {
+        if (!index.contains(id)) continue;
+        damageElement(id);
+        if (!applyingRemote) replicas.removed(uidOf(id));
+    }
+    compact(lines, [](const Line& line) { return line.selected; });
+    compact(shapes, [](const Shape& shape) { return shape.selected; });
+    selectedIds.clear();
 }
 
-void Whiteboard::clearSelection() {
-    for (auto& element : elements) {
-        element->selected = false;
+void Whiteboard::setColor(const std::string& color) {
+    currentColor = color;
+    // If we're currently drawing a shape, update its color
+    if (isDrawingShape && currentShapePtr) {
+        currentShapePtr->color = colors.intern(color);
+    }
+}
+
+void Whiteboard::setCurveFitting(float tolerance) {
+    tolerance = std::max(0.0f, std::min(tolerance, MAX_CURVE_TOLERANCE));
+    if (tolerance == curveTolerance) return;
+    curveTolerance = tolerance;
+    for (auto& line : lines) {
+        if (line.curve == NO_CURVE) continue;
+        curves.release(line.curve);
+        line.curve = NO_CURVE;
+        line.curveLoaded = false;
     }
-    selectedElements.clear();
+    damage.markAll();
+    tiles.clear();
+}
+
+#ifndef WHITEBOARD_HEADLESS
+const CommandBuffer& Whiteboard::drawCommands() {
+    perf.endFrame();
+    ScopedTimer timer(perf, PerfSection::DRAW);
+    commands.reset();
+    commands.viewTransform(viewScale, viewX, viewY);
+    queryVisible(queryHits);
+    forEachOfType<Line>(queryHits, [this](Line& line) { encodeLine(line); });
+    forEachOfType<Shape>(queryHits, [this](const Shape& shape) { encodeShape(shape); });
+    encodePrediction();
+    encodeSelectionBox();
+    damage.reset();
+    return commands;
+}
+
+const CommandBuffer& Whiteboard::drawDirtyCommands() {
+    perf.endFrame();
+    ScopedTimer timer(perf, PerfSection::DRAW);
+    commands.reset();
+    if (dropTiles) {
+        commands.tileDropAll();
+        dropTiles = false;
+    }
+
+    if (damage.isFull()) {
+        commands.clearCanvas();
+        commands.viewTransform(viewScale, viewX, viewY);
+        if (tilesEnabled) {
+            Box view = viewBox();
+            encodeTiles(&view, 1);
+            encodeLiveElements(&view, 1);
+        } else {
+            queryVisible(dirtyHits);
+            forEachOfType<Line>(dirtyHits, [this](Line& line) { encodeLine(line); });
+            forEachOfType<Shape>(dirtyHits, [this](const Shape& shape) { encodeShape(shape); });
+        }
+        encodePrediction();
+        encodeSelectionBox();
+        damage.reset();
+        return commands;
+    }
+
+    if (damage.isEmpty()) return commands;
+
+    // Damage off screen needs no repaint; moving the view repaints everything
+    visibleDamage.clear();
+    Box view = viewBox();
+    for (const auto& area : damage.areas()) {
+        if (!hasViewSize()) {
+            visibleDamage.push_back(area);
+        } else if (area.intersects(view)) {
+            visibleDamage.push_back({std::max(area.minX, view.minX), std::max(area.minY, view.minY),
+                                     std::min(area.maxX, view.maxX), std::min(area.maxY, view.maxY)});
+        }
+    }
+    damage.reset();
+    if (visibleDamage.empty()) return commands;
+
+    const std::vector<Box>& areas = visibleDamage;
+    commands.viewTransform(viewScale, viewX, viewY);
+    commands.save();
+    commands.beginPath();
+    for (const auto& area : areas) {
+        commands.rect(area.minX, area.minY, area.maxX - area.minX, area.maxY - area.minY);
+    }
+    commands.clip();
+    for (const auto& area : areas) {
+        commands.clearRect(area.minX, area.minY, area.maxX - area.minX, area.maxY - area.minY);
+    }
+
+    if (tilesEnabled) {
+        encodeTiles(areas.data(), areas.size());
+        encodeLiveElements(areas.data(), areas.size());
+    } else {
+        // Collect everything touching any damaged area; ids follow draw order
+        dirtyHits.clear();
+        for (const auto& area : areas) {
+            index.query(area, queryHits);
+            dirtyHits.insert(dirtyHits.end(), queryHits.begin(), queryHits.end());
+        }
+        std::sort(dirtyHits.begin(), dirtyHits.end());
+        dirtyHits.erase(std::unique(dirtyHits.begin(), dirtyHits.end()), dirtyHits.end());
+
+        forEachOfType<Line>(dirtyHits, [this](Line& line) { encodeLine(line); });
+        forEachOfType<Shape>(dirtyHits, [this](const Shape& shape) { encodeShape(shape); });
+    }
+    encodePrediction();
+    encodeSelectionBox();
+
+    commands.restore();
+    return commands;
+}
+#endif // WHITEBOARD_HEADLESS
+
+void Whiteboard::setTileCaching(bool enabled) {
+    if (enabled == tilesEnabled) return;
+    tilesEnabled = enabled;
+    tiles.clear();
+    dropTiles = true;
+    damage.markAll();
+}
+
+void Whiteboard::setViewSize(float width, float height) {
+    viewWidth = width;
+    viewHeight = height;
+    damage.markAll();
+}
+
+void Whiteboard::setViewport(float x, float y, float width, float height, float scale) {
+    if (!(scale > 0)) return;
+    if (x == viewX && y == viewY && width == viewWidth && height == viewHeight && scale == viewScale) return;
+    viewX = x;
+    viewY = y;
+    viewWidth = width;
+    viewHeight = height;
+    viewScale = scale;
+    damage.markAll();
+
+    // Tiles are rasterized at the level's zoom; they are redone when it changes
+    lodLevel = StrokeLod::levelFor(scale);
+    float zoom = 1.0f / static_cast<float>(1u << lodLevel);
+    if (zoom != tiles.zoom()) {
+        tiles.setZoom(zoom);
+        dropTiles = true;
+    }
+}
+
+void Whiteboard::invalidate(float x, float y, float width, float height) {
+    damage.add({x, y, x + width, y + height});
 }
 
 void Whiteboard::clear() {
-    init();
+    flushRemovals();
+    if (recordHistory && (!lines.empty() || !shapes.empty())) {
+        HistoryEntry entry;
+        entry.kind = HistoryEntry::Kind::CLEAR;
+        for (const auto& line : lines) entry.elements.push_back(snapshotElement(line.id));
+        for (const auto& shape : shapes) entry.elements.push_back(snapshotElement(shape.id));
+        history.record(std::move(entry));
+        history.closeStep();
+    }
+    if (!applyingRemote) {
+        for (const auto& line : lines) replicas.removed(line.uid);
+        for (const auto& shape : shapes) replicas.removed(shape.uid);
+    }
+
+    damage.markAll();
+    tiles.clear();
+    dropTiles = true;
+    currentId = NO_ELEMENT;
+    streamId = NO_ELEMENT;
+    predictionXs.clear();
+    predictionYs.clear();
+    hasRawPoint = false;
+    outgoing.clear();
+    remoteStrokes.clear();
+    remoteLive.clear();
+    uidToId.clear();
+    removedPending = 0;
+    maxInkPad = 0;
+    lines.clear();
+    shapes.clear();
+    strokes.clear();
+    lods.clear();
+    curves.clear();
+    index.clear();
+    // refs is kept: ids are never reused, so history entries stay valid
+    selectedIds.clear();
 }
 
 void Whiteboard::erase(float x, float y, float radius) {
-    elements.erase(
-        std::remove_if(elements.begin(), elements.end(),
-            [x, y, radius](const auto& element) {
-                return element->containsPoint(x, y);
-            }),
-        elements.end()
-    );
-}
-
-// Binding code for Emscripten
-EMSCRIPTEN_BINDINGS(whiteboard_module) {
-    emscripten::enum_<ShapeType>("ShapeType")
-        .value("FREEHAND", ShapeType::FREEHAND)
-        .value("RECTANGLE", ShapeType::RECTANGLE)
-        .value("CIRCLE", ShapeType::CIRCLE)
-        .value("LINE", ShapeType::LINE)
-        .value("TRIANGLE", ShapeType::TRIANGLE);
-
-    emscripten::class_<Whiteboard>("Whiteboard")
-        .constructor<>()
-        .function("init", &Whiteboard::init)
-        .function("startDrawing", &Whiteboard::startDrawing)
-        .function("continueDrawing", &Whiteboard::continueDrawing)
-        .function("endDrawing", &Whiteboard::endDrawing)
-        .function("setShapeType", &Whiteboard::setShapeType)
-        .function("setColor", &Whiteboard::setColor)
-        .function("setThickness", &Whiteboard::setThickness)
-        .function("draw", &Whiteboard::draw)
-        .function("clear", &Whiteboard::clear)
-        .function("erase", &Whiteboard::erase)
-        .function("startSelection", &Whiteboard::startSelection)
-        .function("updateSelection", &Whiteboard::updateSelection)
-        .function("endSelection", &Whiteboard::endSelection)
-        .function("moveSelected", &Whiteboard::moveSelected)
-        .function("deleteSelected", &Whiteboard::deleteSelected)
-        .function("clearSelection", &Whiteboard::clearSelection);
-} 
\ No newline at end of file
+    ScopedTimer timer(perf, PerfSection::ERASE);
+    bool linesRemoved = false;
+    bool shapesRemoved = false;
+
+    HistoryEntry* step = nullptr;
+
+    // Only elements whose bounds reach the eraser circle can be affected
+    index.query(Box::around(x, y, radius), queryHits);
+    for (uint32_t id : queryHits) {
+        const ElementRef& ref = refs[id];
+
+        if (ref.kind == ElementKind::LINE) {
+            if (beingDrawn(id)) continue;
+            Line& line = lines[ref.index];
+            if (!splitPolylineByCircle(strokes.xs(line.stroke), strokes.ys(line.stroke),
+                                       strokes.size(line.stroke), x, y, radius,
+                                       eraseScratchX, eraseScratchY, erasePieces)) {
+                continue;
+            }
+            if (!erasedAlready(id)) recordErased(step, snapshotElement(id));
+            touchElement(id);
+
+            if (erasePieces.empty()) {
+                // Dropped from the grid now, compacted out below
+                if (!applyingRemote) replicas.removed(line.uid);
+                index.remove(id);
+                linesRemoved = true;
+                continue;
+            }
+
+            // The first piece stays in this line
+            strokes.truncate(line.stroke, 0);
+            line.bounds = Box();
+            for (uint32_t i = 0; i < erasePieces[0]; i++) addPoint(line, eraseScratchX[i], eraseScratchY[i]);
+            index.update(id, line.bounds);
+            if (!applyingRemote) replicas.write(line.uid, ReplicaSet::GEOMETRY);
+
+            // `line` is not used past here: adding pieces may reallocate `lines`
+            for (size_t piece = 1; piece < erasePieces.size(); piece++) {
+                uint32_t pieceId = splitOff(id, erasePieces[piece - 1], erasePieces[piece]);
+                if (recordHistory) {
+                    openEraseStep(step);
+                    step->added.push_back(pieceId);
+                }
+            }
+        } else {
+            Shape& shape = shapes[ref.index];
+            float centerX = (shape.start.x + shape.end.x) / 2;
+            float centerY = (shape.start.y + shape.end.y) / 2;
+            float dx = x - centerX;
+            float dy = y - centerY;
+            float distance = std::sqrt(dx * dx + dy * dy);
+
+            if (distance < radius) {
+                if (!erasedAlready(id)) recordErased(step, snapshotElement(id));
+                damageElement(id);
+                tiles.invalidate(elementInk(id));
+                if (!applyingRemote) replicas.removed(shape.uid);
+                index.remove(id);
+                shapesRemoved = true;
+            }
+        }
+    }
+
+    if (linesRemoved) {
+        compact(lines, [this](const Line& line) { return !index.contains(line.id); });
+    }
+    if (shapesRemoved) {
+        compact(shapes, [this](const Shape& shape) { return !index.contains(shape.id); });
+    }
+
+    if (step) history.amended();
+}
+
+uint32_t Whiteboard::splitOff(uint32_t original, uint32_t from, uint32_t to) {
+    const Line& source = lines[refs[original].index];
+    Line piece;
+    piece.id = nextId(ElementKind::LINE, lines.size());
+    piece.uid = newUid(piece.id);
+    piece.stroke = strokes.create();
+    piece.color = source.color;
+    piece.thickness = source.thickness;
+    for (uint32_t i = from; i < to; i++) addPoint(piece, eraseScratchX[i], eraseScratchY[i]);
+    index.insert(piece.id, piece.bounds);
+    uint32_t id = piece.id;
+    lines.push_back(std::move(piece));
+    commitElement(id);
+    if (!applyingRemote) replicas.created(uidOf(id));
+    return id;
+}
+
+bool Whiteboard::undo() {
+    endDrawing();
+    if (!history.canUndo()) return false;
+
+    HistoryEntry entry = history.takeUndo();
+    recordHistory = false;
+    switch (entry.kind) {
+        case HistoryEntry::Kind::ADD:
+            // Capture the element now so redo can bring it back
+            entry.elements.clear();
+            for (uint32_t id : entry.ids) {
+                if (index.contains(id)) entry.elements.push_back(snapshotElement(id));
+            }
+            removeElements(entry.ids);
+            break;
+        case HistoryEntry::Kind::MOVE:
+            for (uint32_t id : entry.ids) {
+                if (!index.contains(id)) continue;
+                touchElement(id);
+                translateElement(id, -entry.dx, -entry.dy);
+                touchElement(id);
+            }
+            break;
+        case HistoryEntry::Kind::ERASE:
+            // Capture what the gesture left so redo can bring it back
+            entry.after.clear();
+            for (uint32_t id : entry.ids) {
+                if (index.contains(id)) entry.after.push_back(snapshotElement(id));
+            }
+            for (uint32_t id : entry.added) {
+                if (index.contains(id)) entry.after.push_back(snapshotElement(id));
+            }
+            removeElements(entry.added);
+            restoreElements(entry.elements, entry.ids);
+            break;
+        case HistoryEntry::Kind::DELETE:
+        case HistoryEntry::Kind::CLEAR:
+            restoreElements(entry.elements, entry.ids);
+            break;
+    }
+    recordHistory = true;
+    history.pushRedo(std::move(entry));
+    return true;
+}
+
+bool Whiteboard::redo() {
+    endDrawing();
+    if (!history.canRedo()) return false;
+
+    HistoryEntry entry = history.takeRedo();
+    recordHistory = false;
+    switch (entry.kind) {
+        case HistoryEntry::Kind::ADD:
+            restoreElements(entry.elements, entry.ids);
+            entry.elements.clear();
+            break;
+        case HistoryEntry::Kind::MOVE:
+            for (uint32_t id : entry.ids) {
+                if (!index.contains(id)) continue;
+                touchElement(id);
+                translateElement(id, entry.dx, entry.dy);
+                touchElement(id);
+            }
+            break;
+        case HistoryEntry::Kind::ERASE: {
+            // Erased elements absent from the capture were erased completely
+            std::vector<uint32_t> gone;
+            size_t survivor = 0;
+            for (uint32_t id : entry.ids) {
+                if (survivor < entry.after.size() && entry.after[survivor].id == id) {
+                    survivor++;
+                } else {
+                    gone.push_back(id);
+                }
+            }
+            removeElements(gone);
+            for (const auto& element : entry.after) restoreElement(element);
+            entry.after.clear();
+            break;
+        }
+        case HistoryEntry::Kind::DELETE:
+            removeElements(entry.ids);
+            break;
+        case HistoryEntry::Kind::CLEAR:
+            clear();
+            break;
+    }
+    recordHistory = true;
+    history.pushUndo(std::move(entry));
+    return true;
+}
+
+void Whiteboard::setSiteId(uint32_t site) {
+    siteId = site;
+    replicas.setSite(site);
+}
+
+bool Whiteboard::moveElement(uint64_t uid, float dx, float dy) {
+    uint32_t id = findUid(uid);
+    if (id == NO_ELEMENT) return false;
+
+    touchElement(id);
+    translateElement(id, dx, dy);
+    touchElement(id);
+
+    if (recordHistory) {
+        std::vector<uint32_t> ids(1, id);
+        HistoryEntry* step = history.openEntry(HistoryEntry::Kind::MOVE);
+        if (step && step->ids == ids) {
+            step->dx += dx;
+            step->dy += dy;
+        } else {
+            HistoryEntry entry;
+            entry.kind = HistoryEntry::Kind::MOVE;
+            entry.ids = std::move(ids);
+            entry.dx = dx;
+            entry.dy = dy;
+            history.record(std::move(entry));
+        }
+    }
+    return true;
+}
+
+bool Whiteboard::removeElement(uint64_t uid) {
+    uint32_t id = findUid(uid);
+    if (id == NO_ELEMENT) return false;
+
+    if (recordHistory) {
+        HistoryEntry entry;
+        entry.kind = HistoryEntry::Kind::DELETE;
+        entry.ids.push_back(id);
+        entry.elements.push_back(snapshotElement(id));
+        history.record(std::move(entry));
+        history.closeStep();
+    }
+    if (!applyingRemote) replicas.removed(uid);
+
+    touchElement(id);
+    auto selected = std::lower_bound(selectedIds.begin(), selectedIds.end(), id);
+    if (selected != selectedIds.end() && *selected == id) selectedIds.erase(selected);
+    if (refs[id].kind == ElementKind::LINE) {
+        if (streamId == id) streamId = NO_ELEMENT;
+        // A peer may delete a stroke another peer is still streaming
+        auto live = std::lower_bound(remoteLive.begin(), remoteLive.end(), id);
+        if (live != remoteLive.end() && *live == id) remoteLive.erase(live);
+        remoteStrokes.erase(uid);
+        if (currentId == id) {
+            clearPrediction();
+            hasRawPoint = false;
+            currentId = NO_ELEMENT;
+        }
+    } else if (currentId == id) {
+        currentId = NO_ELEMENT;
+        isDrawingShape = false;
+        currentShapePtr = nullptr;
+    }
+    index.remove(id);
+
+    removedPending++;
+    if (removedPending > 64 && removedPending * 4 > lines.size() + shapes.size()) flushRemovals();
+    return true;
+}
+
+const std::vector<uint64_t>& Whiteboard::getSelectedIds() {
+    selectedUids.clear();
+    for (uint32_t id : selectedIds) {
+        if (index.contains(id)) selectedUids.push_back(uidOf(id));
+    }
+    return selectedUids;
+}
+
+void Whiteboard::setStrokeStreaming(bool enabled) {
+    streaming = enabled;
+    if (!enabled) {
+        outgoing.clear();
+        streamId = NO_ELEMENT;
+    }
+}
+
+const std::vector<uint8_t>& Whiteboard::takeStrokeBatch() {
+    flushStreamPoints();
+    strokeBatch.clear();
+    if (outgoing.size() > 0) {
+        strokeBatch.u8(STREAM_VERSION);
+        strokeBatch.bytes(outgoing.data().data(), outgoing.size());
+        outgoing.clear();
+    }
+    return strokeBatch.data();
+}
+
+bool Whiteboard::applyStrokeBatch(const std::string& sender, const uint8_t* data, size_t size) {
+    ScopedTimer timer(perf, PerfSection::SYNC);
+    return readStrokeBatch(remoteSenderIndex(sender), data, size);
+}
+
+void Whiteboard::dropRemoteSender(const std::string& sender) {
+    auto found = remoteSenders.find(sender);
+    if (found == remoteSenders.end()) return;
+    for (auto it = remoteStrokes.begin(); it != remoteStrokes.end();) {
+        if (it->second.sender == found->second) {
+            endRemoteStroke(it->second.id);
+            it = remoteStrokes.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+bool Whiteboard::beginRemoteStroke(const std::string& sender, uint64_t uid, const std::string& color,
+                                   float thickness, float x, float y) {
+    if (uidToId.count(uid)) return false;
+    startRemoteStroke(uid, remoteSenderIndex(sender), color, thickness, x, y,
+                      quantize(x, SCENE_QUANTIZATION), quantize(y, SCENE_QUANTIZATION));
+    return true;
+}
+
+bool Whiteboard::appendPoints(uint64_t uid, const float* xy, size_t count) {
+    auto it = remoteStrokes.find(uid);
+    if (it == remoteStrokes.end() || !index.contains(it->second.id)) return false;
+    if (count == 0) return true;
+
+    Line& line = lines[refs[it->second.id].index];
+    uint32_t last = strokes.size(line.stroke) - 1;
+    Box added;
+    added.extend(strokes.xs(line.stroke)[last], strokes.ys(line.stroke)[last]);
+    for (size_t i = 0; i < count; i++) {
+        float x = xy[2 * i];
+        float y = xy[2 * i + 1];
+        addPoint(line, x, y);
+        added.extend(x, y);
+    }
+    damage.add(inkBounds(added, line.thickness));
+    index.update(line.id, line.bounds);
+
+    // Batches that continue this stroke send deltas from its last point
+    it->second.qx = quantize(xy[2 * count - 2], SCENE_QUANTIZATION);
+    it->second.qy = quantize(xy[2 * count - 1], SCENE_QUANTIZATION);
+    return true;
+}
+
+bool Whiteboard::finishRemoteStroke(uint64_t uid, float tolerance) {
+    auto it = remoteStrokes.find(uid);
+    if (it == remoteStrokes.end()) return false;
+    uint32_t id = it->second.id;
+    remoteStrokes.erase(it);
+    if (index.contains(id)) simplifyLine(lines[refs[id].index], tolerance);
+    endRemoteStroke(id);
+    return true;
+}
+
+bool Whiteboard::setElementStyle(uint64_t uid, const std::string& color, float thickness) {
+    uint32_t id = findUid(uid);
+    if (id == NO_ELEMENT) return false;
+    applyStyle(id, color, thickness);
+    if (!applyingRemote && id != currentId) replicas.write(uid, ReplicaSet::STYLE);
+    return true;
+}
+
+const std::vector<uint8_t>& Whiteboard::collectLocalOps() {
+    opsBatch.clear();
+    if (!replicas.pending().empty()) {
+        opsBatch.u8(OPS_VERSION);
+        for (uint64_t uid : replicas.pending()) {
+            writeOps(opsBatch, uid, replicas.pendingFields(uid));
+        }
+        replicas.clearPending();
+    }
+    return opsBatch.data();
+}
+
+bool Whiteboard::applyRemoteOps(const uint8_t* data, size_t size) {
+    ScopedTimer timer(perf, PerfSection::SYNC);
+    return readOps(data, size);
+}
+
+const std::vector<uint8_t>& Whiteboard::snapshotOps() {
+    ScopedTimer timer(perf, PerfSection::SERIALIZE);
+    flushRemovals();
+    snapshotBytes.clear();
+    snapshotBytes.u8(OPS_VERSION);
+    for (const auto& line : lines) writeElement(snapshotBytes, line.uid, replicas.at(line.uid), line.id);
+    for (const auto& shape : shapes) writeElement(snapshotBytes, shape.uid, replicas.at(shape.uid), shape.id);
+    for (const auto& entry : replicas.elements()) {
+        if (!entry.second.present()) writeElement(snapshotBytes, entry.first, entry.second, NO_ELEMENT);
+    }
+    return snapshotBytes.data();
+}
+
+bool Whiteboard::loadOps(const uint8_t* data, size_t size) {
+    ScopedTimer timer(perf, PerfSection::DESERIALIZE);
+    resetBoard();
+    return applyRemoteOps(data, size);
+}
+
+const std::vector<uint8_t>& Whiteboard::serialize() {
+    ScopedTimer timer(perf, PerfSection::SERIALIZE);
+    writeScene(sceneBytes);
+    return sceneBytes.data();
+}
+
+bool Whiteboard::deserialize(const uint8_t* data, size_t size) {
+    ScopedTimer timer(perf, PerfSection::DESERIALIZE);
+    return readScene(data, size);
+}
+
+std::string Whiteboard::getSVGPaths() {
+    ScopedTimer timer(perf, PerfSection::EXPORT);
+    flushRemovals();
+    svgOut.clear();
+    for (auto& line : lines) writeSvgLine(line);
+    for (const auto& shape : shapes) writeSvgShape(shape);
+    return std::string(svgOut.data().begin(), svgOut.data().end());
+}
+
+void Whiteboard::beginSVGExport(uint32_t decimals) {
+    svgOut.setDecimals(decimals);
+    svgExporting = true;
+    svgShapes = false;
+    svgNextId = 0;
+    svgEndId = static_cast<uint32_t>(refs.size());
+}
+
+const std::vector<uint8_t>& Whiteboard::nextSVGChunk(uint32_t maxBytes) {
+    ScopedTimer timer(perf, PerfSection::EXPORT);
+    svgOut.clear();
+    if (svgExporting) {
+        flushRemovals();
+        size_t limit = std::max<size_t>(maxBytes, 1);
+        if (!svgShapes && !writeSvgElements(lines, limit, [this](Line& line) { writeSvgLine(line); })) {
+            svgShapes = true;
+            svgNextId = 0;
+        }
+        if (svgShapes && !writeSvgElements(shapes, limit, [this](const Shape& shape) { writeSvgShape(shape); })) {
+            svgExporting = false;
+        }
+    }
+    return svgOut.data();
+}
+
+const std::vector<uint8_t>& Whiteboard::renderImage(float x, float y, float scale, uint32_t width, uint32_t height,
+                                                    const std::string& background, uint32_t format) {
+    ScopedTimer timer(perf, PerfSection::EXPORT);
+    imageBytes.clear();
+    if (width == 0 || height == 0 || width > MAX_IMAGE_SIDE || height > MAX_IMAGE_SIDE || !(scale > 0)) {
+        return imageBytes;
+    }
+    flushRemovals();
+
+    uint32_t backgroundColor = 0;
+    parseHexColor(background, backgroundColor);
+
+    // Elements whose ink reaches the image
+    Box area = {x - maxInkPad, y - maxInkPad, x + width / scale + maxInkPad, y + height / scale + maxInkPad};
+    index.query(area, queryHits);
+
+    // Horizontal bands render independently, so threads can share the image
+    uint32_t bands = std::max(1u, std::min(height / MIN_BAND_ROWS, pool.concurrency() * 4));
+    if (pool.concurrency() == 1) bands = 1;
+    if (rasters.size() < bands) rasters.resize(bands);
+    size_t stride = static_cast<size_t>(width) * 4;
+    if (bands > 1) imagePixels.resize(stride * height);
+
+    pool.parallelFor(bands, 1, [&](uint32_t first, uint32_t last) {
+        for (uint32_t band = first; band < last; band++) {
+            uint32_t top = static_cast<uint32_t>(static_cast<uint64_t>(height) * band / bands);
+            uint32_t bottom = static_cast<uint32_t>(static_cast<uint64_t>(height) * (band + 1) / bands);
+            Rasterizer& raster = rasters[band];
+            raster.reset(width, bottom - top, backgroundColor);
+            raster.setTransform(scale, x, y, top);
+            rasterizeElements(raster, queryHits);
+            if (bands > 1) {
+                std::copy(raster.pixels().begin(), raster.pixels().end(), imagePixels.begin() + top * stride);
+            }
+        }
+    });
+
+    const std::vector<uint8_t>& pixels = bands > 1 ? imagePixels : rasters[0].pixels();
+    switch (static_cast<ImageFormat>(format)) {
+        case ImageFormat::PNG:
+            encodePNG(pixels.data(), width, height, imageBytes, &pool);
+            break;
+        case ImageFormat::QOI:
+            encodeQOI(pixels.data(), width, height, imageBytes);
+            break;
+        default:
+            return pixels;
+    }
+    return imageBytes;
+}
+
+WhiteboardStats Whiteboard::getStats() const {
+    WhiteboardStats stats;
+    stats.lines = static_cast<uint32_t>(lines.size());
+    stats.shapes = static_cast<uint32_t>(shapes.size());
+    stats.points = static_cast<uint32_t>(strokes.livePoints());
+
+    size_t bytes = lines.capacity() * sizeof(Line) + shapes.capacity() * sizeof(Shape) +
+                   refs.capacity() * sizeof(ElementRef) +
+                   (strokes.poolSize() + lods.poolSize() + curves.poolSize()) * 2 * sizeof(float) +
+                   history.size() + commands.size() * sizeof(float);
+    stats.bytesInUse = static_cast<uint32_t>(std::min<size_t>(bytes, UINT32_MAX));
+
+    stats.frames = perf.frames();
+    stats.boundaryCalls = perf.lastFrameCalls();
+    stats.commandFloats = static_cast<uint32_t>(commands.size());
+    stats.timingsWritten = perf.written();
+    stats.drawMs = perf.last(PerfSection::DRAW);
+    stats.hitTestMs = perf.last(PerfSection::HIT_TEST);
+    stats.eraseMs = perf.last(PerfSection::ERASE);
+    stats.serializeMs = perf.last(PerfSection::SERIALIZE);
+    stats.deserializeMs = perf.last(PerfSection::DESERIALIZE);
+    stats.exportMs = perf.last(PerfSection::EXPORT);
+    stats.syncMs = perf.last(PerfSection::SYNC);
+    return stats;
+}
@@ -0,0 +1,140 @@
+#include "../../include/wasm/work_pool.hpp"
+#include <algorithm>
+
+#ifndef WHITEBOARD_THREADS
+
+WorkPool::WorkPool() {}
+
+WorkPool::~WorkPool() {}
+
+void WorkPool::setHelpers(uint32_t) {}
+
+void WorkPool::parallelFor(uint32_t count, uint32_t, const Task& task) {
+    if (count > 0) task(0, count);
+}
+
+#else
+
+// Set on pool threads and on the caller while it runs a task
+static thread_local bool insideTask = false;
+
+WorkPool::WorkPool() {
+    uint32_t cores = std::thread::hardware_concurrency();
+    helperCount = std::min(cores > 1 ? cores - 1 : 0, MAX_HELPERS);
+}
+
+WorkPool::~WorkPool() {
+    stop();
+}
+
+void WorkPool::setHelpers(uint32_t count) {
+    count = std::min(count, MAX_HELPERS);
+    if (count == helperCount) return;
+    stop();
+    helperCount = count;
+}
+
+void WorkPool::start() {
+    queues.clear();
+    for (uint32_t i = 0; i <= helperCount; i++) queues.push_back(std::make_unique<Queue>());
+    stopping = false;
+    for (uint32_t i = 1; i <= helperCount; i++) {
+        threads.emplace_back([this, i] { helperLoop(i); });
+    }
+}
+
+void WorkPool::stop() {
+    {
+        std::lock_guard<std::mutex> guard(wakeLock);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& thread : threads) thread.join();
+    threads.clear();
+}
+
+void WorkPool::helperLoop(uint32_t self) {
+    insideTask = true;
+    uint64_t seen = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> guard(wakeLock);
+            wake.wait(guard, [&] { return stopping || generation != seen; });
+            if (stopping) return;
+            seen = generation;
+        }
+        drain(self);
+    }
+}
+
+bool WorkPool::take(uint32_t self, Range& range) {
+    // Own work from the front, in order, for locality
+    {
+        Queue& own = *queues[self];
+        std::lock_guard<std::mutex> guard(own.lock);
+        if (!own.ranges.empty()) {
+            range = own.ranges.front();
+            own.ranges.pop_front();
+            return true;
+        }
+    }
+    // Otherwise steal from the back of the others, starting with the next one
+    for (size_t offset = 1; offset < queues.size(); offset++) {
+        Queue& victim = *queues[(self + offset) % queues.size()];
+        std::lock_guard<std::mutex> guard(victim.lock);
+        if (!victim.ranges.empty()) {
+            range = victim.ranges.back();
+            victim.ranges.pop_back();
+            return true;
+        }
+    }
+    return false;
+}
+
+void WorkPool::drain(uint32_t self) {
+    Range range;
+    while (take(self, range)) {
+        (*current)(range.begin, range.end);
+        pending.fetch_sub(1, std::memory_order_release);
+    }
+}
+
+void WorkPool::parallelFor(uint32_t count, uint32_t grain, const Task& task) {
+    if (count == 0) return;
+    grain = std::max(grain, 1u);
+    if (helperCount == 0 || count <= grain || insideTask) {
+        task(0, count);
+        return;
+    }
+    if (threads.empty()) start();
+
+    // Each participant starts with a contiguous share of the chunks
+    uint32_t chunks = (count + grain - 1) / grain;
+    uint32_t participants = static_cast<uint32_t>(queues.size());
+    current = &task;
+    pending.store(chunks, std::memory_order_relaxed);
+    for (uint32_t p = 0; p < participants; p++) {
+        uint32_t first = static_cast<uint32_t>(static_cast<uint64_t>(chunks) * p / participants);
+        uint32_t last = static_cast<uint32_t>(static_cast<uint64_t>(chunks) * (p + 1) / participants);
+        Queue& queue = *queues[p];
+        std::lock_guard<std::mutex> guard(queue.lock);
+        for (uint32_t c = first; c < last; c++) {
+            queue.ranges.push_back({c * grain, std::min(count, (c + 1) * grain)});
+        }
+    }
+    {
+        std::lock_guard<std::mutex> guard(wakeLock);
+        generation++;
+    }
+    wake.notify_all();
+
+    insideTask = true;
+    drain(0);
+    insideTask = false;
+
+    // The browser main thread may not block on a futex; the wait is short, so spin
+    while (pending.load(std::memory_order_acquire) != 0) std::this_thread::yield();
+    current = nullptr;
+}
+
+#endif
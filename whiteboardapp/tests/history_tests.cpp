@@ -0,0 +1,289 @@
+/**
+ * @file history_tests.cpp
+ * @brief Undo and redo of each kind of step, alone and between peers
+ *
+ * Boards are compared through serialize(), which holds every element's
+ * uid, style and geometry in draw order.
+ */
+
+#include "test.hpp"
+#include <algorithm>
+
+static void drawShape(Whiteboard& board, ShapeType type, float x0, float y0, float x1, float y1) {
+    board.setShapeType(type);
+    board.startDrawing(x0, y0);
+    board.continueDrawing(x1, y1);
+    board.endDrawing();
+    board.setShapeType(ShapeType::FREEHAND);
+}
+
+// Peers agree on which elements exist, not on the draw order of ones
+// added concurrently or restored by an undo
+static std::vector<uint64_t> sortedUids(Whiteboard& board) {
+    std::vector<uint64_t> uids = boardUids(board);
+    std::sort(uids.begin(), uids.end());
+    return uids;
+}
+
+static void selectArea(Whiteboard& board, float x0, float y0, float x1, float y1) {
+    board.startSelection(x0, y0);
+    board.updateSelection(x1, y1);
+    board.endSelection();
+}
+
+TEST(undoRedoAdd) {
+    Whiteboard board;
+    initBoard(board, 1);
+    std::vector<uint8_t> empty = board.serialize();
+    drawStroke(board, {10, 10, 40, 30, 80, 20});
+    drawShape(board, ShapeType::RECTANGLE, 100, 100, 150, 140);
+    std::vector<uint8_t> drawn = board.serialize();
+
+    CHECK(board.undo());
+    CHECK(boardUids(board) == std::vector<uint64_t>{uidOf(1, 1)});
+    CHECK(board.undo());
+    CHECK(board.serialize() == empty);
+    CHECK(!board.undo());
+
+    CHECK(board.redo());
+    CHECK(board.redo());
+    CHECK(!board.redo());
+    CHECK(board.serialize() == drawn);
+}
+
+TEST(undoRedoMove) {
+    Whiteboard board;
+    initBoard(board, 1);
+    drawStroke(board, {10, 10, 40, 30, 80, 20});
+    drawShape(board, ShapeType::CIRCLE, 100, 100, 150, 140);
+    std::vector<uint8_t> before = board.serialize();
+
+    // One drag of several moves is one step
+    selectArea(board, 0, 0, 200, 200);
+    board.moveSelected(10, 5);
+    board.moveSelected(-3, 8);
+    board.endHistoryStep();
+    board.clearSelection();
+    std::vector<uint8_t> moved = board.serialize();
+    CHECK(moved != before);
+
+    CHECK(board.undo());
+    CHECK(board.serialize() == before);
+    CHECK(board.redo());
+    CHECK(board.serialize() == moved);
+
+    CHECK(board.moveElement(uidOf(1, 2), 20, 0));
+    CHECK(board.undo());
+    CHECK(board.serialize() == moved);
+}
+
+TEST(undoRedoErase) {
+    Whiteboard board;
+    initBoard(board, 1);
+    drawStroke(board, {0, 50, 20, 50, 40, 50, 60, 50, 80, 50, 100, 50, 120, 50});
+    drawShape(board, ShapeType::RECTANGLE, 200, 200, 220, 220);
+    std::vector<uint8_t> before = board.serialize();
+
+    // Cuts the line in two and removes the rectangle
+    board.erase(60, 50, 8);
+    board.erase(200, 200, 5);
+    board.endHistoryStep();
+    std::vector<uint8_t> erased = board.serialize();
+    CHECK(boardUids(board).size() == 2);
+    CHECK(!board.hasElement(uidOf(1, 2)));
+
+    CHECK(board.undo());
+    CHECK(board.serialize() == before);
+    CHECK(board.redo());
+    CHECK(board.serialize() == erased);
+    CHECK(board.undo());
+    CHECK(board.serialize() == before);
+}
+
+TEST(undoRedoDelete) {
+    Whiteboard board;
+    initBoard(board, 1);
+    drawStroke(board, {10, 10, 40, 30, 80, 20});
+    drawStroke(board, {10, 100, 40, 130, 80, 120});
+    drawShape(board, ShapeType::TRIANGLE, 200, 200, 240, 240);
+    std::vector<uint8_t> before = board.serialize();
+
+    selectArea(board, 0, 90, 300, 300);
+    board.deleteSelected();
+    CHECK(boardUids(board) == std::vector<uint64_t>{uidOf(1, 1)});
+    std::vector<uint8_t> deleted = board.serialize();
+
+    CHECK(board.removeElement(uidOf(1, 1)));
+    CHECK(boardUids(board).empty());
+
+    CHECK(board.undo());
+    CHECK(board.serialize() == deleted);
+    CHECK(board.undo());
+    CHECK(board.serialize() == before);
+    CHECK(board.redo());
+    CHECK(board.redo());
+    CHECK(boardUids(board).empty());
+}
+
+TEST(undoRedoClear) {
+    Whiteboard board;
+    initBoard(board, 1);
+    drawStroke(board, {10, 10, 40, 30, 80, 20});
+    drawShape(board, ShapeType::LINE, 100, 100, 150, 140);
+    std::vector<uint8_t> before = board.serialize();
+
+    board.clear();
+    CHECK(boardUids(board).empty());
+    CHECK(board.undo());
+    CHECK(board.serialize() == before);
+    CHECK(board.hasElement(uidOf(1, 1)));
+    CHECK(board.hasElement(uidOf(1, 2)));
+    CHECK(board.redo());
+    CHECK(boardUids(board).empty());
+    CHECK(board.undo());
+    CHECK(board.serialize() == before);
+}
+
+// Every kind of step, undone back to an empty board and redone again
+TEST(undoRedoMixedSteps) {
+    Whiteboard board;
+    initBoard(board, 1);
+    std::vector<std::vector<uint8_t>> states;
+    states.push_back(board.serialize());
+
+    drawStroke(board, {0, 50, 20, 50, 40, 50, 60, 50, 80, 50, 100, 50, 120, 50});
+    states.push_back(board.serialize());
+    drawShape(board, ShapeType::RECTANGLE, 200, 200, 240, 230);
+    states.push_back(board.serialize());
+    CHECK(board.moveElement(uidOf(1, 2), 15, -5));
+    board.endHistoryStep();
+    states.push_back(board.serialize());
+    board.erase(60, 50, 8);
+    board.endHistoryStep();
+    states.push_back(board.serialize());
+    CHECK(board.removeElement(uidOf(1, 2)));
+    states.push_back(board.serialize());
+    board.clear();
+    states.push_back(board.serialize());
+
+    for (size_t i = states.size() - 1; i > 0; i--) {
+        CHECK(board.undo());
+        CHECK(board.serialize() == states[i - 1]);
+    }
+    CHECK(!board.undo());
+    for (size_t i = 1; i < states.size(); i++) {
+        CHECK(board.redo());
+        CHECK(board.serialize() == states[i]);
+    }
+    CHECK(!board.redo());
+}
+
+TEST(newStepDropsRedo) {
+    Whiteboard board;
+    initBoard(board, 1);
+    drawStroke(board, {10, 10, 40, 30, 80, 20});
+    drawStroke(board, {10, 100, 40, 130, 80, 120});
+    CHECK(board.undo());
+    CHECK(board.canRedo());
+    drawStroke(board, {200, 10, 240, 30});
+    CHECK(!board.canRedo());
+    CHECK(!board.redo());
+    CHECK(boardUids(board) == (std::vector<uint64_t>{uidOf(1, 1), uidOf(1, 3)}));
+}
+
+// Undo only reverts local steps; a peer's edit in between stays
+TEST(undoAroundRemoteMove) {
+    Whiteboard a, b;
+    initBoard(a, 1);
+    initBoard(b, 2);
+    drawStroke(a, {10, 10, 40, 30, 80, 20});
+    sync(a, b);
+    uint64_t uid = uidOf(1, 1);
+
+    CHECK(a.moveElement(uid, 10, 0));
+    a.endHistoryStep();
+    sync(a, b);
+    CHECK(b.moveElement(uid, 0, 20));
+    sync(a, b);
+    CHECK(a.serialize() == b.serialize());
+    CHECK(!a.canRedo());
+
+    // The peer's move is not in A's history, and it merges as a total offset
+    CHECK(a.undo());
+    sync(a, b);
+    CHECK(a.serialize() == b.serialize());
+    CHECK(a.redo());
+    sync(a, b);
+    CHECK(a.serialize() == b.serialize());
+    CHECK(boardUids(b) == std::vector<uint64_t>{uid});
+}
+
+TEST(undoAddAndRedoBetweenPeers) {
+    Whiteboard a, b;
+    initBoard(a, 1);
+    initBoard(b, 2);
+    drawStroke(a, {10, 10, 40, 30, 80, 20});
+    drawStroke(b, {10, 100, 40, 130, 80, 120});
+    sync(a, b);
+    std::vector<uint64_t> both = sortedUids(a);
+    CHECK(sortedUids(b) == both);
+
+    CHECK(a.undo());
+    sync(a, b);
+    CHECK(boardUids(a) == std::vector<uint64_t>{uidOf(2, 1)});
+    CHECK(boardUids(b) == std::vector<uint64_t>{uidOf(2, 1)});
+
+    CHECK(a.redo());
+    sync(a, b);
+    CHECK(sortedUids(a) == both);
+    CHECK(sortedUids(b) == both);
+
+    // B's undo does not touch A's stroke
+    CHECK(b.undo());
+    sync(a, b);
+    CHECK(boardUids(a) == std::vector<uint64_t>{uidOf(1, 1)});
+    CHECK(a.serialize() == b.serialize());
+}
+
+TEST(undoAfterPeerRemovedElement) {
+    Whiteboard a, b;
+    initBoard(a, 1);
+    initBoard(b, 2);
+    drawStroke(a, {10, 10, 40, 30, 80, 20});
+    sync(a, b);
+    uint64_t uid = uidOf(1, 1);
+    CHECK(b.removeElement(uid));
+    sync(a, b);
+    CHECK(!a.hasElement(uid));
+
+    // The stroke is already gone; undoing and redoing its ADD leaves it gone
+    CHECK(a.undo());
+    CHECK(a.redo());
+    sync(a, b);
+    CHECK(boardUids(a).empty());
+    CHECK(boardUids(b).empty());
+
+    // B undoes its delete, which brings the stroke back on both boards
+    CHECK(b.undo());
+    sync(a, b);
+    CHECK(a.hasElement(uid));
+    CHECK(a.serialize() == b.serialize());
+}
+
+TEST(undoClearBetweenPeers) {
+    Whiteboard a, b;
+    initBoard(a, 1);
+    initBoard(b, 2);
+    drawStroke(a, {10, 10, 40, 30, 80, 20});
+    drawShape(b, ShapeType::CIRCLE, 100, 100, 150, 140);
+    sync(a, b);
+    std::vector<uint8_t> both = a.serialize();
+
+    a.clear();
+    sync(a, b);
+    CHECK(boardUids(b).empty());
+    CHECK(a.undo());
+    sync(a, b);
+    CHECK(a.serialize() == both);
+    CHECK(b.serialize() == both);
+}
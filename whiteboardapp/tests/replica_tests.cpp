@@ -0,0 +1,71 @@
+/**
+ * @file replica_tests.cpp
+ * @brief Two boards editing one room converge
+ *
+ * Each test drives two engines the way two browsers would, exchanging
+ * collectLocalOps() through sync(), and checks both end with the same
+ * elements and can still address them by uid.
+ */
+
+#include "test.hpp"
+
+// B's removal is still waiting for compaction when A's re-add of the
+// same uid arrives; compacting the old slot must keep the new mapping
+TEST(reAddSurvivesPendingRemoval) {
+    Whiteboard a, b;
+    initBoard(a, 1);
+    initBoard(b, 2);
+    drawStroke(a, {10, 10, 40, 30, 80, 20});
+    sync(a, b);
+    uint64_t uid = uidOf(1, 1);
+    CHECK(b.hasElement(uid));
+
+    CHECK(b.removeElement(uid));
+    CHECK(a.removeElement(uid));
+    CHECK(a.undo());
+    sync(a, b);
+    b.serialize(); // Compacts B's removed slot
+
+    CHECK(a.hasElement(uid));
+    CHECK(b.hasElement(uid));
+    CHECK(b.moveElement(uid, 5, 5));
+    sync(a, b);
+    CHECK(boardUids(a) == std::vector<uint64_t>{uid});
+    CHECK(boardUids(b) == std::vector<uint64_t>{uid});
+    CHECK(a.serialize() == b.serialize());
+}
+
+// B deletes a line whose re-add from A arrives before B undoes the
+// delete; the undo must update that line instead of adding a second one
+TEST(undoDeleteOfReAddedElement) {
+    Whiteboard a, b;
+    initBoard(a, 1);
+    initBoard(b, 2);
+    drawStroke(a, {10, 10, 40, 30, 80, 20});
+    sync(a, b);
+    uint64_t uid = uidOf(1, 1);
+
+    b.startSelection(0, 0);
+    b.updateSelection(100, 100);
+    b.endSelection();
+    b.deleteSelected();
+    CHECK(!b.hasElement(uid));
+
+    CHECK(a.removeElement(uid));
+    CHECK(a.undo());
+    sync(a, b);
+    CHECK(b.hasElement(uid));
+
+    CHECK(b.undo());
+    sync(a, b);
+    CHECK(boardUids(a) == std::vector<uint64_t>{uid});
+    CHECK(boardUids(b) == std::vector<uint64_t>{uid});
+    CHECK(a.serialize() == b.serialize());
+
+    // Redoing the delete removes the element wherever the undo put it
+    CHECK(b.redo());
+    sync(a, b);
+    CHECK(!a.hasElement(uid));
+    CHECK(!b.hasElement(uid));
+    CHECK(boardUids(b).empty());
+}
@@ -0,0 +1,55 @@
+#include "test.hpp"
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+struct Test {
+    std::string name;
+    TestFunction function;
+};
+
+static std::vector<Test>& registry() {
+    static std::vector<Test> tests;
+    return tests;
+}
+
+static uint32_t failures = 0;
+
+bool registerTest(const char* name, TestFunction function) {
+    registry().push_back({name, function});
+    return true;
+}
+
+void failCheck(const char* file, int line, const char* expression) {
+    std::printf("  %s:%d: CHECK(%s) failed\n", file, line, expression);
+    failures++;
+}
+
+int runTests(int argc, char** argv) {
+    const char* filter = "";
+    for (int i = 1; i < argc; i++) {
+        if (std::strncmp(argv[i], "--filter=", 9) == 0) {
+            filter = argv[i] + 9;
+        } else {
+            std::fprintf(stderr, "usage: %s [--filter=<substring>]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    uint32_t run = 0, failed = 0;
+    for (const Test& test : registry()) {
+        if (test.name.find(filter) == std::string::npos) continue;
+        uint32_t before = failures;
+        test.function();
+        run++;
+        if (failures != before) failed++;
+        std::printf("%-6s %s\n", failures == before ? "ok" : "FAILED", test.name.c_str());
+        std::fflush(stdout);
+    }
+    std::printf("%u tests, %u failed\n", run, failed);
+    return failed == 0 ? 0 : 1;
+}
+
+int main(int argc, char** argv) {
+    return runTests(argc, argv);
+}
@@ -0,0 +1,77 @@
+/**
+ * @file test.hpp
+ * @brief Minimal test harness for the native engine build
+ *
+ * Shaped like bench.hpp: tests are functions registered with TEST() and
+ * run in registration order. CHECK() records a failure and carries on so
+ * one run reports every broken expectation. The process exits non-zero if
+ * any check failed, which is what ctest looks at.
+ *
+ * Command line: --filter=<substring> runs only matching tests.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "../include/wasm/whiteboard.hpp"
+
+using TestFunction = void (*)();
+
+/// Add a test to run
+bool registerTest(const char* name, TestFunction function);
+
+/// Count a failed check and print where it is
+void failCheck(const char* file, int line, const char* expression);
+
+/// Run the registered tests; returns the process exit code
+int runTests(int argc, char** argv);
+
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) failCheck(__FILE__, __LINE__, #condition); \
+    } while (false)
+
+#define TEST_CONCAT_(a, b) a##b
+#define TEST_CONCAT(a, b) TEST_CONCAT_(a, b)
+#define TEST(function) \
+    static void function(); \
+    static const bool TEST_CONCAT(function, _registered) = registerTest(#function, function); \
+    static void function()
+
+/// Board with a site id, ready for local edits
+inline void initBoard(Whiteboard& board, uint32_t site) {
+    board.init();
+    board.setSiteId(site);
+}
+
+/// Draw a stroke through the points, one pen gesture
+inline void drawStroke(Whiteboard& board, std::initializer_list<float> xy) {
+    const float* point = xy.begin();
+    board.startDrawing(point[0], point[1]);
+    for (point += 2; point < xy.end(); point += 2) board.continueDrawing(point[0], point[1]);
+    board.endDrawing();
+}
+
+/// Send each board's pending ops to the other, as the socket relay would
+inline void sync(Whiteboard& a, Whiteboard& b) {
+    std::vector<uint8_t> fromA = a.collectLocalOps();
+    std::vector<uint8_t> fromB = b.collectLocalOps();
+    if (!fromA.empty()) CHECK(b.applyRemoteOps(fromA.data(), fromA.size()));
+    if (!fromB.empty()) CHECK(a.applyRemoteOps(fromB.data(), fromB.size()));
+}
+
+/// Uid of the n-th element created on a site (counting from 1)
+inline uint64_t uidOf(uint32_t site, uint32_t n) {
+    return (static_cast<uint64_t>(site) << 32) | n;
+}
+
+/// Uids of every element on the board, in draw order
+inline std::vector<uint64_t> boardUids(Whiteboard& board) {
+    board.startSelection(-1e6f, -1e6f);
+    board.updateSelection(1e6f, 1e6f);
+    board.endSelection();
+    std::vector<uint64_t> uids = board.getSelectedIds();
+    board.clearSelection();
+    return uids;
+}
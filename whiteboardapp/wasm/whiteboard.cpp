@@ -1,402 +1,190 @@
-#include <vector>
+/**
+ * @file whiteboard.cpp
+ * @brief JavaScript bindings of the Whiteboard engine
+ *
+ * The engine (include/wasm/whiteboard.hpp) works on plain pointers and
+ * vectors; this file adapts it to embind. Buffers the engine returns are
+ * handed out as typed array views over WebAssembly memory, which the next
+ * allocation that grows the heap invalidates, so JavaScript must consume
+ * (or copy) them right away. Typed arrays passed in are copied into a
+ * staging vector first.
+ */
+
 #include <emscripten/bind.h>
 #include <emscripten/val.h>
-#include <string>
-#include <sstream>
-#include <cmath>
-
-// Define ShapeType enum first
-enum class ShapeType {
-    FREEHAND,
-    RECTANGLE,
-    CIRCLE,
-    LINE,
-    TRIANGLE
-};
+#include <utility>
+#include "../include/wasm/whiteboard.hpp"
 
-struct Point {
-    float x;
-    float y;
+#ifndef WHITEBOARD_HEADLESS
+/// Canvas for Whiteboard::draw() over a CanvasRenderingContext2D
+struct CanvasContext {
+    emscripten::val context;
+
+    void setTransform(float a, float b, float c, float d, float e, float f) {
+        context.call<void>("setTransform", a, b, c, d, e, f);
+    }
+    void beginPath() { context.call<void>("beginPath"); }
+    void strokeStyle(const std::string& color) { context.set("strokeStyle", color); }
+    void lineWidth(float width) { context.set("lineWidth", width); }
+    void roundCaps() {
+        context.set("lineCap", std::string("round"));
+        context.set("lineJoin", std::string("round"));
+    }
+    void moveTo(float x, float y) { context.call<void>("moveTo", x, y); }
+    void lineTo(float x, float y) { context.call<void>("lineTo", x, y); }
+    void bezierCurveTo(float x1, float y1, float x2, float y2, float x, float y) {
+        context.call<void>("bezierCurveTo", x1, y1, x2, y2, x, y);
+    }
+    void stroke() { context.call<void>("stroke"); }
+    void rect(float x, float y, float width, float height) { context.call<void>("rect", x, y, width, height); }
+    void arc(float x, float y, float radius, float start, float end) {
+        context.call<void>("arc", x, y, radius, start, end);
+    }
+    void strokeRect(float x, float y, float width, float height) {
+        context.call<void>("strokeRect", x, y, width, height);
+    }
+    void lineDash(float on, float off) {
+        std::vector<float> pattern;
+        if (on > 0 || off > 0) pattern = {on, off};
+        context.call<void>("setLineDash", emscripten::val::array(pattern));
+    }
 };
+#endif
 
-struct Shape {
-    Point start;
-    Point end;
-    ShapeType type;
-    std::string color;
-    float thickness;
-    bool selected;
+template <typename T>
+static emscripten::val view(const T* data, size_t size) {
+    return emscripten::val(emscripten::typed_memory_view(size, data));
+}
 
-    Shape() : selected(false) {}
-};
+template <typename T>
+static emscripten::val view(const std::vector<T>& values) {
+    return view(values.data(), values.size());
+}
 
-struct Line {
-    std::vector<Point> points;
-    std::string color;
-    float thickness;
-    bool selected;
+static std::vector<uint8_t> byteInput;   ///< Staging for typed arrays passed to the engine
+static std::vector<float> sampleInput;
 
-    Line() : selected(false) {}
-};
+template <typename T>
+static const std::vector<T>& copyInput(emscripten::val array, std::vector<T>& staging) {
+    staging.resize(array["length"].as<size_t>());
+    view(staging).template call<void>("set", array);
+    return staging;
+}
 
-class Whiteboard {
-private:
-    std::vector<Line> lines;
-    std::vector<Shape> shapes;
-    std::string currentColor;
-    float currentThickness;
-    Point selectionStart;
-    Point selectionEnd;
-    bool isSelecting;
-    bool isDrawingShape;
-    ShapeType currentShape;
-    Shape* currentShapePtr;
-
-public:
-    Whiteboard() : currentColor("#000000"), currentThickness(2.0f), 
-                  isSelecting(false), isDrawingShape(false),
-                  currentShape(ShapeType::FREEHAND), currentShapePtr(nullptr) {
-        init();
-    }
+static void continueDrawingSamples(Whiteboard& board, emscripten::val samples) {
+    const std::vector<float>& input = copyInput(samples, sampleInput);
+    board.continueDrawingSamples(input.data(), input.size() / 3);
+}
 
-    void init() {
-        lines.clear();
-        shapes.clear();
-        isSelecting = false;
-        isDrawingShape = false;
-        currentShapePtr = nullptr;
-    }
+#ifndef WHITEBOARD_HEADLESS
+static void draw(Whiteboard& board, emscripten::val context) {
+    CanvasContext canvas{context};
+    board.draw(canvas);
+}
 
-    void startDrawing(float x, float y) {
-        if (currentShape == ShapeType::FREEHAND) {
-            Line newLine;
-            newLine.color = currentColor;
-            newLine.thickness = currentThickness;
-            newLine.points.push_back({x, y});
-            lines.push_back(newLine);
-        } else {
-            Shape newShape;
-            newShape.type = currentShape;
-            newShape.color = currentColor;
-            newShape.thickness = currentThickness;
-            newShape.selected = false;
-
-            // Set initial size and position based on shape type
-            float width = 0;
-            float height = 0;
-
-            switch (currentShape) {
-                case ShapeType::RECTANGLE:
-                    width = 100;  // Default width
-                    height = 100; // Default height
-                    break;
-                case ShapeType::CIRCLE:
-                    width = 80;   // Default diameter
-                    height = 80;  // Default diameter
-                    break;
-                default:
-                    width = 100;
-                    height = 100;
-                    break;
-            }
-
-            // Center the shape at the click point
-            newShape.start = {x - width/2, y - height/2};
-            newShape.end = {x + width/2, y + height/2};
-            shapes.push_back(newShape);
-            currentShapePtr = &shapes.back();
-        }
-    }
+static emscripten::val drawCommands(Whiteboard& board) {
+    const CommandBuffer& commands = board.drawCommands();
+    return view(commands.data(), commands.size());
+}
 
-    void continueDrawing(float x, float y) {
-        if (currentShape == ShapeType::FREEHAND && !lines.empty()) {
-            lines.back().points.push_back({x, y});
-        }
-        // Ignore continue events for shapes during creation
-    }
+static emscripten::val drawDirtyCommands(Whiteboard& board) {
+    const CommandBuffer& commands = board.drawDirtyCommands();
+    return view(commands.data(), commands.size());
+}
 
-    void endDrawing() {
-        isDrawingShape = false;
-        currentShapePtr = nullptr;
-    }
+static emscripten::val getCommandPalette(Whiteboard& board) {
+    return emscripten::val::array(board.getCommandPalette());
+}
+#endif
 
-    void startSelection(float x, float y) {
-        isSelecting = true;
-        selectionStart = {x, y};
-        selectionEnd = {x, y};
-    }
+static emscripten::val nextSVGChunk(Whiteboard& board, uint32_t maxBytes) {
+    return view(board.nextSVGChunk(maxBytes));
+}
 
-    void updateSelection(float x, float y) {
-        if (isSelecting) {
-            selectionEnd = {x, y};
-            float left = std::min(selectionStart.x, selectionEnd.x);
-            float right = std::max(selectionStart.x, selectionEnd.x);
-            float top = std::min(selectionStart.y, selectionEnd.y);
-            float bottom = std::max(selectionStart.y, selectionEnd.y);
-
-            // Check lines
-            for (auto& line : lines) {
-                line.selected = false;
-                for (const auto& point : line.points) {
-                    if (point.x >= left && point.x <= right &&
-                        point.y >= top && point.y <= bottom) {
-                        line.selected = true;
-                        break;
-                    }
-                }
-            }
-
-            // Check shapes
-            for (auto& shape : shapes) {
-                shape.selected = false;
-                float shapeLeft = std::min(shape.start.x, shape.end.x);
-                float shapeRight = std::max(shape.start.x, shape.end.x);
-                float shapeTop = std::min(shape.start.y, shape.end.y);
-                float shapeBottom = std::max(shape.start.y, shape.end.y);
-
-                if (shapeLeft >= left && shapeRight <= right &&
-                    shapeTop >= top && shapeBottom <= bottom) {
-                    shape.selected = true;
-                }
-            }
-        }
-    }
+static emscripten::val renderImage(Whiteboard& board, float x, float y, float scale, uint32_t width,
+                                   uint32_t height, const std::string& background, uint32_t format) {
+    return view(board.renderImage(x, y, scale, width, height, background, format));
+}
 
-    void endSelection() {
-        isSelecting = false;
-    }
+static emscripten::val serialize(Whiteboard& board) {
+    return view(board.serialize());
+}
 
-    void clearSelection() {
-        for (auto& line : lines) {
-            line.selected = false;
-        }
-        for (auto& shape : shapes) {
-            shape.selected = false;
-        }
-        isSelecting = false;
-    }
+static bool deserialize(Whiteboard& board, emscripten::val bytes) {
+    const std::vector<uint8_t>& input = copyInput(bytes, byteInput);
+    return board.deserialize(input.data(), input.size());
+}
 
-    void moveSelected(float dx, float dy) {
-        // Move lines
-        for (auto& line : lines) {
-            if (line.selected) {
-                for (auto& point : line.points) {
-                    point.x += dx;
-                    point.y += dy;
-                }
-            }
-        }
-
-        // Move shapes
-        for (auto& shape : shapes) {
-            if (shape.selected) {
-                shape.start.x += dx;
-                shape.start.y += dy;
-                shape.end.x += dx;
-                shape.end.y += dy;
-            }
-        }
-    }
+static emscripten::val takeStrokeBatch(Whiteboard& board) {
+    return view(board.takeStrokeBatch());
+}
 
-    void deleteSelected() {
-        // Delete selected lines
-        auto lineIt = lines.begin();
-        while (lineIt != lines.end()) {
-            if (lineIt->selected) {
-                lineIt = lines.erase(lineIt);
-            } else {
-                ++lineIt;
-            }
-        }
-
-        // Delete selected shapes
-        auto shapeIt = shapes.begin();
-        while (shapeIt != shapes.end()) {
-            if (shapeIt->selected) {
-                shapeIt = shapes.erase(shapeIt);
-            } else {
-                ++shapeIt;
-            }
-        }
-    }
+static bool applyStrokeBatch(Whiteboard& board, const std::string& sender, emscripten::val bytes) {
+    const std::vector<uint8_t>& input = copyInput(bytes, byteInput);
+    return board.applyStrokeBatch(sender, input.data(), input.size());
+}
 
-    void setColor(const std::string& color) {
-        currentColor = color;
-        // If we're currently drawing a shape, update its color
-        if (isDrawingShape && currentShapePtr) {
-            currentShapePtr->color = color;
-        }
-    }
+static emscripten::val collectLocalOps(Whiteboard& board) {
+    return view(board.collectLocalOps());
+}
 
-    void setThickness(float thickness) {
-        currentThickness = thickness;
-    }
+static bool applyRemoteOps(Whiteboard& board, emscripten::val bytes) {
+    const std::vector<uint8_t>& input = copyInput(bytes, byteInput);
+    return board.applyRemoteOps(input.data(), input.size());
+}
 
-    void setShapeType(ShapeType shape) {
-        currentShape = shape;
-    }
+static emscripten::val snapshotOps(Whiteboard& board) {
+    return view(board.snapshotOps());
+}
 
-    void draw(emscripten::val context) {
-        // Draw freehand lines
-        for (const auto& line : lines) {
-            if (line.points.empty()) continue;
-
-            context.call<void>("beginPath");
-            context.set("strokeStyle", line.color);
-            context.set("lineWidth", line.thickness);
-            context.set("lineCap", std::string("round"));
-            context.set("lineJoin", std::string("round"));
-
-            context.call<void>("moveTo", line.points[0].x, line.points[0].y);
-            for (size_t i = 1; i < line.points.size(); i++) {
-                context.call<void>("lineTo", line.points[i].x, line.points[i].y);
-            }
-            context.call<void>("stroke");
-
-            if (line.selected) {
-                context.set("strokeStyle", "#0095ff");
-                context.set("lineWidth", line.thickness + 2);
-                context.call<void>("stroke");
-            }
-        }
-
-        // Draw shapes
-        for (const auto& shape : shapes) {
-            context.call<void>("beginPath");
-            context.set("strokeStyle", shape.color);
-            context.set("lineWidth", shape.thickness);
-
-            float width = shape.end.x - shape.start.x;
-            float height = shape.end.y - shape.start.y;
-
-            if (shape.type == ShapeType::RECTANGLE) {
-                context.call<void>("rect", 
-                    shape.start.x, shape.start.y,
-                    width, height);
-                context.call<void>("stroke");
-            } else if (shape.type == ShapeType::CIRCLE) {
-                float centerX = shape.start.x + width / 2;
-                float centerY = shape.start.y + height / 2;
-                float radius = std::min(std::abs(width), std::abs(height)) / 2;
-                
-                context.call<void>("beginPath");
-                context.call<void>("arc", centerX, centerY, radius, 0, 2 * M_PI);
-                context.call<void>("stroke");
-            }
-
-            if (shape.selected) {
-                context.set("strokeStyle", "#0095ff");
-                context.set("lineWidth", shape.thickness + 2);
-                context.call<void>("stroke");
-            }
-        }
-
-        // Draw selection rectangle
-        if (isSelecting) {
-            context.call<void>("beginPath");
-            context.set("strokeStyle", "#0095ff");
-            context.set("lineWidth", 1);
-            context.call<void>("setLineDash", emscripten::val::array(std::vector<int>{5, 5}));
-            context.call<void>("strokeRect",
-                std::min(selectionStart.x, selectionEnd.x),
-                std::min(selectionStart.y, selectionEnd.y),
-                std::abs(selectionEnd.x - selectionStart.x),
-                std::abs(selectionEnd.y - selectionStart.y));
-            context.call<void>("setLineDash", emscripten::val::array(std::vector<int>{}));
-        }
-    }
+static bool loadOps(Whiteboard& board, emscripten::val bytes) {
+    const std::vector<uint8_t>& input = copyInput(bytes, byteInput);
+    return board.loadOps(input.data(), input.size());
+}
+
+static emscripten::val getSelectedIds(Whiteboard& board) {
+    return view(board.getSelectedIds());
+}
 
-    void clear() {
-        lines.clear();
-        shapes.clear();
+static bool appendPoints(Whiteboard& board, uint64_t uid, uintptr_t points, uint32_t count) {
+    // A heap offset from _malloc(); JavaScript wrote the points through HEAPF32
+    return board.appendPoints(uid, reinterpret_cast<const float*>(points), count);
+}
+
+static emscripten::val getTimings(Whiteboard& board) {
+    return view(board.getTimings(), PerfRecorder::CAPACITY * PerfRecorder::SAMPLE_VALUES);
+}
+
+/// Bound method that counts the call for Whiteboard::getStats() before forwarding it
+template <auto Function>
+struct Counted;
+
+template <typename R, typename... Args, R (Whiteboard::*Method)(Args...)>
+struct Counted<Method> {
+    static R call(Whiteboard& board, Args... args) {
+        board.countBoundaryCall();
+        return (board.*Method)(std::forward<Args>(args)...);
     }
+};
 
-    void erase(float x, float y, float radius) {
-        // Erase lines
-        for (auto it = lines.begin(); it != lines.end();) {
-            bool pointsRemoved = false;
-            auto& points = it->points;
-            
-            for (auto pointIt = points.begin(); pointIt != points.end();) {
-                float dx = x - pointIt->x;
-                float dy = y - pointIt->y;
-                float distance = std::sqrt(dx * dx + dy * dy);
-                
-                if (distance < radius) {
-                    pointIt = points.erase(pointIt);
-                    pointsRemoved = true;
-                } else {
-                    ++pointIt;
-                }
-            }
-            
-            if (points.empty() && pointsRemoved) {
-                it = lines.erase(it);
-            } else {
-                ++it;
-            }
-        }
-
-        // Erase shapes
-        for (auto it = shapes.begin(); it != shapes.end();) {
-            float centerX = (it->start.x + it->end.x) / 2;
-            float centerY = (it->start.y + it->end.y) / 2;
-            float dx = x - centerX;
-            float dy = y - centerY;
-            float distance = std::sqrt(dx * dx + dy * dy);
-
-            if (distance < radius) {
-                it = shapes.erase(it);
-            } else {
-                ++it;
-            }
-        }
+template <typename R, typename... Args, R (Whiteboard::*Method)(Args...) const>
+struct Counted<Method> {
+    static R call(Whiteboard& board, Args... args) {
+        board.countBoundaryCall();
+        return (board.*Method)(std::forward<Args>(args)...);
     }
+};
 
-    /**
-     * @brief Convert the current drawing to SVG paths
-     * @return String containing SVG path elements
-     */
-    std::string getSVGPaths() {
-        std::stringstream svg;
-        
-        // Convert lines to SVG paths
-        for (const auto& line : lines) {
-            if (line.points.empty()) continue;
-            
-            svg << "<path d=\"M " << line.points[0].x << " " << line.points[0].y;
-            for (size_t i = 1; i < line.points.size(); i++) {
-                svg << " L " << line.points[i].x << " " << line.points[i].y;
-            }
-            svg << "\" stroke=\"" << line.color << "\" stroke-width=\"" << line.thickness 
-                << "\" fill=\"none\" stroke-linecap=\"round\" stroke-linejoin=\"round\"/>";
-        }
-        
-        // Convert shapes to SVG elements
-        for (const auto& shape : shapes) {
-            float width = shape.end.x - shape.start.x;
-            float height = shape.end.y - shape.start.y;
-            
-            if (shape.type == ShapeType::RECTANGLE) {
-                svg << "<rect x=\"" << shape.start.x << "\" y=\"" << shape.start.y 
-                    << "\" width=\"" << width << "\" height=\"" << height 
-                    << "\" stroke=\"" << shape.color << "\" stroke-width=\"" << shape.thickness 
-                    << "\" fill=\"none\"/>";
-            } else if (shape.type == ShapeType::CIRCLE) {
-                float centerX = shape.start.x + width / 2;
-                float centerY = shape.start.y + height / 2;
-                float radius = std::min(std::abs(width), std::abs(height)) / 2;
-                
-                svg << "<circle cx=\"" << centerX << "\" cy=\"" << centerY 
-                    << "\" r=\"" << radius << "\" stroke=\"" << shape.color 
-                    << "\" stroke-width=\"" << shape.thickness << "\" fill=\"none\"/>";
-            }
-        }
-        
-        return svg.str();
+template <typename R, typename... Args, R (*Function)(Whiteboard&, Args...)>
+struct Counted<Function> {
+    static R call(Whiteboard& board, Args... args) {
+        board.countBoundaryCall();
+        return Function(board, std::forward<Args>(args)...);
     }
 };
 
+#define COUNTED(function) &Counted<function>::call
+
 // Binding code for Emscripten
 EMSCRIPTEN_BINDINGS(whiteboard_module) {
     emscripten::enum_<ShapeType>("ShapeType")
@@ -406,23 +194,92 @@ EMSCRIPTEN_BINDINGS(whiteboard_module) {
         .value("LINE", ShapeType::LINE)
         .value("TRIANGLE", ShapeType::TRIANGLE);
 
+    emscripten::value_object<WhiteboardStats>("WhiteboardStats")
+        .field("lines", &WhiteboardStats::lines)
+        .field("shapes", &WhiteboardStats::shapes)
+        .field("points", &WhiteboardStats::points)
+        .field("bytesInUse", &WhiteboardStats::bytesInUse)
+        .field("frames", &WhiteboardStats::frames)
+        .field("boundaryCalls", &WhiteboardStats::boundaryCalls)
+        .field("commandFloats", &WhiteboardStats::commandFloats)
+        .field("timingsWritten", &WhiteboardStats::timingsWritten)
+        .field("drawMs", &WhiteboardStats::drawMs)
+        .field("hitTestMs", &WhiteboardStats::hitTestMs)
+        .field("eraseMs", &WhiteboardStats::eraseMs)
+        .field("serializeMs", &WhiteboardStats::serializeMs)
+        .field("deserializeMs", &WhiteboardStats::deserializeMs)
+        .field("exportMs", &WhiteboardStats::exportMs)
+        .field("syncMs", &WhiteboardStats::syncMs);
+
     emscripten::class_<Whiteboard>("Whiteboard")
         .constructor()
-        .function("init", &Whiteboard::init)
-        .function("startDrawing", &Whiteboard::startDrawing)
-        .function("continueDrawing", &Whiteboard::continueDrawing)
-        .function("endDrawing", &Whiteboard::endDrawing)
-        .function("startSelection", &Whiteboard::startSelection)
-        .function("updateSelection", &Whiteboard::updateSelection)
-        .function("endSelection", &Whiteboard::endSelection)
-        .function("clearSelection", &Whiteboard::clearSelection)
-        .function("moveSelected", &Whiteboard::moveSelected)
-        .function("deleteSelected", &Whiteboard::deleteSelected)
-        .function("setColor", &Whiteboard::setColor)
-        .function("setThickness", &Whiteboard::setThickness)
-        .function("setShapeType", &Whiteboard::setShapeType)
-        .function("draw", &Whiteboard::draw)
-        .function("clear", &Whiteboard::clear)
-        .function("erase", &Whiteboard::erase)
-        .function("getSVGPaths", &Whiteboard::getSVGPaths);
+        .function("init", COUNTED(&Whiteboard::init))
+        .function("startDrawing", COUNTED(&Whiteboard::startDrawing))
+        .function("continueDrawing", COUNTED(&Whiteboard::continueDrawing))
+        .function("endDrawing", COUNTED(&Whiteboard::endDrawing))
+        .function("continueDrawingSamples", COUNTED(&continueDrawingSamples))
+        .function("setInkSmoothing", COUNTED(&Whiteboard::setInkSmoothing))
+        .function("setInkPrediction", COUNTED(&Whiteboard::setInkPrediction))
+        .function("startSelection", COUNTED(&Whiteboard::startSelection))
+        .function("updateSelection", COUNTED(&Whiteboard::updateSelection))
+        .function("endSelection", COUNTED(&Whiteboard::endSelection))
+        .function("clearSelection", COUNTED(&Whiteboard::clearSelection))
+        .function("moveSelected", COUNTED(&Whiteboard::moveSelected))
+        .function("deleteSelected", COUNTED(&Whiteboard::deleteSelected))
+        .function("setColor", COUNTED(&Whiteboard::setColor))
+        .function("setThickness", COUNTED(&Whiteboard::setThickness))
+        .function("setShapeType", COUNTED(&Whiteboard::setShapeType))
+        .function("setSimplifyTolerance", COUNTED(&Whiteboard::setSimplifyTolerance))
+        .function("setCurveFitting", COUNTED(&Whiteboard::setCurveFitting))
+        .function("setMinPointDistance", COUNTED(&Whiteboard::setMinPointDistance))
+#ifndef WHITEBOARD_HEADLESS
+        .function("draw", COUNTED(&draw))
+        .function("drawCommands", COUNTED(&drawCommands))
+        .function("getCommandPalette", COUNTED(&getCommandPalette))
+        .function("drawDirtyCommands", COUNTED(&drawDirtyCommands))
+#endif
+        .function("invalidate", COUNTED(&Whiteboard::invalidate))
+        .function("invalidateAll", COUNTED(&Whiteboard::invalidateAll))
+        .function("setTileCaching", COUNTED(&Whiteboard::setTileCaching))
+        .function("setViewSize", COUNTED(&Whiteboard::setViewSize))
+        .function("setViewport", COUNTED(&Whiteboard::setViewport))
+        .function("clear", COUNTED(&Whiteboard::clear))
+        .function("erase", COUNTED(&Whiteboard::erase))
+        .function("getSVGPaths", COUNTED(&Whiteboard::getSVGPaths))
+        .function("beginSVGExport", COUNTED(&Whiteboard::beginSVGExport))
+        .function("nextSVGChunk", COUNTED(&nextSVGChunk))
+        .function("renderImage", COUNTED(&renderImage))
+        .function("setWorkerThreads", COUNTED(&Whiteboard::setWorkerThreads))
+        .function("getWorkerThreads", COUNTED(&Whiteboard::getWorkerThreads))
+        .function("serialize", COUNTED(&serialize))
+        .function("deserialize", COUNTED(&deserialize))
+        .function("setStrokeStreaming", COUNTED(&Whiteboard::setStrokeStreaming))
+        .function("takeStrokeBatch", COUNTED(&takeStrokeBatch))
+        .function("applyStrokeBatch", COUNTED(&applyStrokeBatch))
+        .function("dropRemoteSender", COUNTED(&Whiteboard::dropRemoteSender))
+        .function("beginRemoteStroke", COUNTED(&Whiteboard::beginRemoteStroke))
+        .function("appendPoints", COUNTED(&appendPoints))
+        .function("finishRemoteStroke", COUNTED(&Whiteboard::finishRemoteStroke))
+        .function("collectLocalOps", COUNTED(&collectLocalOps))
+        .function("applyRemoteOps", COUNTED(&applyRemoteOps))
+        .function("snapshotOps", COUNTED(&snapshotOps))
+        .function("loadOps", COUNTED(&loadOps))
+        .function("setElementStyle", COUNTED(&Whiteboard::setElementStyle))
+        .function("setSiteId", COUNTED(&Whiteboard::setSiteId))
+        .function("getSiteId", COUNTED(&Whiteboard::getSiteId))
+        .function("hasElement", COUNTED(&Whiteboard::hasElement))
+        .function("moveElement", COUNTED(&Whiteboard::moveElement))
+        .function("removeElement", COUNTED(&Whiteboard::removeElement))
+        .function("getSelectedIds", COUNTED(&getSelectedIds))
+        .function("undo", COUNTED(&Whiteboard::undo))
+        .function("redo", COUNTED(&Whiteboard::redo))
+        .function("canUndo", COUNTED(&Whiteboard::canUndo))
+        .function("canRedo", COUNTED(&Whiteboard::canRedo))
+        .function("endHistoryStep", COUNTED(&Whiteboard::endHistoryStep))
+        .function("setHistoryLimit", COUNTED(&Whiteboard::setHistoryLimit))
+        .function("getHistorySize", COUNTED(&Whiteboard::getHistorySize))
+        // Polling the stats is left out of the call counts it reports
+        .function("getStats", &Whiteboard::getStats)
+        .function("setProfiling", &Whiteboard::setProfiling)
+        .function("getTimings", &getTimings);
 }